@@ -5,10 +5,14 @@
 //////////////////////////////////////////////////////////////////////////////////
 
 #include<stdio.h>    // For printf, fgets, etc.
-#include<stdlib.h>   // For malloc, free, atoi
-#include<unistd.h>   // For system level functions (future use)
-#include<stdbool.h>  // For bool, true, false
-#include<string.h>   // For strcpy, strcmp, strncpy, memset
+#include<stdlib.h>   // For atoi, system
+#include<unistd.h>   // For getopt and sysconf
+#include<getopt.h>   // For getopt_long of --batch
+#include<string.h>   // For strcpy, strcmp, strlen
+#include<time.h>     // For clock_gettime used by benchmarks
+#include<errno.h>    // For errno of image errors
+
+#include "libcvfs_internal.h"   // Library and its internals used by admin commands
 
 //////////////////////////////////////////////////////////////////////////////////
 //
@@ -16,762 +20,2780 @@
 //
 //////////////////////////////////////////////////////////////////////////////////
 
-//  Maximum file size that we allow in the project
-#define MAXFILESIZE 50     // Maximum bytes allowed in one file
-#define MAXOPENFILES 20    // Maximum files that can be opened at a time
-#define MAXINODE 5         // Maximum number of files (inodes)
-
-#define READ 1             // Permission bit for read
-#define WRITE 2            // Permission bit for write
-#define EXECUTE 4          // Permission bit for execute (not used yet)
-
-#define START 0            // For lseek like operations (future use)
-#define CURRENT 1
-#define END 2
-
-#define EXECUTE_SUCCESS 0  // Generic success return value
+#define MAXINPUTSIZE 1024  // Maximum bytes of a command line and of data of write
+#define MAXARGS 8          // Most words in one command
+#define MAXCOMMANDSLOTS 128    // Slots of perfect hash of command names
+#define MAXCOMMANDSEED 100000  // Seeds tried by compiler for the perfect hash
+#define LSBATCH 64         // Files taken from ListFiles() at a time by ls
+#define BATCHBUFSIZE 65536 // Bytes of stdout buffer in batch mode
 
-#define REGULARFILE 1      // File is valid and created
-#define SPECIALFILE 2      // Reserved for future use
+#define VERBOSE_QUIET 0    // Batch mode prints only failed commands and summary
+#define VERBOSE_NORMAL 1   // Batch mode prints output of commands
+#define VERBOSE_ECHO 2     // Batch mode also prints every command before it runs
 
 //////////////////////////////////////////////////////////////////////////////////
 //
-//  User Defined Macros For Error Handling
+//  User Defined Macros For Benchmarks
 //
 //////////////////////////////////////////////////////////////////////////////////
 
-#define ERR_INVALID_PARAMETER -1
-
-#define ERR_NO_INODES -2
-
-#define ERR_FILE_ALREADY_EXIST -3
-#define ERR_FILE_NOT_EXIST -4
-
-#define ERR_PERMISSION_DENIED -5
-
-#define ERR_INSUFFICIENT_SPACE -6
-#define ERR_INSUFFICIENT_DATA -7
-
-#define ERR_MAX_FILES_OPEN -8
-
-//////////////////////////////////////////////////////////////////////////////////
-//
-//  User Defined Structures
-//
-//////////////////////////////////////////////////////////////////////////////////
+#define BENCHFDOPS 1000000      // Close and open pairs done by bench fd
+#define BENCHIOOPS 1048576      // Reads and writes done by each method of bench io
+#define BENCHIOSIZE 16          // Bytes of one operation of bench io
+#define BENCHIOBATCH 256        // Operations in one vector or submission
+#define BENCHIOSPAN (BENCHIOSIZE * BENCHIOBATCH)    // Bytes of file used by bench io
+#define MAXBENCHTHREADS 16      // Files (and threads) used by bench threads
+#define BENCHTHREADOPS 200000   // Operations done by every thread
+#define BENCHASYNCTASKS 4096    // Coroutines kept in flight by bench async
+#define BENCHASYNCOPS 32        // Write and read pairs done by every coroutine
+#define BENCHASYNCFILES 8       // Files shared by the coroutines of bench async
+#define BENCHASYNCWORKERS 4     // Most threads of executor used by bench async, one per core
+#define BENCHPARSEOPS 1000000   // Command lines parsed by each method of bench parse
+#define BENCH_READ_PRIVATE 1    // Every thread reads its own file
+#define BENCH_READ_SHARED 2     // All threads read the same file
+#define BENCH_WRITE_PRIVATE 3   // Every thread writes its own file
 
 //////////////////////////////////////////////////////////////////////////////////
 //
-//  Structure Name :            BootBlock
-//  Description  :              Holds the information to boot the OS
+//  Function Name :         PrintImageError
+//  Description :           Displays the message of error returned by
+//                          MountImage().
+//  Input :                 iRet -> Error code
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
 //
 //////////////////////////////////////////////////////////////////////////////////
 
-struct BootBlock
+void PrintImageError(
+                        int iRet
+                    )
 {
-    char Information[100];   // Stores boot message of CVFS
-};
+    if(iRet == ERR_INVALID_PARAMETER)
+    {
+        printf("Error : Invalid image path\n");
+    }
+    else if(iRet == ERR_IMAGE_INVALID)
+    {
+        printf("Error : File is not a valid CVFS image (magic, version or layout mismatch)\n");
+    }
+    else if(iRet == ERR_NO_MEMORY)
+    {
+        printf("Error : Unable to mount the image as there is no memory\n");
+    }
+    else
+    {
+        printf("Error : Unable to access the image : %s\n",strerror(errno));
+    }
+}
 
 //////////////////////////////////////////////////////////////////////////////////
 //
-//  Structure Name :            SuperBlock
-//  Description  :              Holds the information about the File System
+//  Function Name :         PrintPathError
+//  Description :           Displays the message of error of a path which is
+//                          common to directory commands.
+//  Input :                 iRet -> Error code
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
 //
 //////////////////////////////////////////////////////////////////////////////////
 
-struct SuperBlock
+void PrintPathError(
+                        int iRet
+                    )
 {
-    int TotalInodes;  // Total files possible
-    int FreeInodes;   // How many are still unused
-};
+    if(iRet == ERR_NOT_DIRECTORY)
+    {
+        printf("Error : Path uses a file as directory\n");
+    }
+    else if(iRet == ERR_INVALID_PARAMETER)
+    {
+        printf("Error : Invalid path, every name must have 1 to %d characters\n",MAXFILENAME - 1);
+    }
+    else
+    {
+        printf("Error : Unable to use the path (error %d)\n",iRet);
+    }
+}
 
 //////////////////////////////////////////////////////////////////////////////////
 //
-//  Structure Name :            Inode
-//  Description  :              Holds the information about File
+//  Function Name :         DisplaySessions
+//  Description :           Lists every session with number of its open
+//                          descriptors and size of its UFDT, like 'ps'.
+//                          Current session is marked.
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
 //
 //////////////////////////////////////////////////////////////////////////////////
 
-#pragma pack(1)
-struct Inode
+void DisplaySessions()
 {
-    char FileName[20];     // Name of file
-    int InodeNumber;       // Unique id
-    int FileSize;          // Max allowed size (MAXFILESIZE)
-    int ActualFileSize;    // Current used size
-    int FileType;          // 0 = free, 1 = regular file
-    int ReferenceCount;    // How many times file is opened
-    int Permission;        // READ / WRITE / READ+WRITE
-    char *Buffer;          // Actual data of file (Actual File allocation Address)
-    struct Inode *next;    // Next inode in linked list
-};
-
-typedef struct Inode INODE;
-typedef struct Inode* PINODE;
-typedef struct Inode** PPINODE;
+    int i = 0;
 
-//////////////////////////////////////////////////////////////////////////////////
-//
-//  Structure Name :            FileTable
-//  Description  :              Holds the information about Opened File
-//
-//////////////////////////////////////////////////////////////////////////////////
+    printf("Session\tName\t\tDescriptors\tUFDT size\n");
 
-struct FileTable
-{
-    int ReadOffset;     // Where next read will start
-    int WriteOffset;    // Where next write will start
-    int Mode;           // Open mode
-    PINODE ptrinode;    // Pointer to its inode (Pointer created for Inode)
-};
+    pthread_mutex_lock(&SessionLock);
 
-typedef FileTable FILETABLE;
-typedef FileTable * PFILETABLE;
+    for(i = 0; i < sessionobj.Capacity; i++)
+    {
+        if(sessionobj.Sessions[i] == NULL)
+        {
+            continue;
+        }
 
-//////////////////////////////////////////////////////////////////////////////////
-//
-//  Structure Name :            UAREA
-//  Description  :              Holds the information about Process
-//
-//////////////////////////////////////////////////////////////////////////////////
+        printf("%c%d\t%-16s%d\t\t%d\n",((sessionobj.Sessions[i] == CurrentUArea) ? '*' : ' '),
+                i + 1,sessionobj.Sessions[i]->ProcessName,
+                sessionobj.Sessions[i]->OpenCount,sessionobj.Sessions[i]->Capacity);
+    }
 
-struct UAREA
-{
-    char ProcessName[20];               // Name of running process
-    PFILETABLE UFDT[MAXOPENFILES];      // FileTable *  UFDT is Array and MAXOPENFILES is size(for Ex : 30)
-                                        // Array of open files
-};
+    pthread_mutex_unlock(&SessionLock);
+}
 
 //////////////////////////////////////////////////////////////////////////////////
 //
-//  Global variables or objects used in the Project
+//  Function Name :         LsFile
+//  Description :           This function lists existing files sorted by name,
+//                          taking them from the library in batches of LSBATCH.
+//  Displayed Details :     Inode number, File name and Actual file size.
+//  Purpose :               To provide file listing similar to 'ls -l'.
+//  Input :                 prefix -> Prefix of names to be listed, NULL for all
+//  Output :                Number of files listed, error code of ListFiles()
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/01/2026
 //
 //////////////////////////////////////////////////////////////////////////////////
 
-BootBlock bootobj;
-SuperBlock superobj;
-UAREA uareaobj;
-
-PINODE head = NULL;
+//  ls -l
+int LsFile(
+                const char *prefix
+            )
+{
+    FILEENTRY Entries[LSBATCH];
+    LISTCURSOR Cursor;
+    int Count = 0;
+    int Total = 0;
+    int i = 0;
 
-//////////////////////////////////////////////////////////////////////////////////
-//
-//  Function Name :     InitialiseUAREA
-//  Description :       This function prepares the UAREA (User Area) structure for use.
-//                      It sets the default process name and marks all entries in the
-//                      User File Descriptor Table (UFDT) as NULL, which means no files
-//                      are opened at the start of the system.
-//                      It is called once during system boot.
-//  Effect :            - Sets process name to "Myexe"
-//                      - Makes all UFDT entries empty (no open files)
-//  Author :            Omkar Sachin Narlawar
-//  Date :              13/01/2026
-//
-//////////////////////////////////////////////////////////////////////////////////
+    memset(&Cursor, 0, sizeof(Cursor));
 
-void InitialiseUAREA()
-{
-    strcpy(uareaobj.ProcessName,"Myexe");
+    //  First batch reports a wrong prefix before the table is started
+    Count = ListFiles(prefix, Entries, LSBATCH, &Cursor);
+    if(Count < 0)
+    {
+        return Count;
+    }
 
-    int i = 0;
+    printf("--------------------------------------------------------------------\n");
+    printf("-----------------Omkar's CVFS Files Information------------------\n");
 
-    for(i = 0; i < MAXOPENFILES; i++)
+    while(Count > 0)
     {
-        uareaobj.UFDT[i] = NULL;        // No file opened initially
+        for(i = 0; i < Count; i++)
+        {
+            printf("%d\t%s%s\t%lld\n",Entries[i].InodeNumber,Entries[i].Name,(Entries[i].Directory ? "/" : ""),Entries[i].Size);
+        }
+
+        Total = Total + Count;
+        Count = ListFiles(prefix, Entries, LSBATCH, &Cursor);
     }
 
-    printf("Omkar's CVFS : UAREA gets initialised successfully\n");
+    printf("--------------------------------------------------------------------\n");
+
+    return Total;
 }
 
 //////////////////////////////////////////////////////////////////////////////////
 //
-//  Function Name :         InitialiseSuperBlock
-//  Description :           This function initializes the SuperBlock which keeps
-//                          track of total and free inodes (files) in the file
-//                          system.
-//                          At the beginning all inodes are free.
+//  Function Name :         StatFileSystem
+//  Description :           Displays occupancy and fragmentation of the inode
+//                          table, and files whose data is kept inline. Fragmentation is measured as number of runs
+//                          of consecutive free inodes and the longest run.
+//                          Logical bytes are the block bytes files refer,
+//                          physical bytes the blocks actually used; they
+//                          differ by the blocks which deduplication shares
+//                          and compression saves. Compression ratio is
+//                          shown with the time it has cost since start.
+//  Output :                Statistics of super block on the console
 //  Author :                Omkar Sachin Naralwar
-//  Date :                  13/01/2026
+//  Date :                  16/10/2026
 //
 //////////////////////////////////////////////////////////////////////////////////
 
-void InitialiseSuperBlock()
+void StatFileSystem()
 {
-    superobj.TotalInodes = MAXINODE;
-    superobj.FreeInodes = MAXINODE;
+    int i = 0;
+    int UsedInodes = superobj.TotalInodes - superobj.FreeInodes;
+    int FreeRuns = 0;
+    int RunLength = 0;
+    int LongestRun = 0;
+    int InlineFiles = 0;
+    int SharedBlocks = 0;
+    int IndexedBlocks = 0;
+    int Clusters = 0;           // Compressed clusters stored in the image
+    int ClusterBlocks = 0;      // Blocks which hold them
+    int Length = 0;
+    int Used = 0;
+    int SnapshotCount = 0;
+    long long SnapshotBytes = 0;
+    long long LogicalBytes = 0;
+    long long PhysicalBytes = (long long)(superobj.TotalBlocks - superobj.FreeBlocks) * superobj.BlockSize;
+
+    for(i = 0; i < superobj.TotalBlocks; i++)
+    {
+        if(BlockRecords[i].Refs > 1)
+        {
+            SharedBlocks++;
+        }
 
-    printf("Omkar's CVFS : Super block gets initialised successfully\n");
-}
+        if(BlockRecords[i].Hash != 0)
+        {
+            IndexedBlocks++;
+        }
 
-//////////////////////////////////////////////////////////////////////////////////
-//
-//  Function Name :         CreateDILB
-//  Description :           This function creates the Disk Inode List Block (DILB)
-//                          as a linked list of inodes. Each inode represents a
-//                          possible file. Initially all inodes are marked as free
-//                          and have no data buffer.
-//  Effect :                - Allocates MAXINODE inode nodes
-//                          - Links them into a singly linked list
-//                          - Marks each inode as unused (FileType = 0)
-//  Author :                Omkar Sachin Naralwar
-//  Date :                  13/01/2026
-//
-//////////////////////////////////////////////////////////////////////////////////
+        //  Every file which refers a compressed cluster sees all its blocks
+        if((BlockRecords[i].Refs > 0) && ((BlockRecords[i].Flags & BLOCK_COMPRESSED) != 0))
+        {
+            memcpy(&Length, BlockData(i + 1), sizeof(Length));
+            Used = (Length + CLUSTERHEADER + superobj.BlockSize - 1) / superobj.BlockSize;
 
-void CreateDILB()
-{
-    int i = 1;
-    PINODE newn = NULL;
-    PINODE temp = head;
+            Clusters++;
+            ClusterBlocks = ClusterBlocks + Used;
+            LogicalBytes = LogicalBytes + ((long long)BlockRecords[i].Refs * (CLUSTERBLOCKS - Used) * superobj.BlockSize);
+        }
+    }
 
-    for(i = 1; i <= MAXINODE; i++)
+    for(i = 0; i < superobj.TotalInodes; i++)
     {
-        newn = (PINODE)malloc(sizeof(INODE));
+        if((DILBCore[i].FileType != 0) && ((DILB[i].Flags & INODE_INLINE) != 0))
+        {
+            InlineFiles++;
+        }
 
-        strcpy(newn->FileName,"\0");
-        newn->InodeNumber = i;
-        newn->FileSize = 0;
-        newn->ActualFileSize = 0;
-        newn->FileType = 0;
-        newn->ReferenceCount = 0;
-        newn->Permission = 0;
-        newn->Buffer = NULL;
-        newn->next = NULL;
+        if(DILBCore[i].FileType != 0)
+        {
+            LogicalBytes = LogicalBytes + DILB[i].FileSize;
+        }
 
-        if(temp == NULL)            // LL is Empty
+        if(DILBCore[i].FileType == 0)
         {
-            head = newn;
-            temp = head;
+            if(RunLength == 0)
+            {
+                FreeRuns++;
+            }
+
+            RunLength++;
+
+            if(RunLength > LongestRun)
+            {
+                LongestRun = RunLength;
+            }
         }
-        else                        // LL contains atleast one node
+        else
         {
-            temp->next = newn;
-            temp = temp->next;
+            RunLength = 0;
         }
     }
 
-    printf("Omkar's CVFS : DILB created successfully\n");
-}
+    printf("--------------------------------------------------------------------\n");
+    printf("-----------------Omkar's CVFS File System Statistics-------------\n");
+    printf("Total inodes        : %d\n",superobj.TotalInodes);
+    printf("Used inodes         : %d\n",UsedInodes);
+    printf("Free inodes         : %d\n",superobj.FreeInodes);
+    printf("Occupancy           : %.2f %%\n",(100.0 * UsedInodes) / superobj.TotalInodes);
+    printf("Free runs           : %d\n",FreeRuns);
+    printf("Longest free run    : %d\n",LongestRun);
+
+    //  0 when all free inodes are contiguous, near 1 when they are scattered
+    if(superobj.FreeInodes > 0)
+    {
+        printf("Fragmentation       : %.2f\n",1.0 - ((double)LongestRun / superobj.FreeInodes));
+    }
+    else
+    {
+        printf("Fragmentation       : 0.00\n");
+    }
+    printf("Block size          : %d\n",superobj.BlockSize);
+    printf("Total blocks        : %d\n",superobj.TotalBlocks);
+    printf("Free blocks         : %d\n",superobj.FreeBlocks);
+    printf("Inline size         : %d bytes\n",superobj.InlineSize);
+    printf("Inline files        : %d\n",InlineFiles);
+    printf("Deduplication       : %s\n",(superobj.Dedup ? "on" : "off"));
+    printf("Logical bytes       : %lld\n",LogicalBytes);
+    printf("Physical bytes      : %lld\n",PhysicalBytes);
+    printf("Saved bytes         : %lld\n",((LogicalBytes > PhysicalBytes) ? (LogicalBytes - PhysicalBytes) : 0));
+    printf("Shared blocks       : %d\n",SharedBlocks);
+    printf("Indexed blocks      : %d\n",IndexedBlocks);
+
+    if(PhysicalBytes > 0)
+    {
+        printf("Dedup ratio         : %.2f\n",(double)LogicalBytes / PhysicalBytes);
+    }
+    else
+    {
+        printf("Dedup ratio         : 1.00\n");
+    }
 
-//////////////////////////////////////////////////////////////////////////////////
-//
-//  Function Name :         StartAuxillaryDataInitialisation
-//  Description :           It is used to call all such functions which are 
-//                          used to initialise auxillary data.
-//                          This is the master initialization routine of CVFS.
-//                          It sets the boot message and calls all other
-//                          initialization functions required before the file
-//                          system starts.
-//  Calls internally :      - InitialiseSuperBlock()
-//                          - CreateDILB()
-//                          - InitialiseUAREA()
-//  Effect :                The virtual file system becomes ready to accept commands.                        
-//  Author :                Omkar Sachin Naralwar
-//  Date :                  13/01/2026
-//
-//////////////////////////////////////////////////////////////////////////////////
+    printf("Compression         : %s\n",(superobj.Compress ? "on" : "off"));
+    printf("Compressed clusters : %d in %d blocks\n",Clusters,ClusterBlocks);
 
-void StartAuxillaryDataInitialisation()
-{
-    strcpy(bootobj.Information,"Booting process of Omkar's CVFS is done");
+    if(ClusterBlocks > 0)
+    {
+        printf("Compression ratio   : %.2f\n",(double)(Clusters * CLUSTERBLOCKS) / ClusterBlocks);
+    }
+    else
+    {
+        printf("Compression ratio   : 1.00\n");
+    }
 
-    printf("%s\n",bootobj.Information);
+    printf("Compression saved   : %lld bytes\n",(long long)((Clusters * CLUSTERBLOCKS) - ClusterBlocks) * superobj.BlockSize);
+
+    //  CPU cost since start against the bytes it handled
+    printf("Compressed          : %lld clusters, %lld did not shrink, %lld rewritten raw\n",
+           compressobj.Compressed,compressobj.Incompressible,compressobj.Expanded);
+
+    if(compressobj.CompressNs > 0)
+    {
+        printf("Compress speed      : %.1f MB/s (%lld -> %lld bytes)\n",
+               (compressobj.BytesIn * 1000.0) / compressobj.CompressNs,compressobj.BytesIn,compressobj.BytesOut);
+    }
 
-    InitialiseSuperBlock();
+    if(compressobj.DecompressNs > 0)
+    {
+        printf("Decompress speed    : %.1f MB/s\n",(compressobj.DecompressBytes * 1000.0) / compressobj.DecompressNs);
+    }
 
-    CreateDILB();
+    printf("Cluster cache       : %lld hits, %lld misses\n",compressobj.CacheHits,compressobj.CacheMisses);
 
-    InitialiseUAREA();
+    for(i = 0; i < MAXSNAPSHOTS; i++)
+    {
+        if(Snapshots[i].Name[0] != '\0')
+        {
+            SnapshotCount++;
+            SnapshotBytes = SnapshotBytes + Snapshots[i].Table.FileSize;
+        }
+    }
 
-    printf("Omkar's CVFS : Auxillary data initialise successfully\n");
+    printf("Snapshots           : %d of %d (%lld bytes of metadata)\n",SnapshotCount,MAXSNAPSHOTS,SnapshotBytes);
+    printf("Image size          : %lld bytes\n",superobj.ImageSize);
+    printf("Image               : %s\n",((ImageFd >= 0) ? ImagePath : "(in memory)"));
+    printf("Sessions            : %d\n",sessionobj.Count);
+    printf("Open file tables    : %lld\n",OpenFileTables);
+    printf("Live memory         : %lld bytes\n",arenaobj.LiveBytes);
+    printf("Peak memory         : %lld bytes\n",arenaobj.PeakBytes);
+    printf("Mapped memory       : %lld bytes%s\n",arenaobj.MappedBytes,(arenaobj.HugePages ? " (huge pages requested)" : ""));
+    printf("Allocations         : %lld (%lld released)\n",arenaobj.Allocations,arenaobj.Releases);
+
+    for(i = 0; i < NSLABCLASS; i++)
+    {
+        if(arenaobj.Classes[i].Live > 0)
+        {
+            printf("Slab %-4d bytes     : %lld live\n",(int)arenaobj.Classes[i].Size,arenaobj.Classes[i].Live);
+        }
+    }
+    printf("--------------------------------------------------------------------\n");
 }
 
 //////////////////////////////////////////////////////////////////////////////////
 //
-//  Function Name :         DisplayHelp
-//  Description :           Displays a help menu showing all supported shell
-//                          commands and their basic purpose so that the user
-//                          can understand how to use the CVFS shell.
-//  Output :                List of commands like ls, creat, read, write, unlink,
-//                          exit, etc.
+//  Function Name :         DisplayPerf
+//  Description :           Displays calls, average, p50, p99 and longest
+//                          latency of every operation counted by library.
 //  Author :                Omkar Sachin Naralwar
-//  Date :                  14/01/2026
+//  Date :                  16/10/2026
 //
 //////////////////////////////////////////////////////////////////////////////////
 
-void DisplayHelp()
+void DisplayPerf()
 {
-    printf("--------------------------------------------------------------------\n");
-    printf("---------------------Omkar's CVFS Help Page----------------------\n");
-    printf("--------------------------------------------------------------------\n");
-    printf("\n");
-    
-    printf("man     : It is used to display manual page\n");
-    printf("ls      : List all files with details\n");
-    printf("clear   : It is used to clear the terminal\n");
-    printf("creat   : It is used to create new file\n");
-    printf("write   : It is used to write the data into file\n");
-    printf("read    : It is used to read the data from the file\n");
-    printf("stat    : It is used to display statistical information\n");
-    printf("unlink  : It is used to delete the file\n");
-    printf("exit    : It is use to terminate Omkar's CVFS\n");
-    
-    printf("\n");
-    printf("--------------------------------------------------------------------\n");
+    const char *Names[NPERFOPS] = {"create", "open", "lookup", "read", "write", "unlink"};
+    PERFSTAT Stats[NPERFOPS];
+    int i = 0;
+
+    if(ReadPerfCounters(Stats) == ERR_NOT_SUPPORTED)
+    {
+        printf("Perf counters are not built in (CVFS_NO_PERF)\n");
+        return;
+    }
+
+    printf("Op\tCalls\t\tAvg ns\tp50 ns\tp99 ns\tMax ns\n");
+
+    for(i = 0; i < NPERFOPS; i++)
+    {
+        printf("%s\t%-12lld\t%.0f\t%lld\t%lld\t%lld\n",
+                Names[i], Stats[i].Count,
+                (Stats[i].Timed == 0) ? 0.0 : (double)Stats[i].TotalNs / Stats[i].Timed,
+                PerfPercentile(&Stats[i], 50), PerfPercentile(&Stats[i], 99), Stats[i].MaxNs);
+    }
 }
 
 //////////////////////////////////////////////////////////////////////////////////
 //
-//  Function Name :         ManPageDisplay
-//  Description :           This function displays detailed manual
-//                          information of a specific command similar to
-//                          the Linux 'man' command.
-//  Input :                 Name of the command whose manual is required.
+//  Function Name :         DisplayJournal
+//  Description :           Displays settings and counters of the journal.
 //  Author :                Omkar Sachin Naralwar
-//  Date :                  14/01/2026
+//  Date :                  16/10/2026
 //
 //////////////////////////////////////////////////////////////////////////////////
 
-void ManPageDisplay(char Name[])
+void DisplayJournal()
 {
-    if(strcmp("ls",Name) == 0)
-    {
-        printf("About        : It is used to list the names of all files\n");
-        printf("Usage        : ls\n");
-    }
-    else if(strcmp("man",Name) == 0)
-    {
-        printf("About        : It is used to Display manual page\n");
-        printf("Usage        : man command_name\n");
-        printf("command_name : It is the name of command\n");
-    }
-    else if(strcmp("exit",Name) == 0)
-    {
-        printf("About        : It is used to terminate the shell\n");
-        printf("Usage        : exit\n");
-    }
-    else if(strcmp("clear",Name) == 0)
-    {
-        printf("About        : It is used to clear the shell\n");
-        printf("Usage        : clear\n");
-    }
-    else if(strcmp("creat",Name) == 0)
-    {
-        printf("About        : It is used to create the new file\n");
-        printf("Usage        : creat\n");
-    }
-    else if(strcmp("unlink",Name) == 0)
-    {
-        printf("About        : It is used to delete the file\n");
-        printf("Usage        : unlink\n");
-    }
-    else
-    {
-        printf("No manual entry for %s\n",Name);
-    }
+    printf("Journal             : %s\n",((ImageFd >= 0) ? journalobj.Path : "(no image mounted)"));
+    printf("Mode                : %s\n",(journalobj.DataJournal ? "data (data and metadata journaled)" : "ordered (metadata journaled)"));
+    printf("Group size          : %d transactions per fsync\n",journalobj.GroupSize);
+    printf("Pending             : %d transactions\n",journalobj.Pending);
+    printf("Journal size        : %lld bytes\n",journalobj.FileSize);
+    printf("Commits             : %lld\n",journalobj.Commits);
+    printf("Flushes             : %lld\n",journalobj.Flushes);
+    printf("Checkpoints         : %lld\n",journalobj.Checkpoints);
+    printf("Replayed at mount   : %lld\n",journalobj.Replayed);
 }
 
 //////////////////////////////////////////////////////////////////////////////////
 //
-//  Function Name :         IsFileExist
-//  Description :           It is used to check whether file is already exist or not
-//  Input :                 It accepts file name,
-//                          File name to be searched.
-//  Output :                true  -> file is present
-//                          false -> file is not present
+//  Function Name :         GetTimeNs
+//  Description :           Returns monotonic clock value in nanoseconds. It is
+//                          used to measure the duration of benchmarks.
 //  Author :                Omkar Sachin Naralwar
-//  Date :                  16/01/2026
+//  Date :                  16/10/2026
 //
 //////////////////////////////////////////////////////////////////////////////////
 
-bool IsFileExist(
-                    char *name            //  File name
-                )
+long long GetTimeNs()
 {
-    PINODE temp = head;
-    bool bFlag = false;
+    struct timespec ts;
 
-    while(temp != NULL)
-    {
-        if((strcmp(name,temp->FileName) == 0) && (temp->FileType == REGULARFILE))
-        {
-            bFlag = true;
-            break;
-        }
-        temp = temp->next;
-    }
+    clock_gettime(CLOCK_MONOTONIC, &ts);
 
-    return bFlag;
+    return ((long long)ts.tv_sec * 1000000000LL) + ts.tv_nsec;
 }
 
 //////////////////////////////////////////////////////////////////////////////////
 //
-//  Function Name :         CreateFile
-//  Description :           This function creates a new regular file
-//  Working :               - Validates parameters
-//                          - Checks free inode availability
-//                          - Checks duplicate file name
-//                          - Allocates inode and file table
-//                          - Allocates memory buffer for file data
-//                          - Updates super block information
-//  Input :                 It accepts -
-//                                   name        -> Name of file
-//                                   permission  -> 1(Read),2(Write),3(Read+Write)
-//  Output :                It returns File descriptor on success
-//                          Error code on failure
+//  Function Name :         BenchmarkNameLookup
+//  Description :           Compares the linear scan over the DILB with the
+//                          name index for the given number of files.
+//                          A private inode table and index are built so the
+//                          running file system is not disturbed.
+//  Input :                 count -> Number of files present in the benchmark
+//  Output :                Average nanoseconds per lookup for both methods
 //  Author :                Omkar Sachin Naralwar
-//  Date :                  16/01/2026
+//  Date :                  16/10/2026
 //
 //////////////////////////////////////////////////////////////////////////////////
 
-int CreateFile(
-                    char *name,             // Name of new file
-                    int permission          // Permission for that file
-                )
+void BenchmarkNameLookup(
+                            int count
+                        )
 {
-    PINODE temp = head;
+    PINODE table = NULL;
+    NAMEINDEX index;
+    char name[20] = {'\0'};
+    int ScanProbes = 0;
+    int IndexProbes = 1000000;
+    int Found = 0;
     int i = 0;
+    int j = 0;
+    long long Start = 0;
+    long long ScanTime = 0;
+    long long IndexTime = 0;
 
-    printf("Total number of Inodes remaining : %d\n",superobj.FreeInodes);
+    table = (PINODE)CvfsAlloc(count * sizeof(INODE));
 
-    //  If name is missing
-    if(name == NULL)
+    if((table == NULL) || (NameIndexCreate(&index, count, table) == false))
     {
-        return ERR_INVALID_PARAMETER;
+        printf("Error : Unable to allocate benchmark inodes\n");
+        CvfsFree(table, count * sizeof(INODE));
+        return;
     }
 
-    //  If the permission value is wrong
-    //  permission -> 1 -> READ
-    //  permission -> 2 -> WRITE
-    //  permission -> 3 -> READ + WRITE
-    if(permission < 1 || permission > 3)
-    {
-        return ERR_INVALID_PARAMETER;
-    }
+    memset(table, 0, count * sizeof(INODE));
 
-    //  If the inodes are full
-    if(superobj.FreeInodes == 0)
+    //  Names file0 .. fileN-1, all inodes are in use
+    for(i = 0; i < count; i++)
     {
-        return ERR_NO_INODES;
+        snprintf(table[i].FileName, sizeof(table[i].FileName), "file%d", i);
+        table[i].InodeNumber = i + 1;
+
+        NameIndexInsert(&index, &table[i]);
     }
 
-    //  If file is already present
-    if(IsFileExist(name) == true)
+    //  Scan is O(N) per lookup, so fewer probes are used for big N
+    ScanProbes = 10000000 / count;
+    if(ScanProbes < 10)
     {
-        return ERR_FILE_ALREADY_EXIST;
+        ScanProbes = 10;
     }
 
-    //  Search empty Inode
-    while(temp != NULL)
+    Start = GetTimeNs();
+    for(i = 0; i < ScanProbes; i++)
     {
-        if(temp->FileType == 0)
+        snprintf(name, sizeof(name), "file%d", (int)(((unsigned long long)i * 2654435761ULL) % count));
+
+        for(j = 0; j < count; j++)
         {
-            break;
+            if(strcmp(name,table[j].FileName) == 0)
+            {
+                Found++;
+                break;
+            }
         }
-        temp = temp->next;
     }
+    ScanTime = GetTimeNs() - Start;
 
-    if(temp == NULL)            //  If temp reached to last node
+    Start = GetTimeNs();
+    for(i = 0; i < IndexProbes; i++)
     {
-        printf("There is no Inode");
-        return ERR_NO_INODES;
-    }
+        snprintf(name, sizeof(name), "file%d", (int)(((unsigned long long)i * 2654435761ULL) % count));
 
-    //  Search for empty UDFT entry
-    // Note : 0 1 2 are reserved
-    for(i = 3; i < MAXOPENFILES ; i++)
-    {
-        if(uareaobj.UFDT[i] == NULL)
+        if(NameIndexLookup(&index, ROOTDIRECTORY, name) != NULL)
         {
-            break;
+            Found++;
         }
     }
+    IndexTime = GetTimeNs() - Start;
 
-    //  UFDT is full
-    if(i == MAXOPENFILES)
-    {
-        return ERR_MAX_FILES_OPEN;
-    }
-
-    //  Allocate memory for file table
-    uareaobj.UFDT[i] = (PFILETABLE)malloc(sizeof(FILETABLE));
-
-    //  Initialise File Table
-    uareaobj.UFDT[i]->ReadOffset = 0;
-    uareaobj.UFDT[i]->WriteOffset = 0;
-    uareaobj.UFDT[i]->Mode = permission;
+    printf("%d\t%.1f\t\t%.1f\t\t%d\n",
+            count,
+            (double)ScanTime / ScanProbes,
+            (double)IndexTime / IndexProbes,
+            (Found == (ScanProbes + IndexProbes)));
 
-    //  Connect File Table with Inode
-    uareaobj.UFDT[i]->ptrinode = temp;
+    //  Release private table and index
+    CvfsFree(table, count * sizeof(INODE));
 
-    //  Initialise elements of Inode
-    strcpy(uareaobj.UFDT[i]->ptrinode->FileName,name);
-    uareaobj.UFDT[i]->ptrinode->FileSize = MAXFILESIZE;
-    uareaobj.UFDT[i]->ptrinode->ActualFileSize = 0;
-    uareaobj.UFDT[i]->ptrinode->FileType = REGULARFILE;
-    uareaobj.UFDT[i]->ptrinode->ReferenceCount = 1;
-    uareaobj.UFDT[i]->ptrinode->Permission = permission;
-
-    //  Allocate memory for files data
-    uareaobj.UFDT[i]->ptrinode->Buffer = (char *)malloc(MAXFILESIZE);
-
-    superobj.FreeInodes--;
-
-    return i;           // File descriptor
-    
+    NameIndexDestroy(&index);
 }
 
 //////////////////////////////////////////////////////////////////////////////////
 //
-//  Function Name :         LsFile
-//  Description :           This function traverses the inode list and
-//                          displays information of all existing files.
-//  Displayed Details :     Inode number, File name and Actual file size.
-//  Purpose :               To provide file listing similar to 'ls -l'.
+//  Function Name :         BenchmarkDescriptors
+//  Description :           Measures close and open of a descriptor while the
+//                          session holds given number of descriptors. Closed
+//                          descriptor is the lowest free one, so the open
+//                          must get it back. One file is created for the
+//                          test and deleted at the end.
+//  Input :                 count -> Descriptors held by the session
+//  Output :                Average nanoseconds per close and open pair
 //  Author :                Omkar Sachin Naralwar
-//  Date :                  16/01/2026
+//  Date :                  16/10/2026
 //
 //////////////////////////////////////////////////////////////////////////////////
 
-//  ls -l
-void LsFile()
+void BenchmarkDescriptors(
+                            int count
+                        )
 {
-    PINODE temp = head;
+    char name[20] = "bench_fd";
+    int *fds = NULL;
+    int Opened = 0;
+    int Verified = 0;
+    int i = 0;
+    int k = 0;
+    int fd = 0;
+    long long Start = 0;
+    long long Time = 0;
 
-    printf("--------------------------------------------------------------------\n");
-    printf("-----------------Omkar's CVFS Files Information------------------\n");
-    
-    while(temp != NULL)
+    fds = (int *)CvfsAlloc(count * sizeof(int));
+
+    if(fds == NULL)
     {
-        if(temp->FileType != 0)
-        {
-            printf("%d\t%s\t%d\n",temp->InodeNumber,temp->FileName,temp->ActualFileSize);
-        }
-        
-        temp = temp->next;
+        printf("Error : Unable to allocate benchmark descriptors\n");
+        return;
     }
 
-    printf("--------------------------------------------------------------------\n");
-}
-
-//////////////////////////////////////////////////////////////////////////////////
-//
-//  Function Name :         UnlinkFile()
-//  Description :           This function deletes an existing file from
-//                          the virtual file system.
-//  Working :               - Finds matching file in UFDT
-//                          - Frees file data buffer
-//                          - Resets inode metadata
-//                          - Frees file table entry
-//                          - Increments free inode count
-//  Input :                 Name of file to be deleted.
-//  Return :                EXECUTE_SUCCESS on success
-//                          Error code on failure
-//  Author :                Omkar Sachin Naralwar
-//  Date :                  22/01/2026
-//
-//////////////////////////////////////////////////////////////////////////////////
-
-int UnlinkFile(
-                    char *name
-                )
-{
-    int i = 0;
+    fds[0] = CreateFile(name, READ + WRITE);
 
-    if(name == NULL)
+    if(fds[0] < 0)
     {
-        return ERR_INVALID_PARAMETER;
+        printf("Error : Benchmark needs a free inode\n");
+        CvfsFree(fds, count * sizeof(int));
+        return;
     }
 
-    if(IsFileExist(name) == false)
+    for(Opened = 1; Opened < count; Opened++)
     {
-        return ERR_FILE_NOT_EXIST;
+        fds[Opened] = OpenFile(name, READ);
+
+        if(fds[Opened] < 0)
+        {
+            break;
+        }
     }
 
-    //  Travel the UDFT
-    for(i = 0; i < MAXOPENFILES; i++)
+    if(Opened == count)
     {
-        if(uareaobj.UFDT[i] != NULL)
+        Start = GetTimeNs();
+        for(i = 0; i < BENCHFDOPS; i++)
         {
-            if(strcmp(uareaobj.UFDT[i]->ptrinode->FileName, name) == 0)
+            k = (int)(((unsigned long long)i * 2654435761ULL) % count);
+
+            CloseFile(fds[k]);
+            fd = OpenFile(name, READ);
+
+            if(fd == fds[k])
             {
-                //  Deallocate memory of Buffer
-                free(uareaobj.UFDT[i]->ptrinode->Buffer);
-                uareaobj.UFDT[i]->ptrinode->Buffer = NULL;
-
-                // Reset all values of inode
-                // Dont deallocate memory of inode
-                uareaobj.UFDT[i]->ptrinode->FileSize = 0;
-                uareaobj.UFDT[i]->ptrinode->ActualFileSize = 0;
-                uareaobj.UFDT[i]->ptrinode->FileType = 0;
-                uareaobj.UFDT[i]->ptrinode->ReferenceCount = 0;
-                uareaobj.UFDT[i]->ptrinode->Permission = 0;
-
-                //////////////////////////////////////////////////////////////////////////////////
-                //
-                //  Use of memset()
-                //  Description :
-                //      memset() is used to clear a block of memory by setting all bytes
-                //      to a specific value. In this project, it is used while deleting
-                //      a file to erase the file name stored in the inode.
-                //
-                //  Why it is used :
-                //      When a file is deleted, the inode is reused for future files.
-                //      Clearing the old file name avoids garbage values and ensures
-                //      correct file listing and existence checks.
-                //
-                //  Statement Used :
-                //      memset(ptrinode->FileName, '\0', sizeof(ptrinode->FileName));
-                //
-                //////////////////////////////////////////////////////////////////////////////////
-
-                memset(uareaobj.UFDT[i]->ptrinode->FileName, '\0', sizeof(uareaobj.UFDT[i]->ptrinode->FileName));
-
-                //  Deallocate memory of file table
-                free(uareaobj.UFDT[i]);
-
-                //  Set NULL to UFDT
-                uareaobj.UFDT[i] = NULL;
-
-                //  Increment free inodes count
-                superobj.FreeInodes++;
-
-                break;      // break is of for loop (IMP)
-
-            }   //  End of if
-        }       //  End of if
-    }           //  End of for
+                Verified++;
+            }
 
-    return EXECUTE_SUCCESS;
-}               //  End of Function
+            fds[k] = fd;
+        }
+        Time = GetTimeNs() - Start;
 
-//////////////////////////////////////////////////////////////////////////////////
-//
-//  Function Name :         WriteFile()
-//  Description :           This function writes given data into the file
-//                          associated with the provided file descriptor.
-//  Checks :                Valid FD, write permission and available space.
-//  Effect :                Copies data into file buffer and updates
-//                          write offset as well as actual file size.
-//  Input :                 fd   -> File descriptor
-//                          data -> Source buffer(Address of buffer which contains data)
-//                          size -> Size of data that we want to write
-//  Output :                Number of bytes successfully written or error code.
-//  Author :                Omkar Sachin Naralwar
-//  Date :                  22/01/2026
+        printf("%d\t%.1f\t\t%d\t\t%d\n",
+                count, (double)Time / BENCHFDOPS, CurrentUArea->Capacity, (Verified == BENCHFDOPS));
+    }
+    else
+    {
+        printf("Error : Unable to open %d descriptors\n",count);
+    }
+
+    //  Remove benchmark file
+    for(i = 0; i < Opened; i++)
+    {
+        CloseFile(fds[i]);
+    }
+
+    UnlinkFile(name);
+
+    CvfsFree(fds, count * sizeof(int));
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         BenchmarkBatchIo
+//  Description :           Compares small reads and writes done one call per
+//                          operation, with readv / writev style vectors, and
+//                          through a submission ring. All methods touch the
+//                          same BENCHIOSPAN bytes of one file, which is
+//                          created for the test and deleted at the end.
+//  Output :                Average nanoseconds per operation for each method
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+void BenchmarkBatchIo()
+{
+    char name[20] = "bench_io";
+    char Buffer[BENCHIOSPAN];
+    struct iovec Vector[BENCHIOBATCH];
+    IOCOMPLETION Completions[BENCHIOBATCH];
+    IORING Ring;
+    PIOREQUEST Request = NULL;
+    PFILETABLE ptrfile = NULL;
+    int fd = 0;
+    int Opcode = 0;
+    int i = 0;
+    int j = 0;
+    long long Ok = 0;
+    long long Start = 0;
+    double Time[3][2];
+
+    fd = CreateFile(name, READ + WRITE);
+
+    if(fd < 0)
+    {
+        printf("Error : Benchmark needs a free inode\n");
+        return;
+    }
+
+    if(CreateIoRing(&Ring, BENCHIOBATCH) == false)
+    {
+        printf("Error : Unable to allocate ring\n");
+        CloseFile(fd);
+        UnlinkFile(name);
+        return;
+    }
+
+    memset(Buffer, 'a', sizeof(Buffer));
+    ptrfile = FileTableOf(fd);
+
+    for(j = 0; j < BENCHIOBATCH; j++)
+    {
+        Vector[j].iov_base = Buffer + (j * BENCHIOSIZE);
+        Vector[j].iov_len = BENCHIOSIZE;
+    }
+
+    //  File gets its blocks once, so every method only overwrites them
+    if(WriteFile(fd, Buffer, BENCHIOSPAN) != BENCHIOSPAN)
+    {
+        printf("Error : Benchmark needs %d free bytes\n",BENCHIOSPAN);
+        DestroyIoRing(&Ring);
+        CloseFile(fd);
+        UnlinkFile(name);
+        return;
+    }
+
+    for(Opcode = 0; Opcode < 2; Opcode++)
+    {
+        //  Single call per operation
+        Start = GetTimeNs();
+        for(i = 0; i < BENCHIOOPS; i++)
+        {
+            j = (i % BENCHIOBATCH) * BENCHIOSIZE;
+
+            if(Opcode == 0)
+            {
+                Ok = Ok + (WriteFileAt(fd, Buffer + j, BENCHIOSIZE, j) == BENCHIOSIZE);
+            }
+            else
+            {
+                Ok = Ok + (ReadFileAt(fd, Buffer + j, BENCHIOSIZE, j) == BENCHIOSIZE);
+            }
+        }
+        Time[0][Opcode] = (double)(GetTimeNs() - Start) / BENCHIOOPS;
+
+        //  One vector of BENCHIOBATCH buffers per call
+        Start = GetTimeNs();
+        for(i = 0; i < BENCHIOOPS; i = i + BENCHIOBATCH)
+        {
+            if(Opcode == 0)
+            {
+                ptrfile->WriteOffset = 0;
+                Ok = Ok + (WriteFileV(fd, Vector, BENCHIOBATCH) == BENCHIOSPAN) * BENCHIOBATCH;
+            }
+            else
+            {
+                ptrfile->ReadOffset = 0;
+                Ok = Ok + (ReadFileV(fd, Vector, BENCHIOBATCH) == BENCHIOSPAN) * BENCHIOBATCH;
+            }
+        }
+        Time[1][Opcode] = (double)(GetTimeNs() - Start) / BENCHIOOPS;
+
+        //  One submission of BENCHIOBATCH requests
+        Start = GetTimeNs();
+        for(i = 0; i < BENCHIOOPS; i = i + BENCHIOBATCH)
+        {
+            for(j = 0; j < BENCHIOBATCH; j++)
+            {
+                Request = IoRingRequest(&Ring);
+                Request->Opcode = (Opcode == 0) ? IO_WRITE : IO_READ;
+                Request->fd = fd;
+                Request->Data = Buffer + (j * BENCHIOSIZE);
+                Request->Size = BENCHIOSIZE;
+                Request->Offset = j * BENCHIOSIZE;
+                Request->UserData = j;
+            }
+
+            SubmitIoRing(&Ring);
+
+            for(j = ReapIoRing(&Ring, Completions, BENCHIOBATCH) - 1; j >= 0; j--)
+            {
+                Ok = Ok + (Completions[j].Result == BENCHIOSIZE);
+            }
+        }
+        Time[2][Opcode] = (double)(GetTimeNs() - Start) / BENCHIOOPS;
+    }
+
+    printf("Operations : %d of %d bytes, batch : %d\n",BENCHIOOPS,BENCHIOSIZE,BENCHIOBATCH);
+    printf("Method\tWrite ns/op\tRead ns/op\n");
+    printf("single\t%.1f\t\t%.1f\n",Time[0][0],Time[0][1]);
+    printf("vector\t%.1f\t\t%.1f\n",Time[1][0],Time[1][1]);
+    printf("ring\t%.1f\t\t%.1f\n",Time[2][0],Time[2][1]);
+    printf("Verified : %d\n",(Ok == 6LL * BENCHIOOPS));
+
+    DestroyIoRing(&Ring);
+    CloseFile(fd);
+    UnlinkFile(name);
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         AsyncCreateFiles
+//  Description :           Coroutine of the async benchmark which creates
+//                          its files one after other with co_create.
+//  Input :                 fds   -> Receives descriptors of created files
+//                          count -> Files wanted
+//  Output :                Number of files created
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+cvfs::Task AsyncCreateFiles(
+                                int *fds,
+                                int count
+                            )
+{
+    char name[20] = {'\0'};
+    int i = 0;
+
+    for(i = 0; i < count; i++)
+    {
+        snprintf(name, sizeof(name), "bench_a%d", i);
+
+        fds[i] = co_await cvfs::co_create(name, READ + WRITE);
+
+        if(fds[i] < 0)
+        {
+            break;
+        }
+    }
+
+    co_return i;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         AsyncWorker
+//  Description :           Coroutine of the async benchmark. It writes its
+//                          own record of BENCHIOSIZE bytes and reads it back
+//                          BENCHASYNCOPS times, checking every read.
+//  Input :                 fd     -> File shared with other coroutines
+//                          offset -> Position of record of this coroutine
+//                          id     -> Number of coroutine, stored in record
+//  Output :                Operations which succeeded
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+cvfs::Task AsyncWorker(
+                        int fd,
+                        int offset,
+                        int id
+                    )
+{
+    char Record[BENCHIOSIZE];
+    char Check[BENCHIOSIZE];
+    int Ok = 0;
+    int i = 0;
+
+    for(i = 0; i < BENCHASYNCOPS; i++)
+    {
+        snprintf(Record, sizeof(Record), "%07u:%07u", (unsigned)id % 10000000u, (unsigned)i);
+
+        if(co_await cvfs::co_write(fd, Record, offset) != BENCHIOSIZE)
+        {
+            continue;
+        }
+
+        if((co_await cvfs::co_read(fd, Check, offset) == BENCHIOSIZE) &&
+           (memcmp(Record, Check, BENCHIOSIZE) == 0))
+        {
+            Ok = Ok + 2;
+        }
+    }
+
+    co_return Ok;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         BenchmarkAsync
+//  Description :           Runs BENCHASYNCTASKS coroutines at once on the
+//                          executor from this single thread, which only
+//                          polls and resumes them. The same operations are
+//                          then timed with the synchronous API. Files are
+//                          created for the test and deleted at the end.
+//  Output :                Peak operations in flight, ns/op and ops/s
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+void BenchmarkAsync()
+{
+    int Workers = (sysconf(_SC_NPROCESSORS_ONLN) < BENCHASYNCWORKERS) ? (int)sysconf(_SC_NPROCESSORS_ONLN) : BENCHASYNCWORKERS;
+    cvfs::Executor Loop((Workers < 1) ? 1 : Workers);
+    cvfs::Task *Tasks = NULL;
+    cvfs::Task Setup;
+    char name[20] = {'\0'};
+    char Record[BENCHIOSIZE];
+    int fds[BENCHASYNCFILES];
+    int Files = 0;
+    int Peak = 0;
+    int i = 0;
+    int j = 0;
+    long long Ok = 0;
+    long long Total = 2LL * BENCHASYNCTASKS * BENCHASYNCOPS;
+    long long Start = 0;
+    double Async = 0;
+    double Sync = 0;
+
+    if(Loop.IsReady() == false)
+    {
+        printf("Error : Unable to start the executor\n");
+        return;
+    }
+
+    Setup = AsyncCreateFiles(fds, BENCHASYNCFILES);
+    Loop.Run();
+    Files = Setup.Result();
+
+    if(Files == 0)
+    {
+        printf("Error : Benchmark needs a free inode\n");
+        return;
+    }
+
+    Tasks = new cvfs::Task[BENCHASYNCTASKS];
+
+    //  Every coroutine runs until its first co_await, then all are in flight
+    Start = GetTimeNs();
+    HoldIoTasks();
+    for(i = 0; i < BENCHASYNCTASKS; i++)
+    {
+        Tasks[i] = AsyncWorker(fds[i % Files], (i / Files) * BENCHIOSIZE, i);
+    }
+    FlushIoTasks();
+
+    while(Loop.Pending() > 0)
+    {
+        if(Loop.Pending() > Peak)
+        {
+            Peak = Loop.Pending();
+        }
+        Loop.Poll(-1);
+    }
+    Async = (double)(GetTimeNs() - Start) / Total;
+
+    for(i = 0; i < BENCHASYNCTASKS; i++)
+    {
+        Ok = Ok + Tasks[i].Result();
+    }
+
+    delete[] Tasks;
+
+    //  Same operations, one at a time on this thread
+    Start = GetTimeNs();
+    for(i = 0; i < BENCHASYNCTASKS; i++)
+    {
+        for(j = 0; j < BENCHASYNCOPS; j++)
+        {
+            WriteFileAt(fds[i % Files], Record, BENCHIOSIZE, (i / Files) * BENCHIOSIZE);
+            ReadFileAt(fds[i % Files], Record, BENCHIOSIZE, (i / Files) * BENCHIOSIZE);
+        }
+    }
+    Sync = (double)(GetTimeNs() - Start) / Total;
+
+    printf("Coroutines : %d, files : %d, workers : %d, operations : %lld\n",
+            BENCHASYNCTASKS, Files, Workers, Total);
+    printf("Peak in flight : %d\n",Peak);
+    printf("Method\tns/op\tops/s\n");
+    printf("async\t%.1f\t%.0f\n",Async,1000000000.0 / Async);
+    printf("sync\t%.1f\t%.0f\n",Sync,1000000000.0 / Sync);
+    printf("Verified : %d\n",(Ok == Total));
+
+    //  Remove benchmark files
+    for(i = 0; i < Files; i++)
+    {
+        snprintf(name, sizeof(name), "bench_a%d", i);
+        CloseFile(fds[i]);
+        UnlinkFile(name);
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Structure Name :            BenchThread
+//  Description  :              Work of one thread of the thread benchmark
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+struct BenchThread
+{
+    pthread_t Thread;   // Thread running BenchmarkWorker()
+    PUAREA Session;     // Session which owns fd
+    int fd;             // Descriptor used by the thread
+    int Mode;           // BENCH_READ_PRIVATE, BENCH_READ_SHARED or BENCH_WRITE_PRIVATE
+    char *Buffer;       // One block of data
+    long long Done;     // Operations which succeeded
+};
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         BenchmarkWorker
+//  Description :           Thread function of the thread benchmark. It reads
+//                          or writes the first block of its file through the
+//                          public file API for BENCHTHREADOPS times.
+//  Input :                 arg -> Address of BenchThread
+//  Output :                NULL
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+void * BenchmarkWorker(
+                        void *arg
+                    )
+{
+    struct BenchThread *Work = (struct BenchThread *)arg;
+    int i = 0;
+
+    SwitchSession(Work->Session);
+
+    for(i = 0; i < BENCHTHREADOPS; i++)
+    {
+        if(Work->Mode == BENCH_WRITE_PRIVATE)
+        {
+            if(WriteFileAt(Work->fd, Work->Buffer, superobj.BlockSize, 0) == superobj.BlockSize)
+            {
+                Work->Done++;
+            }
+        }
+        else
+        {
+            if(ReadFileAt(Work->fd, Work->Buffer, superobj.BlockSize, 0) == superobj.BlockSize)
+            {
+                Work->Done++;
+            }
+        }
+    }
+
+    return NULL;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         BenchmarkThreads
+//  Description :           Measures throughput of concurrent reads and writes
+//                          for 1, 2, 4 .. MAXBENCHTHREADS threads. Files are
+//                          created in the running file system for the test
+//                          and deleted at the end.
+//  Output :                Operations per second for private reads, shared
+//                          reads and private writes
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+void BenchmarkThreads()
+{
+    struct BenchThread Work[MAXBENCHTHREADS];
+    char name[20] = {'\0'};
+    int fds[MAXBENCHTHREADS];
+    int Files = 0;
+    int Threads = 0;
+    int Mode = 0;
+    int i = 0;
+    long long Start = 0;
+    long long Done = 0;
+    double Rate[BENCH_WRITE_PRIVATE + 1];
+
+    memset(Work, 0, sizeof(Work));
+
+    //  One file and one block of data for every thread
+    for(Files = 0; Files < MAXBENCHTHREADS; Files++)
+    {
+        snprintf(name, sizeof(name), "bench_t%d", Files);
+
+        Work[Files].Buffer = (char *)CvfsAlloc(superobj.BlockSize);
+        fds[Files] = CreateFile(name, READ + WRITE);
+
+        if((Work[Files].Buffer == NULL) || (fds[Files] < 0))
+        {
+            CvfsFree(Work[Files].Buffer, superobj.BlockSize);
+            Work[Files].Buffer = NULL;
+            break;
+        }
+
+        memset(Work[Files].Buffer, 'a' + Files, superobj.BlockSize);
+
+        if(WriteFile(fds[Files], Work[Files].Buffer, superobj.BlockSize) != superobj.BlockSize)
+        {
+            CvfsFree(Work[Files].Buffer, superobj.BlockSize);
+            Work[Files].Buffer = NULL;
+            ReleaseDescriptor(CurrentUArea, fds[Files]);
+            UnlinkFile(name);
+            break;
+        }
+    }
+
+    if(Files == 0)
+    {
+        printf("Error : Benchmark needs free inodes, descriptors and blocks\n");
+        return;
+    }
+
+    printf("Online cores : %ld, ops per thread : %d, bytes per op : %d\n",
+            sysconf(_SC_NPROCESSORS_ONLN), BENCHTHREADOPS, superobj.BlockSize);
+    printf("Threads\tRead private ops/s\tRead shared ops/s\tWrite private ops/s\n");
+
+    for(Threads = 1; Threads <= Files; Threads = Threads * 2)
+    {
+        for(Mode = BENCH_READ_PRIVATE; Mode <= BENCH_WRITE_PRIVATE; Mode++)
+        {
+            Start = GetTimeNs();
+
+            for(i = 0; i < Threads; i++)
+            {
+                Work[i].Session = CurrentUArea;
+                Work[i].fd = (Mode == BENCH_READ_SHARED) ? fds[0] : fds[i];
+                Work[i].Mode = Mode;
+                Work[i].Done = 0;
+
+                pthread_create(&Work[i].Thread, NULL, BenchmarkWorker, &Work[i]);
+            }
+
+            Done = 0;
+            for(i = 0; i < Threads; i++)
+            {
+                pthread_join(Work[i].Thread, NULL);
+                Done = Done + Work[i].Done;
+            }
+
+            Rate[Mode] = (double)Done * 1000000000.0 / (GetTimeNs() - Start);
+        }
+
+        printf("%d\t%.0f\t\t%.0f\t\t%.0f\n",
+                Threads, Rate[BENCH_READ_PRIVATE], Rate[BENCH_READ_SHARED], Rate[BENCH_WRITE_PRIVATE]);
+    }
+
+    //  Remove benchmark files
+    for(i = 0; i < Files; i++)
+    {
+        snprintf(name, sizeof(name), "bench_t%d", i);
+        ReleaseDescriptor(CurrentUArea, fds[i]);
+        UnlinkFile(name);
+
+        CvfsFree(Work[i].Buffer, superobj.BlockSize);
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Shell Commands
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Structure Name :            Shell
+//  Description  :              State of the shell used by command handlers
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+struct Shell
+{
+    FILE *Input;        // Stream from which commands (and data of write) are read
+    bool Batch;         // Prompts and banners are not printed
+    bool Exit;          // Set by exit command to end the shell
+    int Line;           // Lines read from Input
+};
+
+typedef struct Shell SHELL;
+
+SHELL shellobj = {stdin, false, false, 0};
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Structure Name :            ShellCommand
+//  Description  :              One command of the shell. Help and man pages
+//                              are printed from it. About, Usage and Details
+//                              hold one line per '\n'. A line written as
+//                              "name\ttext" gets its own label.
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+struct ShellCommand
+{
+    const char *Name;                       // Name typed by user
+    int MinArgs;                            // Fewest words after name
+    int MaxArgs;                            // Most words after name
+    int (*Handler)(int argc, char *argv[]); // Runs command, negative on error
+    const char *Help;                       // One line shown by help
+    const char *About;                      // Description shown by man
+    const char *Usage;                      // Forms of command
+    const char *Details;                    // Meaning of parameters
+};
+
+typedef struct ShellCommand SHELLCOMMAND;
+typedef struct ShellCommand * PSHELLCOMMAND;
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         TokenizeCommand
+//  Description :           Splits command line into words in place, without
+//                          allocating. Words are separated by blanks, text in
+//                          "double" or 'single' quotes is one word and the
+//                          quotes are removed. Every word is terminated with
+//                          '\0' inside line itself.
+//  Input :                 Line -> Command line, it is modified
+//                          Argv -> Receives address of every word
+//                          Max  -> Capacity of Argv
+//  Output :                Number of words, ERR_INVALID_PARAMETER if a quote
+//                          is not closed or there are more than Max words
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+int TokenizeCommand(
+                        char *Line,
+                        char *Argv[],
+                        int Max
+                    )
+{
+    char *Read = Line;          // Next character to examine
+    char *Write = Line;         // Next character of current word
+    char Quote = '\0';          // Quote which is open
+    int Count = 0;
+
+    while(1)
+    {
+        while((*Read == ' ') || (*Read == '\t') || (*Read == '\n') || (*Read == '\r'))
+        {
+            Read++;
+        }
+
+        if(*Read == '\0')
+        {
+            break;
+        }
+
+        if(Count == Max)
+        {
+            return ERR_INVALID_PARAMETER;
+        }
+
+        Argv[Count] = Write;
+        Count++;
+
+        //  Removed quotes make word shorter, so Write never passes Read
+        while(*Read != '\0')
+        {
+            if(Quote != '\0')
+            {
+                if(*Read == Quote)
+                {
+                    Quote = '\0';
+                    Read++;
+                    continue;
+                }
+            }
+            else if((*Read == '"') || (*Read == '\''))
+            {
+                Quote = *Read;
+                Read++;
+                continue;
+            }
+            else if((*Read == ' ') || (*Read == '\t') || (*Read == '\n') || (*Read == '\r'))
+            {
+                break;
+            }
+
+            *Write = *Read;
+            Write++;
+            Read++;
+        }
+
+        if(Quote != '\0')
+        {
+            return ERR_INVALID_PARAMETER;
+        }
+
+        if(*Read != '\0')
+        {
+            Read++;
+        }
+
+        *Write = '\0';
+        Write++;
+    }
+
+    return Count;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         CommandHash
+//  Description :           FNV-1a hash of command name mixed with seed. It is
+//                          evaluated by the compiler to build the command
+//                          slots and at run time to look up a command.
+//  Input :                 Name -> Command name
+//                          Seed -> Seed chosen by BuildCommandSlots()
+//  Output :                Hash value
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+constexpr unsigned int CommandHash(
+                                    const char *Name,
+                                    unsigned int Seed
+                                )
+{
+    unsigned int Hash = 2166136261u ^ (Seed * 16777619u);
+
+    while(*Name != '\0')
+    {
+        Hash = (Hash ^ (unsigned char)*Name) * 16777619u;
+        Name++;
+    }
+
+    return Hash ^ (Hash >> 15);
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         CommandLs ... CommandExit
+//  Description :           Handlers of shell commands. argv[0] is the name of
+//                          command and number of words is already checked
+//                          against the command table.
+//  Input :                 argc -> Number of words
+//                          argv -> Words of command
+//  Output :                Negative error code if the command failed
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+//  help, man and bench parse read the command table, they are defined after it
+int CommandHelp(int argc, char *argv[]);
+int CommandMan(int argc, char *argv[]);
+void BenchmarkParse();
+
+//  Omkar's CVFS : > ls docs/re
+int CommandLs(int argc, char *argv[])
+{
+    int iRet = LsFile((argc == 1) ? NULL : argv[1]);
+
+    if(iRet >= 0)
+    {
+        return EXECUTE_SUCCESS;
+    }
+
+    if(iRet == ERR_FILE_NOT_EXIST)
+    {
+        printf("Error : There is no such directory\n");
+    }
+    else
+    {
+        PrintPathError(iRet);
+    }
+
+    return iRet;
+}
+
+//  Omkar's CVFS : > clear
+int CommandClear(int, char *[])
+{
+    #ifdef _WIN32
+        system("cls");
+    #else
+        system("clear");
+    #endif
+
+    return EXECUTE_SUCCESS;
+}
+
+//  Omkar's CVFS : > creat Ganesh.txt 3
+int CommandCreat(int, char *argv[])
+{
+    int iRet = 0;
+
+    printf("Total number of Inodes remaining : %d\n",superobj.FreeInodes);
+
+    iRet = CreateFile(argv[1],atoi(argv[2]));     // atoi is ascii to integer
+
+    if(iRet == ERR_INVALID_PARAMETER)
+    {
+        printf("Error : Unable to create the file as parameters are invalid\n");
+        printf("Please refer man page\n");
+    }
+    else if(iRet == ERR_NO_INODES)
+    {
+        printf("Error : Unable to create file as there is no inode\n");
+    }
+    else if(iRet == ERR_FILE_ALREADY_EXIST)
+    {
+        printf("Error : Unable to create file because the file is already present\n");
+    }
+    else if(iRet == ERR_MAX_FILES_OPEN)
+    {
+        printf("Error : Unable to create file\n");
+        printf("Max opened files limit reached\n");
+    }
+    else if(iRet == ERR_NO_MEMORY)
+    {
+        printf("Error : Unable to create file as there is no memory\n");
+    }
+    else if(iRet == ERR_FILE_NOT_EXIST)
+    {
+        printf("Error : Unable to create file as there is no such directory\n");
+    }
+    else if(iRet == ERR_NOT_DIRECTORY)
+    {
+        printf("Error : Unable to create file as path uses a file as directory\n");
+    }
+    else if(iRet >= 0)
+    {
+        printf("File gets successfully created with FD %d\n",iRet);
+    }
+
+    return iRet;
+}
+
+//  Omkar's CVFS : > open Ganesh.txt 1
+int CommandOpen(int, char *argv[])
+{
+    int iRet = OpenFile(argv[1],atoi(argv[2]));
+
+    if(iRet == ERR_INVALID_PARAMETER)
+    {
+        printf("Error : Unable to open the file as parameters are invalid\n");
+        printf("Please refer man page\n");
+    }
+    else if(iRet == ERR_FILE_NOT_EXIST)
+    {
+        printf("Error : Unable to open as there is no such file\n");
+    }
+    else if(iRet == ERR_PERMISSION_DENIED)
+    {
+        printf("Error : Unable to open as mode is not allowed by permission\n");
+    }
+    else if(iRet == ERR_MAX_FILES_OPEN)
+    {
+        printf("Error : Max opened files limit reached\n");
+    }
+    else if(iRet == ERR_NO_MEMORY)
+    {
+        printf("Error : Unable to open file as there is no memory\n");
+    }
+    else if(iRet == ERR_IS_DIRECTORY)
+    {
+        printf("Error : Unable to open as it is a directory\n");
+    }
+    else if(iRet == ERR_NOT_DIRECTORY)
+    {
+        printf("Error : Unable to open as path uses a file as directory\n");
+    }
+    else
+    {
+        printf("File gets successfully opened with FD %d\n",iRet);
+    }
+
+    return iRet;
+}
+
+//  Omkar's CVFS : > close 3
+int CommandClose(int, char *argv[])
+{
+    int iRet = CloseFile(atoi(argv[1]));
+
+    if(iRet == ERR_INVALID_PARAMETER)
+    {
+        printf("Error : Invalid parameter\n");
+    }
+    else if(iRet == ERR_FILE_NOT_EXIST)
+    {
+        printf("Error : There is no such file descriptor\n");
+    }
+    else
+    {
+        printf("File descriptor %s gets successfully closed\n",argv[1]);
+    }
+
+    return iRet;
+}
+
+//  Omkar's CVFS : > write 3   (data is given on the next line)
+int CommandWrite(int, char *argv[])
+{
+    static char InputBuffer[MAXINPUTSIZE];      // Data of write
+    int WriteSize = 0;                          // Bytes given to write
+    int iRet = 0;
+
+    if(shellobj.Batch == false)
+    {
+        printf("Enter the data that you want to write : \n");
+    }
+
+    // Accept data from user, scripts give it on the next line
+    if(fgets(InputBuffer,MAXINPUTSIZE,shellobj.Input) == NULL)
+    {
+        InputBuffer[0] = '\0';
+    }
+    shellobj.Line++;
+
+    // Last line of a script may not end with new line
+    WriteSize = (int)strcspn(InputBuffer,"\n");
+
+    printf("File Descriptor : %d\n",atoi(argv[1]));
+    printf("Data that we want to write : %s\n",InputBuffer);
+    printf("Number of bytes that we want to write : %d\n",WriteSize);
+
+    // Perform write operation
+    iRet = WriteFile(atoi(argv[1]), InputBuffer, WriteSize);
+
+    if(iRet == ERR_INVALID_PARAMETER)
+    {
+        printf("Error : Invalid parameters\n");
+    }
+    else if(iRet == ERR_FILE_NOT_EXIST)
+    {
+        printf("Error : There is no such file\n");
+    }
+    else if(iRet == ERR_PERMISSION_DENIED)
+    {
+        printf("Error : Unable to write as there is no permission\n");
+    }
+    else if(iRet == ERR_INSUFFICIENT_SPACE)
+    {
+        printf("Error : Unable to write as there is no space\n");
+    }
+    else
+    {
+        printf("%d bytes gets successfully wrriten\n",iRet);
+    }
+
+    return iRet;
+}
+
+//  Omkar's CVFS : > read 3 10
+int CommandRead(int, char *argv[])
+{
+    char *EmptyBuffer = NULL;               // Dynamic buffer for read operation
+    int ReadSize = atoi(argv[2]);           // Bytes requested
+    int iRet = 0;
+
+    // ReadSize + 1 must not overflow
+    if((ReadSize <= 0) || (ReadSize >= INT_MAX))
+    {
+        printf("Error : Invalid Parameter\n");
+        return ERR_INVALID_PARAMETER;
+    }
+
+    // Allocate memory for read buffer (one extra byte for '\0')
+    EmptyBuffer = (char*)CvfsAlloc(ReadSize + 1);
+
+    // Perform read operation
+    iRet = ReadFile(atoi(argv[1]), EmptyBuffer, ReadSize);
+
+    if(iRet == ERR_INVALID_PARAMETER)
+    {
+        printf("Error : Invalid Parameter\n");
+    }
+    else if(iRet == ERR_FILE_NOT_EXIST)
+    {
+        printf("Error : File not exist\n");
+    }
+    else if(iRet == ERR_PERMISSION_DENIED)
+    {
+        printf("Error : Permission denied\n");
+    }
+    else if(iRet == 0)
+    {
+        printf("Nothing to read as read offset is at end of file\n");
+    }
+    else
+    {
+        EmptyBuffer[iRet] = '\0';     // Make it proper string
+        printf("Read operation is successful\n");
+        printf("Data from file is : %s\n",EmptyBuffer);
+    }
+
+    CvfsFree(EmptyBuffer, ReadSize + 1);   // Free allocated buffer
+
+    return iRet;
+}
+
+//  Omkar's CVFS : > lseek 3 100 start
+int CommandLseek(int, char *argv[])
+{
+    static const char *Names[] = {"start", "current", "end"};
+    long long Offset = 0;
+    int Whence = -1;
+    int i = 0;
+
+    // Whence is given by name or by its number
+    for(i = START; i <= END; i++)
+    {
+        if(strcmp(argv[3], Names[i]) == 0)
+        {
+            Whence = i;
+        }
+    }
+
+    if((Whence < 0) && (argv[3][0] >= '0') && (argv[3][0] <= '9'))
+    {
+        Whence = atoi(argv[3]);
+    }
+
+    Offset = SeekFile(atoi(argv[1]), atoll(argv[2]), Whence);
+
+    if(Offset == ERR_INVALID_PARAMETER)
+    {
+        printf("Error : Invalid whence, or offset would be negative\n");
+    }
+    else if(Offset == ERR_FILE_NOT_EXIST)
+    {
+        printf("Error : There is no such file descriptor\n");
+    }
+    else if(Offset == ERR_FILE_TOO_LARGE)
+    {
+        printf("Error : Offset is beyond largest file size of %lld bytes for block size %d\n",MaxFileSize(),superobj.BlockSize);
+    }
+    else
+    {
+        printf("Offset of file descriptor %s is %lld\n",argv[1],Offset);
+        return EXECUTE_SUCCESS;
+    }
+
+    return (int)Offset;
+}
+
+//  Omkar's CVFS : > stat
+int CommandStat(int, char *[])
+{
+    StatFileSystem();
+
+    return EXECUTE_SUCCESS;
+}
+
+//  Omkar's CVFS : > unlink Demo.txt
+int CommandUnlink(int, char *argv[])
+{
+    int iRet = UnlinkFile(argv[1]);
+
+    if(iRet == ERR_INVALID_PARAMETER)
+    {
+        printf("Error : Invalid parameter\n");
+    }
+    else if(iRet == ERR_FILE_NOT_EXIST)
+    {
+        printf("Error :  Unable to delete as there is no such file\n");
+    }
+    else if(iRet == ERR_IS_DIRECTORY)
+    {
+        printf("Error : Unable to delete as it is a directory, use rmdir\n");
+    }
+    else if(iRet == ERR_NOT_DIRECTORY)
+    {
+        printf("Error : Unable to delete as path uses a file as directory\n");
+    }
+    else if(iRet == EXECUTE_SUCCESS)
+    {
+        printf("File gets successfully deleted\n");
+    }
+
+    return iRet;
+}
+
+//  Omkar's CVFS : > cp Demo.txt Backup.txt
+int CommandCp(int, char *argv[])
+{
+    int iRet = CloneFile(argv[1], argv[2]);
+
+    if(iRet == EXECUTE_SUCCESS)
+    {
+        printf("File %s gets successfully copied as %s\n",argv[1],argv[2]);
+    }
+    else if(iRet == ERR_FILE_NOT_EXIST)
+    {
+        printf("Error : Unable to copy as there is no such file or directory\n");
+    }
+    else if(iRet == ERR_IS_DIRECTORY)
+    {
+        printf("Error : Unable to copy as source is a directory\n");
+    }
+    else if(iRet == ERR_PERMISSION_DENIED)
+    {
+        printf("Error : Unable to copy as source is not readable\n");
+    }
+    else if(iRet == ERR_FILE_ALREADY_EXIST)
+    {
+        printf("Error : Unable to copy because the file is already present\n");
+    }
+    else if(iRet == ERR_NO_INODES)
+    {
+        printf("Error : Unable to copy as there is no inode\n");
+    }
+    else if(iRet == ERR_NO_MEMORY)
+    {
+        printf("Error : Unable to copy as there is no memory\n");
+    }
+    else
+    {
+        PrintPathError(iRet);
+    }
+
+    return iRet;
+}
+
+//  Omkar's CVFS : > mkdir docs
+int CommandMkdir(int, char *argv[])
+{
+    int iRet = MakeDirectory(argv[1]);
+
+    if(iRet == EXECUTE_SUCCESS)
+    {
+        printf("Directory %s gets successfully created\n",argv[1]);
+    }
+    else if(iRet == ERR_FILE_ALREADY_EXIST)
+    {
+        printf("Error : Unable to create directory as the name is already present\n");
+    }
+    else if(iRet == ERR_NO_INODES)
+    {
+        printf("Error : Unable to create directory as there is no inode\n");
+    }
+    else if(iRet == ERR_FILE_NOT_EXIST)
+    {
+        printf("Error : Unable to create directory as there is no such parent\n");
+    }
+    else
+    {
+        PrintPathError(iRet);
+    }
+
+    return iRet;
+}
+
+//  Omkar's CVFS : > rmdir docs
+int CommandRmdir(int, char *argv[])
+{
+    int iRet = RemoveDirectory(argv[1]);
+
+    if(iRet == EXECUTE_SUCCESS)
+    {
+        printf("Directory %s gets successfully removed\n",argv[1]);
+    }
+    else if(iRet == ERR_DIRECTORY_NOT_EMPTY)
+    {
+        printf("Error : Unable to remove as directory is not empty\n");
+    }
+    else if(iRet == ERR_DIRECTORY_BUSY)
+    {
+        printf("Error : Unable to remove as a session works in the directory\n");
+    }
+    else if(iRet == ERR_FILE_NOT_EXIST)
+    {
+        printf("Error : Unable to remove as there is no such directory\n");
+    }
+    else
+    {
+        PrintPathError(iRet);
+    }
+
+    return iRet;
+}
+
+//  Omkar's CVFS : > cd docs/2026
+int CommandCd(int argc, char *argv[])
+{
+    int iRet = ChangeDirectory((argc == 1) ? "/" : argv[1]);
+
+    if(iRet == ERR_FILE_NOT_EXIST)
+    {
+        printf("Error : There is no such directory\n");
+    }
+    else if(iRet != EXECUTE_SUCCESS)
+    {
+        PrintPathError(iRet);
+    }
+
+    return iRet;
+}
+
+//  Omkar's CVFS : > pwd
+int CommandPwd(int, char *[])
+{
+    static char Path[MAXINPUTSIZE];     // Working directory
+    int iRet = GetWorkingDirectory(Path, sizeof(Path));
+
+    if(iRet < 0)
+    {
+        printf("Error : Path of working directory is too long\n");
+        return iRet;
+    }
+
+    printf("%s\n",Path);
+
+    return EXECUTE_SUCCESS;
+}
+
+//  Omkar's CVFS : > mount cvfs.img
+int CommandMount(int, char *argv[])
+{
+    int iRet = MountImage(argv[1]);
+
+    if(iRet == EXECUTE_SUCCESS)
+    {
+        printf("Image %s gets successfully mounted\n",ImagePath);
+    }
+    else
+    {
+        PrintImageError(iRet);
+    }
+
+    return iRet;
+}
+
+//  Omkar's CVFS : > sync
+int CommandSync(int, char *[])
+{
+    int iRet = SyncImage();
+
+    if(iRet == ERR_NOT_MOUNTED)
+    {
+        printf("Error : There is no mounted image\n");
+    }
+    else if(iRet == ERR_IMAGE_IO)
+    {
+        printf("Error : Unable to write the image\n");
+    }
+    else
+    {
+        printf("Image %s gets successfully synced\n",ImagePath);
+    }
+
+    return iRet;
+}
+
+//  Omkar's CVFS : > journal
+//  Omkar's CVFS : > journal group 64
+//  Omkar's CVFS : > journal data on
+int CommandJournal(int argc, char *argv[])
+{
+    if(argc == 1)
+    {
+        DisplayJournal();
+    }
+    else if((argc == 3) && (strcmp("group",argv[1]) == 0) && (atoi(argv[2]) > 0))
+    {
+        //  Pending operations are made durable with the old group size
+        JournalFlush();
+        journalobj.GroupSize = atoi(argv[2]);
+        printf("Journal group size is %d\n",journalobj.GroupSize);
+    }
+    else if((argc == 3) && (strcmp("data",argv[1]) == 0) &&
+            ((strcmp("on",argv[2]) == 0) || (strcmp("off",argv[2]) == 0)))
+    {
+        JournalFlush();
+        journalobj.DataJournal = (strcmp("on",argv[2]) == 0);
+        printf("Data journaling is %s\n",argv[2]);
+    }
+    else
+    {
+        printf("Error : Invalid parameters\n");
+        printf("Please refer man page\n");
+        return ERR_INVALID_PARAMETER;
+    }
+
+    return EXECUTE_SUCCESS;
+}
+
+//  Omkar's CVFS : > ps
+int CommandPs(int, char *[])
+{
+    DisplaySessions();
+
+    return EXECUTE_SUCCESS;
+}
+
+//  Omkar's CVFS : > login worker
+int CommandLogin(int, char *argv[])
+{
+    PUAREA uarea = CreateSession(argv[1]);
+
+    if(uarea == NULL)
+    {
+        printf("Error : Unable to create session as there is no memory\n");
+        return ERR_NO_MEMORY;
+    }
+
+    SwitchSession(uarea);
+    printf("Session %d gets successfully created\n",uarea->SessionId);
+
+    return EXECUTE_SUCCESS;
+}
+
+//  Omkar's CVFS : > session 2
+int CommandSession(int, char *argv[])
+{
+    PUAREA uarea = SessionOf(atoi(argv[1]));
+
+    if(uarea == NULL)
+    {
+        printf("Error : There is no such session\n");
+        return ERR_INVALID_PARAMETER;
+    }
+
+    SwitchSession(uarea);
+    printf("Current session is %d (%s)\n",uarea->SessionId,uarea->ProcessName);
+
+    return EXECUTE_SUCCESS;
+}
+
+//  Omkar's CVFS : > fork
+int CommandFork(int, char *[])
+{
+    PUAREA child = ForkSession(CurrentUArea);
+
+    if(child == NULL)
+    {
+        printf("Error : Unable to fork as there is no memory\n");
+        return ERR_NO_MEMORY;
+    }
+
+    printf("Session %d gets successfully forked as session %d\n",CurrentUArea->SessionId,child->SessionId);
+
+    return EXECUTE_SUCCESS;
+}
+
+//  Omkar's CVFS : > kill 2
+int CommandKill(int, char *argv[])
+{
+    int iRet = DestroySession(SessionOf(atoi(argv[1])));
+
+    if(iRet == EXECUTE_SUCCESS)
+    {
+        printf("Session %s gets successfully ended\n",argv[1]);
+    }
+    else
+    {
+        printf("Error : Unable to end session %s\n",argv[1]);
+    }
+
+    return iRet;
+}
+
+//  Omkar's CVFS : > dup 3
+int CommandDup(int, char *argv[])
+{
+    int iRet = DupFile(atoi(argv[1]));
+
+    if(iRet == ERR_INVALID_PARAMETER)
+    {
+        printf("Error : Invalid parameter\n");
+    }
+    else if(iRet == ERR_FILE_NOT_EXIST)
+    {
+        printf("Error : There is no such file\n");
+    }
+    else if(iRet == ERR_MAX_FILES_OPEN)
+    {
+        printf("Error : Max opened files limit reached\n");
+    }
+    else
+    {
+        printf("File descriptor %s gets successfully duplicated as %d\n",argv[1],iRet);
+    }
+
+    return iRet;
+}
+
+//  Omkar's CVFS : > check
+int CommandCheck(int, char *[])
+{
+    int iRet = CheckFileSystem();
+
+    if(iRet == ERR_NO_MEMORY)
+    {
+        printf("Error : Unable to check as there is no memory\n");
+    }
+    else if(iRet == 0)
+    {
+        printf("File system is consistent\n");
+    }
+    else
+    {
+        printf("File system has %d errors\n",iRet);
+    }
+
+    return iRet;
+}
+
+//  Omkar's CVFS : > snapshot before_upgrade
+int CommandSnapshot(int argc, char *argv[])
+{
+    SNAPSHOTINFO Entries[MAXSNAPSHOTS];
+    int iRet = 0;
+    int i = 0;
+
+    //  Without name the snapshots are listed
+    if(argc == 1)
+    {
+        iRet = ListSnapshots(Entries, MAXSNAPSHOTS);
+
+        for(i = 0; i < iRet; i++)
+        {
+            printf("%-20s %d files, %lld bytes of metadata\n",Entries[i].Name,Entries[i].Files,Entries[i].Bytes);
+        }
+
+        return EXECUTE_SUCCESS;
+    }
+
+    iRet = CreateSnapshot(argv[1]);
+
+    if(iRet == EXECUTE_SUCCESS)
+    {
+        printf("Snapshot %s gets successfully created\n",argv[1]);
+    }
+    else if(iRet == ERR_INVALID_PARAMETER)
+    {
+        printf("Error : Name of snapshot must have 1 to %d characters\n",MAXFILENAME - 1);
+    }
+    else if(iRet == ERR_FILE_ALREADY_EXIST)
+    {
+        printf("Error : Snapshot with this name is already present\n");
+    }
+    else if(iRet == ERR_NO_SNAPSHOTS)
+    {
+        printf("Error : Unable to create as %d snapshots are present\n",MAXSNAPSHOTS);
+    }
+    else if(iRet == ERR_INSUFFICIENT_SPACE)
+    {
+        printf("Error : Unable to create as there is no space for its inode table\n");
+    }
+    else
+    {
+        printf("Error : Unable to create snapshot (error %d)\n",iRet);
+    }
+
+    return iRet;
+}
+
+//  Omkar's CVFS : > rollback before_upgrade
+int CommandRollback(int, char *argv[])
+{
+    int iRet = RollbackSnapshot(argv[1]);
+
+    if(iRet == EXECUTE_SUCCESS)
+    {
+        printf("File system gets successfully rolled back to %s\n",argv[1]);
+    }
+    else if(iRet == ERR_FILE_NOT_EXIST)
+    {
+        printf("Error : There is no such snapshot\n");
+    }
+    else if(iRet == ERR_FILE_BUSY)
+    {
+        printf("Error : Unable to roll back as files are open or directories are in use\n");
+    }
+    else if(iRet == ERR_NO_MEMORY)
+    {
+        printf("Error : Unable to roll back as there is no memory\n");
+    }
+    else
+    {
+        printf("Error : Unable to roll back (error %d)\n",iRet);
+    }
+
+    return iRet;
+}
+
+//  Omkar's CVFS : > snapdel before_upgrade
+int CommandSnapdel(int, char *argv[])
+{
+    int iRet = DeleteSnapshot(argv[1]);
+
+    if(iRet == EXECUTE_SUCCESS)
+    {
+        printf("Snapshot %s gets successfully deleted\n",argv[1]);
+    }
+    else if(iRet == ERR_FILE_NOT_EXIST)
+    {
+        printf("Error : There is no such snapshot\n");
+    }
+    else
+    {
+        printf("Error : Unable to delete snapshot (error %d)\n",iRet);
+    }
+
+    return iRet;
+}
+
+//  Omkar's CVFS : > snapread before_upgrade docs/a.txt 10
+int CommandSnapread(int, char *argv[])
+{
+    char *EmptyBuffer = NULL;               // Dynamic buffer for read operation
+    int ReadSize = atoi(argv[3]);           // Bytes requested
+    int iRet = 0;
+
+    // ReadSize + 1 must not overflow
+    if((ReadSize <= 0) || (ReadSize >= INT_MAX))
+    {
+        printf("Error : Invalid Parameter\n");
+        return ERR_INVALID_PARAMETER;
+    }
+
+    EmptyBuffer = (char*)CvfsAlloc(ReadSize + 1);
+
+    iRet = ReadSnapshotFile(argv[1], argv[2], EmptyBuffer, ReadSize, 0);
+
+    if(iRet == ERR_INVALID_PARAMETER)
+    {
+        printf("Error : Invalid Parameter\n");
+    }
+    else if(iRet == ERR_FILE_NOT_EXIST)
+    {
+        printf("Error : There is no such snapshot or file in it\n");
+    }
+    else if(iRet == ERR_IS_DIRECTORY)
+    {
+        printf("Error : Unable to read as it is a directory\n");
+    }
+    else if(iRet < 0)
+    {
+        PrintPathError(iRet);
+    }
+    else
+    {
+        EmptyBuffer[iRet] = '\0';     // Make it proper string
+        printf("Data from %s of snapshot %s is : %s\n",argv[2],argv[1],EmptyBuffer);
+    }
+
+    CvfsFree(EmptyBuffer, ReadSize + 1);
+
+    return iRet;
+}
+
+//  Omkar's CVFS : > bench lookup
+int CommandBench(int, char *argv[])
+{
+    if(strcmp("lookup",argv[1]) == 0)
+    {
+        printf("Files\tScan ns/op\tIndex ns/op\tVerified\n");
+
+        BenchmarkNameLookup(1000);
+        BenchmarkNameLookup(100000);
+        BenchmarkNameLookup(1000000);
+    }
+    else if(strcmp("threads",argv[1]) == 0)
+    {
+        BenchmarkThreads();
+    }
+    else if(strcmp("io",argv[1]) == 0)
+    {
+        BenchmarkBatchIo();
+    }
+    else if(strcmp("async",argv[1]) == 0)
+    {
+        BenchmarkAsync();
+    }
+    else if(strcmp("fd",argv[1]) == 0)
+    {
+        printf("Held\tns/pair\t\tUFDT size\tVerified\n");
+
+        BenchmarkDescriptors(10);
+        BenchmarkDescriptors(1000);
+        BenchmarkDescriptors(100000);
+    }
+    else if(strcmp("parse",argv[1]) == 0)
+    {
+        BenchmarkParse();
+    }
+    else
+    {
+        printf("Error : There is no benchmark %s\n",argv[1]);
+        printf("Please refer man page\n");
+        return ERR_INVALID_PARAMETER;
+    }
+
+    return EXECUTE_SUCCESS;
+}
+
+//  Omkar's CVFS : > perf
+//  Omkar's CVFS : > perf reset
+int CommandPerf(int argc, char *argv[])
+{
+    if(argc == 1)
+    {
+        DisplayPerf();
+    }
+    else if(strcmp("reset",argv[1]) == 0)
+    {
+        ResetPerfCounters();
+        printf("Perf counters are reset\n");
+    }
+    else
+    {
+        printf("Error : Invalid parameters\n");
+        printf("Please refer man page\n");
+        return ERR_INVALID_PARAMETER;
+    }
+
+    return EXECUTE_SUCCESS;
+}
+
+//  Omkar's CVFS : > exit
+int CommandExit(int, char *[])
+{
+    if(shellobj.Batch == false)
+    {
+        printf("Thank you for using Omkar's CVFS\n");
+        printf("Deallocating all the allocated resources\n");
+    }
+
+    shellobj.Exit = true;
+
+    return EXECUTE_SUCCESS;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Command table of the shell, in the order shown by help
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+constexpr SHELLCOMMAND CommandTable[] =
+{
+    {"man", 1, 1, CommandMan,
+        "It is used to display manual page",
+        "It is used to Display manual page",
+        "man command_name",
+        "command_name\tIt is the name of command"},
+    {"ls", 0, 1, CommandLs,
+        "List all files with details",
+        "It is used to list the files of a directory sorted by name",
+        "ls\n"
+        "ls prefix",
+        "prefix\tOnly names starting with it are listed. Part up to last /\n"
+        "is the directory listed, otherwise working directory is listed"},
+    {"clear", 0, 0, CommandClear,
+        "It is used to clear the terminal",
+        "It is used to clear the shell",
+        "clear",
+        ""},
+    {"creat", 2, 2, CommandCreat,
+        "It is used to create new file",
+        "It is used to create the new file and open it for read and write",
+        "creat file_name permission",
+        "file_name\tName of file, quoted if it contains blanks\n"
+        "permission\t1(Read), 2(Write), 3(Read+Write)"},
+    {"open", 2, 2, CommandOpen,
+        "It is used to open existing file",
+        "It is used to open existing file and get lowest free descriptor\n"
+        "Every open has its own read and write offsets",
+        "open file_name mode",
+        "mode\t1(Read), 2(Write), 3(Read+Write), allowed by permission of file"},
+    {"close", 1, 1, CommandClose,
+        "It is used to close a file descriptor",
+        "It is used to close a file descriptor\n"
+        "Descriptor becomes free for next open, creat or dup",
+        "close fd",
+        ""},
+    {"write", 1, 1, CommandWrite,
+        "It is used to write the data into file",
+        "It is used to write data at write offset of an open file\n"
+        "Data is entered on the next line",
+        "write fd",
+        ""},
+    {"read", 2, 2, CommandRead,
+        "It is used to read the data from the file",
+        "It is used to read data from read offset of an open file",
+        "read fd count",
+        "count\tNumber of bytes to read"},
+    {"lseek", 3, 3, CommandLseek,
+        "It is used to move the offset of a file",
+        "It is used to move read and write offsets of an open file\n"
+        "Offset may go beyond end of file, the gap reads as zeros\n"
+        "and takes no data blocks until it is written\n"
+        "Largest offset is set by block size, 1 GB with 512 byte blocks",
+        "lseek fd offset whence",
+        "offset\tBytes to move, may be negative\n"
+        "whence\tstart, current or end (or 0, 1, 2)"},
+    {"stat", 0, 0, CommandStat,
+        "It is used to display statistical information",
+        "It is used to display occupancy and fragmentation of inodes",
+        "stat",
+        ""},
+    {"unlink", 1, 1, CommandUnlink,
+        "It is used to delete the file",
+        "It is used to delete the file\n"
+        "Open descriptors can use the file until they are released",
+        "unlink file_name",
+        ""},
+    {"cp", 2, 2, CommandCp,
+        "It is used to copy a file",
+        "It is used to copy a file without copying its data\n"
+        "Both files share data blocks until one of them is written",
+        "cp source_path new_path",
+        ""},
+    {"mkdir", 1, 1, CommandMkdir,
+        "It is used to create a directory",
+        "It is used to create an empty directory",
+        "mkdir path",
+        "path\tNames separated by /, starting from root if it starts with /\n"
+        "otherwise from working directory. Every name has at most 19 characters"},
+    {"rmdir", 1, 1, CommandRmdir,
+        "It is used to remove an empty directory",
+        "It is used to remove an empty directory\n"
+        "Working directory of a session can not be removed",
+        "rmdir path",
+        ""},
+    {"cd", 0, 1, CommandCd,
+        "It is used to change working directory",
+        "It is used to change working directory of current session\n"
+        "Relative paths of creat, open, unlink and ls start from it",
+        "cd\n"
+        "cd path",
+        "path\t. is working directory and .. its parent, without path root is used"},
+    {"pwd", 0, 0, CommandPwd,
+        "It is used to display working directory",
+        "It is used to display path of working directory of current session",
+        "pwd",
+        ""},
+    {"mount", 1, 1, CommandMount,
+        "It is used to mount (or save into) a disk image",
+        "It is used to mount CVFS image stored in a host file\n"
+        "If the file does not exist, current file system is saved into it",
+        "mount image_path",
+        ""},
+    {"sync", 0, 0, CommandSync,
+        "It is used to flush the mounted disk image",
+        "It is used to write all changes into the mounted image\n"
+        "Journal is flushed and checkpointed into the image",
+        "sync",
+        ""},
+    {"journal", 0, 2, CommandJournal,
+        "It is used to display or tune the journal",
+        "It is used to display or tune the journal of mounted image",
+        "journal\n"
+        "journal group count\n"
+        "journal data on|off",
+        "group\tNumber of operations made durable by one fsync\n"
+        "1 makes every operation durable before it returns\n"
+        "data\ton journals file data too, off writes data before metadata"},
+    {"ps", 0, 0, CommandPs,
+        "It is used to list the sessions",
+        "It is used to list sessions with their open descriptors\n"
+        "Current session is marked with *",
+        "ps",
+        ""},
+    {"login", 1, 1, CommandLogin,
+        "It is used to start a new session",
+        "It is used to start a new session with no open files\n"
+        "and make it the current session",
+        "login process_name",
+        ""},
+    {"session", 1, 1, CommandSession,
+        "It is used to switch to another session",
+        "It is used to make another session the current session\n"
+        "Descriptors are looked up in the current session",
+        "session session_number",
+        ""},
+    {"fork", 0, 0, CommandFork,
+        "It is used to copy current session with its descriptors",
+        "It is used to create a child of current session\n"
+        "Child gets copies of every descriptor and shares offsets",
+        "fork",
+        ""},
+    {"kill", 1, 1, CommandKill,
+        "It is used to end a session and release its descriptors",
+        "It is used to end a session and release its descriptors\n"
+        "Session 1 and current session can not be ended",
+        "kill session_number",
+        ""},
+    {"dup", 1, 1, CommandDup,
+        "It is used to duplicate a file descriptor",
+        "It is used to create a second descriptor of an open file\n"
+        "Both descriptors share read and write offsets",
+        "dup fd",
+        ""},
+    {"check", 0, 0, CommandCheck,
+        "It is used to verify consistency of file system",
+        "It is used to verify that inode, name and block tables agree",
+        "check",
+        ""},
+    {"snapshot", 0, 1, CommandSnapshot,
+        "It is used to create or list snapshots",
+        "It is used to freeze the file system under a name\n"
+        "Only inodes are copied, data blocks are shared until they change",
+        "snapshot\n"
+        "snapshot name",
+        "name\tName of new snapshot, without it snapshots are listed"},
+    {"rollback", 1, 1, CommandRollback,
+        "It is used to return to a snapshot",
+        "It is used to bring every file back to its state in a snapshot\n"
+        "No file may be open and no session may work in a directory",
+        "rollback name",
+        ""},
+    {"snapdel", 1, 1, CommandSnapdel,
+        "It is used to delete a snapshot",
+        "It is used to delete a snapshot, blocks only it refers become free",
+        "snapdel name",
+        ""},
+    {"snapread", 3, 3, CommandSnapread,
+        "It is used to read a file of a snapshot",
+        "It is used to read a file as it was when snapshot was taken",
+        "snapread name path count",
+        "path\tPath of file from root of snapshot\n"
+        "count\tNumber of bytes to read from start of file"},
+    {"bench", 1, 1, CommandBench,
+        "It is used to run performance benchmarks",
+        "It is used to run performance benchmarks",
+        "bench lookup\n"
+        "bench threads\n"
+        "bench fd\n"
+        "bench io\n"
+        "bench async\n"
+        "bench parse",
+        "lookup\tCompares DILB scan with name index for 10^3, 10^5, 10^6 files\n"
+        "fd\tCloses and opens descriptors while 10, 10^3, 10^5 are held\n"
+        "io\tCompares single calls, readv/writev and submission ring for small I/O\n"
+        "threads\tReads and writes from 1 to 16 threads, needs free inodes and descriptors\n"
+        "async\tKeeps 4096 coroutines of co_write / co_read in flight on the executor\n"
+        "parse\tCompares sscanf and strcmp chain with tokenizer and command table"},
+    {"perf", 0, 1, CommandPerf,
+        "It is used to display operation counters and latencies",
+        "It is used to display calls and latency of every operation\n"
+        "since start (of all threads and sessions)",
+        "perf\n"
+        "perf reset\n"
+        "One call in 16 of every thread is timed for latencies",
+        "p50 p99\tLatency below which half and 99% of calls ended, to a power of 2\n"
+        "reset\tSets all counters to zero"},
+    {"help", 0, 0, CommandHelp,
+        "It is used to display this help page",
+        "It is used to display all commands with their purpose",
+        "help",
+        ""},
+    {"exit", 0, 0, CommandExit,
+        "It is use to terminate Omkar's CVFS",
+        "It is used to terminate the shell",
+        "exit",
+        ""},
+};
+
+#define NCOMMANDS (int)(sizeof(CommandTable) / sizeof(CommandTable[0]))
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Structure Name :            CommandSlots
+//  Description  :              Perfect hash of command names. Slot
+//                              CommandHash(name, Seed) % MAXCOMMANDSLOTS holds
+//                              1 + index of the command in CommandTable,
+//                              0 if no command hashes to it.
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+struct CommandSlots
+{
+    unsigned int Seed;                  // First seed without collision
+    signed char Index[MAXCOMMANDSLOTS];    // 1 + index into CommandTable
+};
+
+typedef struct CommandSlots COMMANDSLOTS;
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         BuildCommandSlots
+//  Description :           Tries seeds until every command name gets its own
+//                          slot. It runs inside the compiler, so adding a
+//                          command never needs a hand made hash.
+//  Output :                Slots with chosen seed, Seed 0 with empty slots
+//                          if no seed works
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+constexpr COMMANDSLOTS BuildCommandSlots()
+{
+    COMMANDSLOTS Slots = {};
+    unsigned int Seed = 0;
+    unsigned int Slot = 0;
+    int i = 0;
+
+    for(Seed = 1; Seed <= MAXCOMMANDSEED; Seed++)
+    {
+        Slots = {};
+        Slots.Seed = Seed;
+
+        for(i = 0; i < NCOMMANDS; i++)
+        {
+            Slot = CommandHash(CommandTable[i].Name, Seed) % MAXCOMMANDSLOTS;
+
+            if(Slots.Index[Slot] != 0)
+            {
+                break;
+            }
+
+            Slots.Index[Slot] = (signed char)(i + 1);
+        }
+
+        if(i == NCOMMANDS)
+        {
+            return Slots;
+        }
+    }
+
+    return COMMANDSLOTS {};
+}
+
+constexpr COMMANDSLOTS Slotsobj = BuildCommandSlots();
+
+static_assert(NCOMMANDS < MAXCOMMANDSLOTS, "MAXCOMMANDSLOTS must be larger than number of commands");
+static_assert(Slotsobj.Seed != 0, "No perfect hash seed found, increase MAXCOMMANDSLOTS");
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         FindCommand
+//  Description :           Looks up command by name with one hash and at most
+//                          one string compare.
+//  Input :                 Name -> Command name
+//  Output :                Address of command, NULL if there is no such command
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+const SHELLCOMMAND * FindCommand(
+                                    const char *Name
+                                )
+{
+    int Index = Slotsobj.Index[CommandHash(Name, Slotsobj.Seed) % MAXCOMMANDSLOTS];
+
+    if((Index == 0) || (strcmp(CommandTable[Index - 1].Name, Name) != 0))
+    {
+        return NULL;
+    }
+
+    return &CommandTable[Index - 1];
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         PrintManField
+//  Description :           Prints lines of About, Usage or Details in columns
+//                          of man page. "name\ttext" is printed with name as
+//                          label, first other line with given label and the
+//                          remaining lines below the previous one.
+//  Input :                 Label -> Label of first line, NULL for none
+//                          Text  -> Lines separated by '\n'
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+void PrintManField(
+                    const char *Label,
+                    const char *Text
+                )
+{
+    const char *Line = Text;
+    const char *End = NULL;
+    const char *Tab = NULL;
+
+    while(*Line != '\0')
+    {
+        End = strchr(Line, '\n');
+
+        if(End == NULL)
+        {
+            End = Line + strlen(Line);
+        }
+
+        Tab = (const char *)memchr(Line, '\t', End - Line);
+
+        if(Tab != NULL)
+        {
+            printf("%-13.*s: %.*s\n", (int)(Tab - Line), Line, (int)(End - Tab - 1), Tab + 1);
+        }
+        else if((Line == Text) && (Label != NULL))
+        {
+            printf("%-13s: %.*s\n", Label, (int)(End - Line), Line);
+        }
+        else
+        {
+            printf("               %.*s\n", (int)(End - Line), Line);
+        }
+
+        Line = (*End == '\0') ? End : End + 1;
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         DisplayHelp
+//  Description :           Displays a help menu showing all supported shell
+//                          commands and their basic purpose so that the user
+//                          can understand how to use the CVFS shell. Lines
+//                          come from the command table.
+//  Output :                List of commands like ls, creat, read, write, unlink,
+//                          exit, etc.
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  14/01/2026
 //
 //////////////////////////////////////////////////////////////////////////////////
 
-int WriteFile(
-                    int fd,
-                    char *data,
-                    int size
-            )
+void DisplayHelp()
 {
-    printf("File Descriptor : %d\n",fd);
-    printf("Data that we want to write : %s\n",data);
-    printf("Number of bytes that we want to write : %d\n",size);
+    int i = 0;
 
-    //  Invalid FD
-    if(fd < 0 || fd > MAXOPENFILES)
-    {
-        return ERR_INVALID_PARAMETER;
-    }
+    printf("--------------------------------------------------------------------\n");
+    printf("---------------------Omkar's CVFS Help Page----------------------\n");
+    printf("--------------------------------------------------------------------\n");
+    printf("\n");
 
-    //  FD points to NULL
-    if(uareaobj.UFDT[fd] == NULL)
+    for(i = 0; i < NCOMMANDS; i++)
     {
-        return ERR_FILE_NOT_EXIST;
+        printf("%-8s: %s\n", CommandTable[i].Name, CommandTable[i].Help);
     }
 
-    //  There is no permission to write
-    if(uareaobj.UFDT[fd]->ptrinode->Permission < WRITE)
-    {
-        return ERR_PERMISSION_DENIED;
-    }
+    printf("\n");
+    printf("--------------------------------------------------------------------\n");
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         ManPageDisplay
+//  Description :           This function displays detailed manual
+//                          information of a specific command similar to
+//                          the Linux 'man' command. Page comes from the
+//                          command table.
+//  Input :                 Name of the command whose manual is required.
+//  Output :                ERR_INVALID_PARAMETER if there is no such command
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  14/01/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
 
-    //  Insufficient space
-    if((MAXFILESIZE - uareaobj.UFDT[fd]->WriteOffset) < size)
+int ManPageDisplay(
+                    const char *Name
+                )
+{
+    const SHELLCOMMAND *Cmd = FindCommand(Name);
+
+    if(Cmd == NULL)
     {
-        return ERR_INSUFFICIENT_SPACE;
+        printf("No manual entry for %s\n",Name);
+        return ERR_INVALID_PARAMETER;
     }
 
-    //  Write the data into the file
-    strncpy(uareaobj.UFDT[fd]->ptrinode->Buffer + uareaobj.UFDT[fd]->WriteOffset, data, size);
+    PrintManField("About", Cmd->About);
+    PrintManField("Usage", Cmd->Usage);
+    PrintManField(NULL, Cmd->Details);
+
+    return EXECUTE_SUCCESS;
+}
 
-    //  Update the write offset
-    uareaobj.UFDT[fd]->WriteOffset = uareaobj.UFDT[fd]->WriteOffset + size;
+//  Omkar's CVFS : > help
+int CommandHelp(int, char *[])
+{
+    DisplayHelp();
 
-    // Update the actual file size
-    uareaobj.UFDT[fd]->ptrinode->ActualFileSize = uareaobj.UFDT[fd]->ptrinode->ActualFileSize + size;
+    return EXECUTE_SUCCESS;
+}
 
-    return size;
+//  Omkar's CVFS : > man ls
+int CommandMan(int, char *argv[])
+{
+    return ManPageDisplay(argv[1]);
 }
 
 //////////////////////////////////////////////////////////////////////////////////
 //
-//  Function Name :         ReadFile()
-//  Description :           This function reads data from the file associated
-//                          with the given file descriptor into user buffer.
-//  Checks :                Valid FD, read permission and available data.
-//  Effect :                Copies data from file buffer to user buffer and
-//                          updates read offset.
-//  Input :                 fd   -> File descriptor
-//                          data -> Destination buffer (Address of empty Buffer)
-//                          size -> Number of bytes to read
-//  Output :                Number of bytes successfully read or error code
+//  Function Name :         RunCommand
+//  Description :           Looks up first word in command table, checks
+//                          number of words and runs the handler.
+//  Input :                 argc -> Number of words, at least 1
+//                          argv -> Words from TokenizeCommand()
+//  Output :                Value returned by handler, ERR_INVALID_PARAMETER
+//                          for unknown command or wrong number of words
 //  Author :                Omkar Sachin Naralwar
-//  Date :                  22/01/2026
+//  Date :                  16/10/2026
 //
 //////////////////////////////////////////////////////////////////////////////////
 
-int ReadFile(
-                int fd,
-                char *data,
-                int size
+int RunCommand(
+                int argc,
+                char *argv[]
             )
 {
-    //  Invalid FD
-    if(fd < 0 || fd >MAXOPENFILES)
+    const SHELLCOMMAND *Cmd = FindCommand(argv[0]);
+
+    if(Cmd == NULL)
     {
+        printf("Command not Found\n");
+        printf("Please refer help option to get more information\n");
         return ERR_INVALID_PARAMETER;
     }
-      
-    if(data == NULL)
+
+    if((argc - 1 < Cmd->MinArgs) || (argc - 1 > Cmd->MaxArgs))
     {
+        printf("Error : Wrong number of parameters\n");
+        PrintManField("Usage", Cmd->Usage);
         return ERR_INVALID_PARAMETER;
     }
 
-    if(size <= 0)
+    return Cmd->Handler(argc, argv);
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         BenchmarkParse
+//  Description :           Compares the old way of reading a command, sscanf
+//                          into fixed words and a strcmp over every name,
+//                          with TokenizeCommand() and FindCommand() on the
+//                          same lines. Handlers are not run.
+//  Output :                Average nanoseconds per line for both methods
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+void BenchmarkParse()
+{
+    const char *Lines[] =
     {
-        return ERR_INVALID_PARAMETER;
-    }
+        "creat Demo.txt 3", "write 3", "read 3 10", "open Demo.txt 1",
+        "close 3", "unlink Demo.txt", "ls", "stat",
+        "journal group 64", "perf reset", "man open", "exit",
+    };
+    const int NLines = (int)(sizeof(Lines) / sizeof(Lines[0]));
+    int Lengths[sizeof(Lines) / sizeof(Lines[0])];
+
+    char Line[MAXINPUTSIZE];
+    char Command[5][20];
+    char *Args[MAXARGS];
+    long long Start = 0;
+    long long OldTime = 0;
+    long long NewTime = 0;
+    long long OldSum = 0;
+    long long NewSum = 0;
+    int i = 0;
+    int j = 0;
+    int n = 0;
 
-    //  File not found
-    if(uareaobj.UFDT[fd] == NULL)
+    for(i = 0; i < NLines; i++)
     {
-        return ERR_FILE_NOT_EXIST;
+        Lengths[i] = (int)strlen(Lines[i]) + 1;
     }
 
-    //  Filter for permission
-    if(uareaobj.UFDT[fd]->ptrinode->Permission < READ)
+    //  Both methods copy the line first, as fgets does
+    Start = GetTimeNs();
+
+    for(i = 0; i < BENCHPARSEOPS; i++)
     {
-        return ERR_PERMISSION_DENIED;
+        memcpy(Line, Lines[i % NLines], Lengths[i % NLines]);
+
+        n = sscanf(Line,"%19s %19s %19s %19s %19s",Command[0],Command[1],Command[2],Command[3],Command[4]);
+
+        for(j = 0; j < NCOMMANDS; j++)
+        {
+            if(strcmp(CommandTable[j].Name, Command[0]) == 0)
+            {
+                break;
+            }
+        }
+
+        OldSum = OldSum + j + n;
     }
 
-    //  Insufficient data
-    if((MAXFILESIZE - uareaobj.UFDT[fd]->ReadOffset) < size)
+    OldTime = GetTimeNs() - Start;
+
+    Start = GetTimeNs();
+
+    for(i = 0; i < BENCHPARSEOPS; i++)
     {
-        return ERR_INSUFFICIENT_DATA;
-    }
+        memcpy(Line, Lines[i % NLines], Lengths[i % NLines]);
+
+        n = TokenizeCommand(Line, Args, MAXARGS);
 
-    //  Read the data
-    strncpy(data, uareaobj.UFDT[fd]->ptrinode->Buffer + uareaobj.UFDT[fd]->ReadOffset, size);
+        NewSum = NewSum + (FindCommand(Args[0]) - CommandTable) + n;
+    }
 
-    //  Update the read offset
-    uareaobj.UFDT[fd]->ReadOffset = uareaobj.UFDT[fd]->ReadOffset + size;
+    NewTime = GetTimeNs() - Start;
 
-    return size;
+    printf("Method\t\t\tns/line\tlines/s\n");
+    printf("sscanf + strcmp\t\t%.1f\t%.0f\n",(double)OldTime / BENCHPARSEOPS,BENCHPARSEOPS * 1000000000.0 / OldTime);
+    printf("tokenizer + table\t%.1f\t%.0f\n",(double)NewTime / BENCHPARSEOPS,BENCHPARSEOPS * 1000000000.0 / NewTime);
+    printf("Verified : %d\n",(OldSum == NewSum));
 }
 
 //////////////////////////////////////////////////////////////////////////////////
@@ -788,262 +2810,318 @@ int ReadFile(
 //                          accepts user commands to perform file
 //                          operations like create, read, write, delete,
 //                          list files etc.
-//  Working :               - Initialises auxiliary data
-//                          - Displays startup banner
-//                          - Runs infinite command processing loop
+//  Usage :                 CVFS [-i inode_count] [-b block_size] [-n block_count]
+//                               [-l inline_bytes] [-D] [-Z] [-H] [-m image_path]
+//                               [--batch file] [-k] [-q | -v]
+//  Working :               - Parses command line options
+//                          - Initialises auxiliary data
+//                          - Displays startup banner (not in batch mode)
+//                          - Runs command processing loop
 //                          - Parses and executes user commands
-//                          - Terminates only when user enters 'exit'
+//                          - Terminates when user enters 'exit' or input ends,
+//                            or in batch mode when a command fails (without -k)
+//  Output :                0 on success, 1 if a batch command failed
 //  Author :                Omkar Sachin Naralwar
 //  Date :                  22/01/2026
 //
 //////////////////////////////////////////////////////////////////////////////////
 
-int main()
+int main(int argc, char *argv[])
 {
-    char str[80] = {'\0'};                 // Stores complete command entered by user
-    char Command[5][20] = {{'\0'}};        // Stores separated words of command
-    char InputBuffer[MAXFILESIZE] = {'\0'};// Buffer used for write operation
-
-    char *EmptyBuffer = NULL;              // Dynamic buffer for read operation
+    char str[MAXINPUTSIZE] = {'\0'};       // Stores complete command entered by user
+    char *Args[MAXARGS] = {NULL};          // Words of command inside str
 
     int iCount = 0;                        // Number of words entered in command
     int iRet = 0;                          // Stores return value of functions
+    int iOption = 0;                       // Command line option
+    int InodeCount = MAXINODE;             // Number of inodes in DILB
+    int BlockSize = BLOCKSIZE;             // Bytes in one data block
+    int BlockCount = MAXBLOCKS;            // Number of data blocks in pool
+    int i = 0;
+    bool HugePages = false;                // Back arena with huge pages
+    char *MountPath = NULL;                // Image mounted at startup
+    int InlineSize = -1;                   // Bytes kept inside inode, -1 keeps default
+    bool Dedup = false;                    // Deduplicate data blocks
+    bool Compress = false;                 // Compress data of new files
+
+    char *BatchPath = NULL;                // Script run in batch mode ("-" is stdin)
+    bool KeepGoing = false;                // Batch mode continues after failed command
+    int Verbose = VERBOSE_NORMAL;          // Output printed in batch mode
+    int Ops = 0;                           // Commands executed
+    int Failed = 0;                        // Commands which failed
+    long long Start = 0;                   // Time at which batch started
+
+    static struct option LongOptions[] =
+    {
+        {"batch", required_argument, NULL, 'B'},
+        {"keep-going", no_argument, NULL, 'k'},
+        {"quiet", no_argument, NULL, 'q'},
+        {"verbose", no_argument, NULL, 'v'},
+        {NULL, 0, NULL, 0}
+    };
+
+    //  CVFS -i 1000000 -b 4096 -n 65536
+    //  CVFS -m cvfs.img --batch script.txt -k
+    while((iOption = getopt_long(argc, argv, "i:b:n:l:DZHm:B:kqv", LongOptions, NULL)) != -1)
+    {
+        if(iOption == 'i')
+        {
+            InodeCount = atoi(optarg);
+        }
+        else if(iOption == 'b')
+        {
+            BlockSize = atoi(optarg);
+        }
+        else if(iOption == 'n')
+        {
+            BlockCount = atoi(optarg);
+        }
+        else if(iOption == 'l')
+        {
+            InlineSize = atoi(optarg);
+        }
+        else if(iOption == 'D')
+        {
+            Dedup = true;
+        }
+        else if(iOption == 'Z')
+        {
+            Compress = true;
+        }
+        else if(iOption == 'H')
+        {
+            HugePages = true;
+        }
+        else if(iOption == 'm')
+        {
+            MountPath = optarg;
+        }
+        else if(iOption == 'B')
+        {
+            BatchPath = optarg;
+        }
+        else if(iOption == 'k')
+        {
+            KeepGoing = true;
+        }
+        else if(iOption == 'q')
+        {
+            Verbose = VERBOSE_QUIET;
+        }
+        else if(iOption == 'v')
+        {
+            Verbose = VERBOSE_ECHO;
+        }
+        else
+        {
+            printf("Usage : %s [-i inode_count] [-b block_size] [-n block_count] [-l inline_bytes] [-D] [-Z] [-H]\n",argv[0]);
+            printf("        [-m image_path]\n");
+            printf("        [--batch file] [-k] [-q | -v]\n");
+            return 1;
+        }
+    }
 
-    //  Initialise all system data structures
-    StartAuxillaryDataInitialisation();
+    //  Script is opened before anything is printed so that setvbuf is allowed
+    if(BatchPath != NULL)
+    {
+        if(strcmp(BatchPath,"-") != 0)
+        {
+            shellobj.Input = fopen(BatchPath,"r");
 
-    printf("\n");
-    printf("--------------------------------------------------------------------\n");
-    printf("----------------Omkar's CVFS started Successfully----------------\n");
-    printf("--------------------------------------------------------------------\n");
+            if(shellobj.Input == NULL)
+            {
+                printf("Error : Unable to open script %s (%s)\n",BatchPath,strerror(errno));
+                return 1;
+            }
+        }
 
-    // Infinite listening Shell
-    while(1)
+        shellobj.Batch = true;
+
+        //  Output goes out in large writes instead of one per line
+        setvbuf(stdout, NULL, _IOFBF, BATCHBUFSIZE);
+    }
+
+    if(InodeCount <= 0)
     {
-        fflush(stdin);                  // Clear input buffer
+        printf("Error : Number of inodes must be positive\n");
+        return 1;
+    }
 
-        strcpy(str,"");                 // Reset command string
+    //  Block size must be a power of 2 so that indirect blocks hold whole pointers
+    if((BlockSize < MINBLOCKSIZE) || ((BlockSize & (BlockSize - 1)) != 0))
+    {
+        printf("Error : Block size must be a power of 2, at least %d\n",MINBLOCKSIZE);
+        return 1;
+    }
 
-        // Display shell prompt
-        printf("\nOmkar's CVFS : > ");
+    if(BlockCount <= 0)
+    {
+        printf("Error : Number of blocks must be positive\n");
+        return 1;
+    }
 
-        // Accept full command line from user
-        fgets(str,sizeof(str),stdin);
+    if((InlineSize < -1) || (InlineSize > INLINEDATASIZE))
+    {
+        printf("Error : Inline size must be 0 to %d bytes\n",INLINEDATASIZE);
+        return 1;
+    }
 
-        // Split command into maximum 5 words
-        iCount = sscanf(str,"%s %s %s %s %s",Command[0],Command[1],Command[2],Command[3],Command[4]);
+    //  Initialise all system data structures
+    if(StartAuxillaryDataInitialisation(InodeCount, BlockSize, BlockCount, HugePages) == false)
+    {
+        printf("Omkar's CVFS : Unable to allocate image of %lld bytes\n",superobj.ImageSize);
+        return 1;
+    }
 
-        fflush(stdin);
+    if(BatchPath == NULL)
+    {
+        printf("%s\n",bootobj.Information);
+        printf("Omkar's CVFS : Auxillary data initialise successfully\n");
+    }
 
-        ////////////////////////////////////////////////////////////////////////
-        // Commands with only 1 word
-        ////////////////////////////////////////////////////////////////////////
-        if(iCount == 1)
+    //  Image given on command line replaces the empty file system
+    if(MountPath != NULL)
+    {
+        iRet = MountImage(MountPath);
+
+        if(iRet != EXECUTE_SUCCESS)
         {
-            //  exit command : terminates CVFS
-            //  Omkar's CVFS : > exit
-            if(strcmp("exit",Command[0]) == 0)
-            {
-                printf("Thank you for using Omkar's CVFS\n");
-                printf("Deallocating all the allocated resources\n");
+            PrintImageError(iRet);
+            ReleaseAuxillaryData();
+            return 1;
+        }
 
-                break;
-            }
+        if(BatchPath == NULL)
+        {
+            printf("Omkar's CVFS : Image %s mounted successfully\n",ImagePath);
+        }
+    }
 
-            //  ls command : list all files
-            //  Omkar's CVFS : > ls
-            else if(strcmp("ls",Command[0]) == 0)
-            {
-                LsFile();
-            }
+    //  Given size replaces the one of new or mounted file system
+    if(InlineSize >= 0)
+    {
+        SetInlineSize(InlineSize);
+    }
 
-            //  help command : display help page
-            //  Omkar's CVFS : > help
-            else if(strcmp("help",Command[0]) == 0)
-            {
-                DisplayHelp();
-            }
+    //  Mounted image keeps deduplication and compression it was saved with
+    if(Dedup == true)
+    {
+        SetDeduplication(true);
+    }
 
-            //  clear command : clear terminal screen
-            //  Omkar's CVFS : > clear
-            else if(strcmp("clear",Command[0]) == 0)
-            {
-                #ifdef _WIN32
-                    system("cls");
-                #else
-                    system("clear");
-                #endif
-            }
-            else
-            {
-                printf("Command not Found\n");
-                printf("Please refer help option to get more information\n");
-            }
-        }   // End of else if 1
+    if(Compress == true)
+    {
+        SetCompression(true);
+    }
 
-        ////////////////////////////////////////////////////////////////////////
-        // Commands with 2 words
-        ////////////////////////////////////////////////////////////////////////
-        else if(iCount == 2)
+    if(BatchPath == NULL)
+    {
+        printf("\n");
+        printf("--------------------------------------------------------------------\n");
+        printf("----------------Omkar's CVFS started Successfully----------------\n");
+        printf("--------------------------------------------------------------------\n");
+    }
+    else if(Verbose == VERBOSE_QUIET)
+    {
+        //  Failures and summary are printed on stderr
+        if(freopen("/dev/null","w",stdout) == NULL)
         {
-            //  man command : show manual page of given command
-            //  Omkar's CVFS : > man ls
-            if(strcmp("man",Command[0]) == 0)
-            {
-                ManPageDisplay(Command[1]);
-            }
+            Verbose = VERBOSE_NORMAL;
+        }
+    }
 
-            //  unlink command : delete given file
-            //  Omkar's CVFS : > unlink Demo.txt
-            else if(strcmp("unlink",Command[0]) == 0)
-            {
-                iRet = UnlinkFile(Command[1]);
+    Start = GetTimeNs();
 
-                if(iRet == ERR_INVALID_PARAMETER)
-                {
-                    printf("Error : Invalid parameter");
-                }
+    // Listening Shell
+    while(1)
+    {
+        // Display shell prompt
+        if(BatchPath == NULL)
+        {
+            printf("\nOmkar's CVFS : > ");
+        }
 
-                if(iRet == ERR_FILE_NOT_EXIST)
-                {
-                    printf("Error :  Unable to delete as there is no such file");
-                }
+        // Accept full command line, end of input works as exit
+        if(fgets(str,sizeof(str),shellobj.Input) == NULL)
+        {
+            ReleaseAuxillaryData();
+            break;
+        }
 
-                if(iRet == EXECUTE_SUCCESS)
-                {
-                    printf("File gets successfully deleted\n");
-                }
-            }
+        shellobj.Line++;
 
-            //  write command : write data into file using FD
-            //  Omkar's CVFD : > write 2   (here 2 is considered as fd)
-            else if(strcmp("write",Command[0]) == 0)
-            {
-                printf("Enter the data that you want to write : \n");
+        // Split command into words inside str itself
+        iCount = TokenizeCommand(str, Args, MAXARGS);
 
-                // Accept data from user
-                fgets(InputBuffer,MAXFILESIZE,stdin);
+        // Empty lines and comments of scripts are skipped
+        if((iCount == 0) || ((iCount > 0) && (Args[0][0] == '#')))
+        {
+            continue;
+        }
 
-                // Perform write operation
-                iRet = WriteFile(atoi(Command[1]), InputBuffer, strlen(InputBuffer)-1);
+        Ops++;
 
-                if(iRet == ERR_INVALID_PARAMETER)
-                {
-                    printf("Error : Invalid parameters\n");
-                }
-                else if(iRet == ERR_FILE_NOT_EXIST)
-                {
-                    printf("Error : There is no such file\n");
-                }
-                else if(iRet == ERR_PERMISSION_DENIED)
-                {
-                    printf("Error : Unable to write as there is no permission\n");
-                }
-                else if(iRet == ERR_INSUFFICIENT_DATA)
-                {
-                    printf("Error : Unable to write as there us no space\n");
-                }
-                else
+        if(iCount < 0)
+        {
+            printf("Error : Quote is not closed or there are more than %d words\n",MAXARGS);
+            iRet = ERR_INVALID_PARAMETER;
+        }
+        else
+        {
+            if(Verbose == VERBOSE_ECHO)
+            {
+                printf("+");
+                for(i = 0; i < iCount; i++)
                 {
-                    printf("%d bytes gets successfully wrriten\n",iRet);
+                    printf(" %s",Args[i]);
                 }
+                printf("\n");
             }
-            else
-            {
-                printf("Command not Found\n");
-                printf("Please refer help option to get more information\n");
-            }
-        }   // End of else if 2
+
+            iRet = RunCommand(iCount, Args);
+        }
+
+        if(shellobj.Exit == true)
+        {
+            ReleaseAuxillaryData();
+            break;
+        }
 
         ////////////////////////////////////////////////////////////////////////
-        // Commands with 3 words
+        // Failed command
         ////////////////////////////////////////////////////////////////////////
-        else if(iCount == 3)
+        if(iRet < 0)
         {
-            //  creat command : create new file with permission
-            //  Omkar's CVFS : > creat Ganesh.txt 3
-            if(strcmp("creat",Command[0]) == 0)
-            {
-                iRet = CreateFile(Command[1],atoi(Command[2]));     // atoi is ascii to integer 
-
-                if(iRet == ERR_INVALID_PARAMETER)
-                {
-                    printf("Error : Unable to create the file as parameters are invalid\n");
-                    printf("Please refer man page\n");
-                }
-
-                if(iRet == ERR_NO_INODES)
-                {
-                    printf("Error : Unable to create file as there is no inode\n");
-                }
-
-                if(iRet == ERR_FILE_ALREADY_EXIST)
-                {
-                    printf("Error : Unable to create file because the file is already present\n");
-                }
+            Failed++;
 
-                if(iRet == ERR_MAX_FILES_OPEN)
-                {
-                    printf("Error : Unable to create file\n");
-                    printf("Max opened files limit reached\n");
-                }
+            if(BatchPath != NULL)
+            {
+                //  stdout is flushed first so that the failure follows its output
+                fflush(stdout);
+                fprintf(stderr,"Omkar's CVFS : Line %d : %s failed with error %d\n",shellobj.Line,(iCount > 0) ? Args[0] : "command",iRet);
 
-                else if(iRet >= 0)
+                if(KeepGoing == false)
                 {
-                    printf("File gets successfully created with FD %d\n",iRet);
+                    ReleaseAuxillaryData();
+                    break;
                 }
             }
-            //  read command : read given number of bytes from file
-            //  Omkar's CVFS : > read 3 10
-            else if(strcmp("read",Command[0]) == 0)
-            {
-                // Allocate memory for read buffer
-                EmptyBuffer = (char*)malloc(sizeof(atoi(Command[2])));
-
-                // Perform read operation
-                iRet = ReadFile(atoi(Command[1]), EmptyBuffer, atoi(Command[2]));
+        }
+    }   // End of While
 
-                if(iRet == ERR_INVALID_PARAMETER)
-                {
-                    printf("Error : Invalid Parameter\n");
-                }
-                else if(iRet == ERR_FILE_NOT_EXIST)
-                {
-                    printf("Error : File not exist\n");
-                }
-                else if(iRet == ERR_PERMISSION_DENIED)
-                {
-                    printf("Error : Permission denied\n");
-                }
-                else if(iRet == ERR_INSUFFICIENT_DATA)
-                {
-                    printf("Error : Insufficient data\n");
-                }
-                else
-                {
-                    EmptyBuffer[iRet] = '\0';     // Make it proper string
-                    printf("Read operation is successful\n");
-                    printf("Data from file is : %s\n",EmptyBuffer);
+    if(BatchPath != NULL)
+    {
+        fflush(stdout);
+        fprintf(stderr,"Omkar's CVFS : %d commands, %d failed, %.3f ms\n",
+                Ops, Failed, (GetTimeNs() - Start) / 1e6);
 
-                    free(EmptyBuffer);           // Free allocated buffer
-                }
-            }
-            else
-            {
-                printf("Command not Found\n");
-                printf("Please refer help option to get more information\n");
-            }
-        }   // End of else if 3
-        else if(iCount == 4)
+        if(shellobj.Input != stdin)
         {
+            fclose(shellobj.Input);
+        }
 
-        }   // End of else if 4
-        else
-        {
-            printf("Command not Found\n");
-            printf("Please refer help option to get more information\n");
-        }   // End of else 
-    }   // End of While
+        return (Failed == 0) ? 0 : 1;
+    }
 
     return 0;
 }   // End of while
@@ -0,0 +1,637 @@
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  cvfsbench : Microbenchmarks of Omkar's CVFS
+//
+//  Drives the file API directly, without the shell, for every combination
+//  of inode count, file size and fill ratio given on the command line.
+//  Each operation is timed one call at a time, so that latency percentiles
+//  can be reported along with ns/op, ops/s and arena allocations per op.
+//  With -j the results are also written as JSON, so that two versions of
+//  CVFS can be compared.
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Header File Inclusion
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+#include<stdio.h>    // For printf, fprintf, fopen
+#include<stdlib.h>   // For malloc, free, qsort, strtol
+#include<unistd.h>   // For getopt
+#include<string.h>   // For memset, snprintf
+#include<time.h>     // For clock_gettime
+
+#include "libcvfs_internal.h"   // Library, and arena counters for allocations/op
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  User Defined Macros
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+#define BENCHOPS 10000         // Default operations timed per sample, see -n option
+#define BENCHLISTRUNS 100      // Full listings timed per sample
+#define MAXPARAMS 16           // Values accepted by every list option
+#define MAXRESULTS 4096        // Results kept for the report
+#define LISTBATCH 64           // Entries taken from ListFiles() at a time
+
+#define OP_CREATE 0
+#define OP_EXIST 1
+#define OP_WRITE 2
+#define OP_READ 3
+#define OP_LIST 4
+#define OP_UNLINK 5
+#define OP_PREFIX 6
+#define NOPERATIONS 7
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Structure Name :            BenchResult
+//  Description  :              Measurements of one operation of one sample
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+struct BenchResult
+{
+    const char *Operation;      // Name of operation
+    int Inodes;                 // Inodes of file system
+    int Size;                   // Bytes of every file
+    int Fill;                   // Percent of inodes used before the sample
+    long long Ops;              // Operations timed
+    long long Failed;           // Operations which returned an error
+    double NsPerOp;             // Mean latency
+    double OpsPerSec;           // Throughput
+    double AllocsPerOp;         // Arena allocations per operation
+    double BlocksPerOp;         // Data blocks taken per operation
+    long long P50;              // Median latency in ns
+    long long P99;              // 99th percentile latency in ns
+};
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Global variables or objects used in the Benchmark
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+const char *OperationNames[NOPERATIONS] = {"create", "exist", "write", "read", "ls", "unlink", "lsprefix"};
+
+struct BenchResult Results[MAXRESULTS];
+int ResultCount = 0;
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         GetTimeNs
+//  Description :           Returns monotonic time in nanoseconds.
+//  Output :                Current time in ns
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+long long GetTimeNs()
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (ts.tv_sec * 1000000000LL) + ts.tv_nsec;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         ParseList
+//  Description :           Reads a comma separated list of numbers such as
+//                          "1000,10000,100000".
+//  Input :                 text   -> List given on command line
+//                          values -> Receives the numbers
+//  Output :                Number of values, 0 if list is invalid
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+int ParseList(
+                const char *text,
+                int *values
+            )
+{
+    char *End = NULL;
+    int Count = 0;
+
+    while((*text != '\0') && (Count < MAXPARAMS))
+    {
+        values[Count] = (int)strtol(text, &End, 10);
+
+        if((End == text) || (values[Count] < 0))
+        {
+            return 0;
+        }
+
+        Count++;
+        text = (*End == ',') ? End + 1 : End;
+
+        if((*End != ',') && (*End != '\0'))
+        {
+            return 0;
+        }
+    }
+
+    return Count;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         CompareLatency
+//  Description :           Orders latencies for qsort.
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+int CompareLatency(
+                    const void *first,
+                    const void *second
+                )
+{
+    long long a = *(const long long *)first;
+    long long b = *(const long long *)second;
+
+    return (a > b) - (a < b);
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         AddResult
+//  Description :           Turns the time stamps of one operation into a
+//                          result. Stamp[0] is taken before the first call
+//                          and Stamp[i + 1] after call i, so the timer is
+//                          read once per call.
+//  Input :                 operation -> OP_ number
+//                          inodes, size, fill -> Parameters of sample
+//                          Stamp     -> count + 1 time stamps, reused for latencies
+//                          count     -> Operations timed
+//                          failed    -> Operations which returned an error
+//                          allocs    -> Arena allocations made by the calls
+//                          blocks    -> Data blocks taken by the calls
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+void AddResult(
+                int operation,
+                int inodes,
+                int size,
+                int fill,
+                long long *Stamp,
+                long long count,
+                long long failed,
+                long long allocs,
+                long long blocks
+            )
+{
+    struct BenchResult *Result = NULL;
+    long long Total = Stamp[count] - Stamp[0];
+    long long i = 0;
+
+    if((count == 0) || (ResultCount == MAXRESULTS))
+    {
+        return;
+    }
+
+    for(i = 0; i < count; i++)
+    {
+        Stamp[i] = Stamp[i + 1] - Stamp[i];
+    }
+
+    qsort(Stamp, count, sizeof(long long), CompareLatency);
+
+    Result = &Results[ResultCount];
+    ResultCount++;
+
+    Result->Operation = OperationNames[operation];
+    Result->Inodes = inodes;
+    Result->Size = size;
+    Result->Fill = fill;
+    Result->Ops = count;
+    Result->Failed = failed;
+    Result->NsPerOp = (double)Total / count;
+    Result->OpsPerSec = (Total > 0) ? (double)count * 1000000000.0 / Total : 0;
+    Result->AllocsPerOp = (double)allocs / count;
+    Result->BlocksPerOp = (double)blocks / count;
+    Result->P50 = Stamp[count / 2];
+    Result->P99 = Stamp[(count * 99) / 100];
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         RunSample
+//  Description :           Creates a file system of given inodes, fills
+//                          fill percent of them with files of given size,
+//                          and then times create, exist, write, read, ls,
+//                          ls of a prefix and unlink on up to ops more files.
+//  Input :                 inodes    -> Inodes of file system
+//                          size      -> Bytes of every file
+//                          fill      -> Percent of inodes used before timing
+//                          ops       -> Most operations timed per sample
+//                          blocksize -> Bytes of one data block
+//                          inlinesize -> Largest file kept in its inode, -1 for default
+//                          dedup     -> true to deduplicate data blocks
+//                          compress  -> true to compress data of files
+//  Output :                false if the file system could not be created
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+bool RunSample(
+                int inodes,
+                int size,
+                int fill,
+                int ops,
+                int blocksize,
+                int inlinesize,
+                bool dedup,
+                bool compress
+            )
+{
+    char name[MAXFILENAME] = {'\0'};
+    FILEENTRY Entries[LISTBATCH];
+    char *Data = NULL;
+    int *fds = NULL;
+    long long *Stamp = NULL;
+    int Filled = (int)(((long long)inodes * fill) / 100);
+    int Count = 0;
+    int Blocks = 0;
+    LISTCURSOR Cursor;
+    int fd = 0;
+    int i = 0;
+    long long Failed = 0;
+    long long Allocs = 0;
+    int FreeBlocks = 0;
+
+    if(Filled >= inodes)
+    {
+        Filled = inodes - 1;
+    }
+
+    Count = ((inodes - Filled) < ops) ? (inodes - Filled) : ops;
+
+    //  Data blocks of every file and its indirect blocks, with some spare
+    Blocks = (int)(((long long)inodes * (((size + blocksize - 1) / blocksize) + 2)) + 64);
+
+    if(StartAuxillaryDataInitialisation(inodes, blocksize, Blocks, false) == false)
+    {
+        return false;
+    }
+
+    if(inlinesize >= 0)
+    {
+        SetInlineSize(inlinesize);
+    }
+
+    //  Payload of every file is the same, so its full blocks are stored once
+    if(dedup == true)
+    {
+        SetDeduplication(true);
+    }
+
+    //  Payload is one repeated byte, a cluster compresses into one block
+    if(compress == true)
+    {
+        SetCompression(true);
+    }
+
+    //  Memory of benchmark is kept out of the arena, so allocations/op are the library's
+    Data = (char *)malloc((size > 0) ? size : 1);
+    fds = (int *)malloc(Count * sizeof(int));
+    Stamp = (long long *)malloc(((Count > BENCHLISTRUNS) ? Count : BENCHLISTRUNS) * sizeof(long long) + sizeof(long long));
+
+    if((Data == NULL) || (fds == NULL) || (Stamp == NULL))
+    {
+        free(Data);
+        free(fds);
+        free(Stamp);
+        ReleaseAuxillaryData();
+        return false;
+    }
+
+    memset(Data, 'a', size);
+
+    for(i = 0; i < Filled; i++)
+    {
+        snprintf(name, sizeof(name), "fill%d", i);
+        fd = CreateFile(name, READ + WRITE);
+
+        if(fd >= 0)
+        {
+            if(size > 0)
+            {
+                WriteFile(fd, Data, size);
+            }
+            CloseFile(fd);
+        }
+    }
+
+    //  create
+    Failed = 0;
+    Allocs = arenaobj.Allocations;
+    FreeBlocks = superobj.FreeBlocks;
+    Stamp[0] = GetTimeNs();
+    for(i = 0; i < Count; i++)
+    {
+        snprintf(name, sizeof(name), "f%d", i);
+        fds[i] = CreateFile(name, READ + WRITE);
+        Stamp[i + 1] = GetTimeNs();
+        Failed = Failed + (fds[i] < 0);
+    }
+    AddResult(OP_CREATE, inodes, size, fill, Stamp, Count, Failed, arenaobj.Allocations - Allocs, FreeBlocks - superobj.FreeBlocks);
+
+    //  exist
+    Failed = 0;
+    Allocs = arenaobj.Allocations;
+    FreeBlocks = superobj.FreeBlocks;
+    Stamp[0] = GetTimeNs();
+    for(i = 0; i < Count; i++)
+    {
+        snprintf(name, sizeof(name), "f%d", i);
+        Failed = Failed + (IsFileExist(name) == false);
+        Stamp[i + 1] = GetTimeNs();
+    }
+    AddResult(OP_EXIST, inodes, size, fill, Stamp, Count, Failed, arenaobj.Allocations - Allocs, FreeBlocks - superobj.FreeBlocks);
+
+    //  write, a file of size 0 is written with 1 byte
+    Failed = 0;
+    Allocs = arenaobj.Allocations;
+    FreeBlocks = superobj.FreeBlocks;
+    Stamp[0] = GetTimeNs();
+    for(i = 0; i < Count; i++)
+    {
+        Failed = Failed + (WriteFile(fds[i], Data, (size > 0) ? size : 1) <= 0);
+        Stamp[i + 1] = GetTimeNs();
+    }
+    AddResult(OP_WRITE, inodes, size, fill, Stamp, Count, Failed, arenaobj.Allocations - Allocs, FreeBlocks - superobj.FreeBlocks);
+
+    //  read
+    Failed = 0;
+    Allocs = arenaobj.Allocations;
+    FreeBlocks = superobj.FreeBlocks;
+    Stamp[0] = GetTimeNs();
+    for(i = 0; i < Count; i++)
+    {
+        Failed = Failed + (ReadFile(fds[i], Data, (size > 0) ? size : 1) <= 0);
+        Stamp[i + 1] = GetTimeNs();
+    }
+    AddResult(OP_READ, inodes, size, fill, Stamp, Count, Failed, arenaobj.Allocations - Allocs, FreeBlocks - superobj.FreeBlocks);
+
+    //  ls, one operation is a full listing
+    Failed = 0;
+    Allocs = arenaobj.Allocations;
+    FreeBlocks = superobj.FreeBlocks;
+    Stamp[0] = GetTimeNs();
+    for(i = 0; i < BENCHLISTRUNS; i++)
+    {
+        memset(&Cursor, 0, sizeof(Cursor));
+        while(ListFiles(NULL, Entries, LISTBATCH, &Cursor) > 0)
+        {
+        }
+        Stamp[i + 1] = GetTimeNs();
+    }
+    AddResult(OP_LIST, inodes, size, fill, Stamp, BENCHLISTRUNS, Failed, arenaobj.Allocations - Allocs, FreeBlocks - superobj.FreeBlocks);
+
+    //  ls of a prefix, name of every file is used as prefix and matches few names
+    Failed = 0;
+    Allocs = arenaobj.Allocations;
+    FreeBlocks = superobj.FreeBlocks;
+    Stamp[0] = GetTimeNs();
+    for(i = 0; i < Count; i++)
+    {
+        snprintf(name, sizeof(name), "f%d", i);
+        memset(&Cursor, 0, sizeof(Cursor));
+        Failed = Failed + (ListFiles(name, Entries, LISTBATCH, &Cursor) <= 0);
+        Stamp[i + 1] = GetTimeNs();
+    }
+    AddResult(OP_PREFIX, inodes, size, fill, Stamp, Count, Failed, arenaobj.Allocations - Allocs, FreeBlocks - superobj.FreeBlocks);
+
+    //  unlink, descriptors are closed first so that data is released at once
+    for(i = 0; i < Count; i++)
+    {
+        CloseFile(fds[i]);
+    }
+
+    Failed = 0;
+    Allocs = arenaobj.Allocations;
+    FreeBlocks = superobj.FreeBlocks;
+    Stamp[0] = GetTimeNs();
+    for(i = 0; i < Count; i++)
+    {
+        snprintf(name, sizeof(name), "f%d", i);
+        Failed = Failed + (UnlinkFile(name) < 0);
+        Stamp[i + 1] = GetTimeNs();
+    }
+    AddResult(OP_UNLINK, inodes, size, fill, Stamp, Count, Failed, arenaobj.Allocations - Allocs, FreeBlocks - superobj.FreeBlocks);
+
+    free(Data);
+    free(fds);
+    free(Stamp);
+    ReleaseAuxillaryData();
+
+    return true;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         PrintTable
+//  Description :           Displays all results as a table.
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+void PrintTable()
+{
+    int i = 0;
+
+    printf("%-8s%10s%8s%6s%10s%12s%14s%10s%11s%10s%10s\n",
+            "Op", "Inodes", "Size", "Fill", "Ops", "ns/op", "ops/s", "allocs/op", "blocks/op", "p50 ns", "p99 ns");
+
+    for(i = 0; i < ResultCount; i++)
+    {
+        printf("%-8s%10d%8d%6d%10lld%12.1f%14.0f%10.2f%11.2f%10lld%10lld%s\n",
+                Results[i].Operation, Results[i].Inodes, Results[i].Size, Results[i].Fill,
+                Results[i].Ops, Results[i].NsPerOp, Results[i].OpsPerSec, Results[i].AllocsPerOp,
+                Results[i].BlocksPerOp, Results[i].P50, Results[i].P99, (Results[i].Failed != 0) ? "  (failures)" : "");
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         WriteJson
+//  Description :           Writes all results as JSON, one object per
+//                          operation and sample.
+//  Input :                 path      -> Host path of output, "-" for stdout
+//                          blocksize -> Block size used by every sample
+//  Output :                false if file could not be written
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+bool WriteJson(
+                const char *path,
+                int blocksize
+            )
+{
+    FILE *Out = stdout;
+    int i = 0;
+
+    if(strcmp(path, "-") != 0)
+    {
+        Out = fopen(path, "w");
+
+        if(Out == NULL)
+        {
+            return false;
+        }
+    }
+
+    fprintf(Out, "{\n  \"block_size\": %d,\n  \"results\": [\n", blocksize);
+
+    for(i = 0; i < ResultCount; i++)
+    {
+        fprintf(Out, "    {\"op\": \"%s\", \"inodes\": %d, \"size\": %d, \"fill\": %d, "
+                     "\"ops\": %lld, \"failed\": %lld, \"ns_per_op\": %.1f, \"ops_per_sec\": %.0f, "
+                     "\"allocs_per_op\": %.3f, \"blocks_per_op\": %.3f, \"p50_ns\": %lld, \"p99_ns\": %lld}%s\n",
+                Results[i].Operation, Results[i].Inodes, Results[i].Size, Results[i].Fill,
+                Results[i].Ops, Results[i].Failed, Results[i].NsPerOp, Results[i].OpsPerSec,
+                Results[i].AllocsPerOp, Results[i].BlocksPerOp, Results[i].P50, Results[i].P99,
+                (i + 1 < ResultCount) ? "," : "");
+    }
+
+    fprintf(Out, "  ]\n}\n");
+
+    if(Out != stdout)
+    {
+        fclose(Out);
+    }
+
+    return true;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Entry Point Function of the Benchmark
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         main
+//  Description  :          Runs one sample for every combination of the
+//                          inode counts, file sizes and fill ratios.
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+int main(
+            int argc,
+            char *argv[]
+        )
+{
+    int Inodes[MAXPARAMS] = {1000, 10000, 100000};
+    int Sizes[MAXPARAMS] = {16, 512, 4096};
+    int Fills[MAXPARAMS] = {0, 50, 90};
+    int InodeCount = 3;
+    int SizeCount = 3;
+    int FillCount = 3;
+    int Ops = BENCHOPS;
+    int BlockSize = BLOCKSIZE;
+    const char *JsonPath = NULL;
+    int InlineSize = -1;
+    bool Dedup = false;
+    bool Compress = false;
+    int iOption = 0;
+    int i = 0;
+    int j = 0;
+    int k = 0;
+
+    while((iOption = getopt(argc, argv, "i:s:f:n:b:l:DZj:")) != -1)
+    {
+        if(iOption == 'i')
+        {
+            InodeCount = ParseList(optarg, Inodes);
+        }
+        else if(iOption == 's')
+        {
+            SizeCount = ParseList(optarg, Sizes);
+        }
+        else if(iOption == 'f')
+        {
+            FillCount = ParseList(optarg, Fills);
+        }
+        else if(iOption == 'n')
+        {
+            Ops = atoi(optarg);
+        }
+        else if(iOption == 'b')
+        {
+            BlockSize = atoi(optarg);
+        }
+        else if(iOption == 'l')
+        {
+            InlineSize = atoi(optarg);
+        }
+        else if(iOption == 'D')
+        {
+            Dedup = true;
+        }
+        else if(iOption == 'Z')
+        {
+            Compress = true;
+        }
+        else if(iOption == 'j')
+        {
+            JsonPath = optarg;
+        }
+        else
+        {
+            InodeCount = 0;
+            break;
+        }
+    }
+
+    if((InodeCount == 0) || (SizeCount == 0) || (FillCount == 0) || (Ops <= 0))
+    {
+        printf("Usage : %s [-i inodes,...] [-s sizes,...] [-f fill%%,...] [-n ops] [-b block_size]\n",argv[0]);
+        printf("        [-l inline_bytes] [-D] [-Z] [-j json_path]\n");
+        return 1;
+    }
+
+    for(i = 0; i < InodeCount; i++)
+    {
+        for(j = 0; j < SizeCount; j++)
+        {
+            for(k = 0; k < FillCount; k++)
+            {
+                if((Inodes[i] < 2) || (Fills[k] > 100) ||
+                   (RunSample(Inodes[i], Sizes[j], Fills[k], Ops, BlockSize, InlineSize, Dedup, Compress) == false))
+                {
+                    printf("Error : Unable to run sample of %d inodes, %d bytes, %d%% full\n",Inodes[i],Sizes[j],Fills[k]);
+                }
+            }
+        }
+    }
+
+    PrintTable();
+
+    if((JsonPath != NULL) && (WriteJson(JsonPath, BlockSize) == false))
+    {
+        printf("Error : Unable to write %s\n",JsonPath);
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,446 @@
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  cvfscheck : Consistency check of Omkar's CVFS
+//
+//  Walks the inode, name, block, snapshot and dedup tables of the file
+//  system and reports every place where they disagree. It is shared by
+//  the check command of the shell and by cvfstest, which runs it after
+//  every test and after recovery from an injected crash.
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Header File Inclusion
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+#include<stdio.h>    // For printf of errors found
+#include<string.h>   // For memset, memcpy
+
+#include "libcvfs_internal.h"   // Tables of the file system
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         CheckBlockTree
+//  Description :           Counts references of a block and the blocks below
+//                          it. Children of a shared indirect block are
+//                          referred once, by the block itself, so they are
+//                          only counted on its first visit; later visits
+//                          only count the data blocks for the file size.
+//  Input :                 Refs       -> References found for every block,
+//                                        NULL to count data blocks only
+//                          block      -> Block number, 0 is ignored
+//                          level      -> 0 for data block, 1 to 3 for indirect
+//                          DataBlocks -> Incremented for every data block
+//  Output :                Number of errors found
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+int CheckBlockTree(
+                    int *Refs,
+                    int block,
+                    int level,
+                    int *DataBlocks
+                )
+{
+    int i = 0;
+    int Errors = 0;
+    int *Entries = NULL;
+    int PerBlock = superobj.BlockSize / sizeof(int);
+
+    if(block == 0)
+    {
+        return 0;
+    }
+
+    if((block < 0) || (block > superobj.TotalBlocks))
+    {
+        printf("Block %d is out of range\n",block);
+        return 1;
+    }
+
+    if(Refs != NULL)
+    {
+        Refs[block - 1]++;
+
+        if(Refs[block - 1] > 1)
+        {
+            Refs = NULL;
+        }
+    }
+
+    if(level == 0)
+    {
+        (*DataBlocks)++;
+        return 0;
+    }
+
+    Entries = (int *)BlockData(block);
+
+    for(i = 0; i < PerBlock; i++)
+    {
+        Errors = Errors + CheckBlockTree(Refs, Entries[i], level - 1, DataBlocks);
+    }
+
+    return Errors;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         CheckInodeBlocks
+//  Description :           Counts references of every block reachable from
+//                          the block pointers of an inode.
+//  Input :                 Refs       -> References found for every block
+//                          ptrinode   -> Inode whose Block[] holds pointers
+//                          DataBlocks -> Incremented for every data block
+//  Output :                Number of errors found
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+int CheckInodeBlocks(
+                        int *Refs,
+                        PINODE ptrinode,
+                        int *DataBlocks
+                    )
+{
+    int Errors = 0;
+    int i = 0;
+
+    for(i = 0; i < NDIRECT; i++)
+    {
+        Errors = Errors + CheckBlockTree(Refs, ptrinode->Block[i], 0, DataBlocks);
+    }
+
+    Errors = Errors + CheckBlockTree(Refs, ptrinode->Block[INDIRECT], 1, DataBlocks);
+    Errors = Errors + CheckBlockTree(Refs, ptrinode->Block[DINDIRECT], 2, DataBlocks);
+    Errors = Errors + CheckBlockTree(Refs, ptrinode->Block[TINDIRECT], 3, DataBlocks);
+
+    return Errors;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         CheckFileSystem
+//  Description :           Verifies that the tables of the file system agree
+//                          with each other : free inode list against inode
+//                          types, name and ordered index against inode names,
+//                          parents against directories and their entry counts,
+//                          every block is either free or referred (by files
+//                          and snapshots) as many times as its reference
+//                          count says, every block of the dedup index holds
+//                          its fingerprint, and
+//                          compressed clusters have a valid stream length.
+//                          It is used to confirm recovery after a crash.
+//  Output :                Number of errors found, 0 if consistent
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+int CheckFileSystem()
+{
+    unsigned char *Seen = NULL;
+    int *Children = NULL;       // Named entries found for every directory
+    int *Refs = NULL;           // References found for every block
+    int Errors = 0;
+    int UsedInodes = 0;
+    int IndexEntries = 0;
+    int Orphans = 0;
+    int Ordered = 0;
+    int DataBlocks = 0;
+    int Indexed = 0;
+    int Size = (superobj.TotalInodes > superobj.TotalBlocks) ? superobj.TotalInodes : superobj.TotalBlocks;
+    int i = 0;
+    int j = 0;
+    int number = 0;
+    struct OrderNode *node = NULL;
+    PINODE prev = NULL;
+    SNAPSHOTENTRY Entry;
+
+    Seen = (unsigned char *)CvfsAlloc(Size);
+    Children = (int *)CvfsAlloc(superobj.TotalInodes * sizeof(int));
+    Refs = (int *)CvfsAlloc(superobj.TotalBlocks * sizeof(int));
+    if((Seen == NULL) || (Children == NULL) || (Refs == NULL))
+    {
+        CvfsFree(Seen, Size);
+        CvfsFree(Children, superobj.TotalInodes * sizeof(int));
+        CvfsFree(Refs, superobj.TotalBlocks * sizeof(int));
+        return ERR_NO_MEMORY;
+    }
+
+    memset(Children, 0, superobj.TotalInodes * sizeof(int));
+    memset(Refs, 0, superobj.TotalBlocks * sizeof(int));
+
+    //  Free inode list holds distinct unused inodes
+    memset(Seen, 0, Size);
+    for(i = 0; i < superobj.FreeInodes; i++)
+    {
+        number = FreeInodeList[i];
+
+        if((number < 1) || (number > superobj.TotalInodes) || (Seen[number - 1] != 0) ||
+           (DILBCore[number - 1].FileType != 0))
+        {
+            printf("Free inode list entry %d (inode %d) is invalid\n",i,number);
+            Errors++;
+            continue;
+        }
+
+        Seen[number - 1] = 1;
+    }
+
+    //  Every used inode is reachable by its name
+    for(i = 0; i < superobj.TotalInodes; i++)
+    {
+        if(DILBCore[i].FileType == 0)
+        {
+            continue;
+        }
+
+        UsedInodes++;
+
+        //  Unlinked file is kept only while it is open
+        if(DILB[i].FileName[0] == '\0')
+        {
+            Orphans++;
+
+            if(DILBCore[i].ReferenceCount <= 0)
+            {
+                printf("Inode %d is unlinked but not open\n",i + 1);
+                Errors++;
+            }
+        }
+        else if(NameIndexLookup(&indexobj, DILB[i].Parent, DILB[i].FileName) != &DILB[i])
+        {
+            printf("Inode %d (%s) is missing from name index\n",i + 1,DILB[i].FileName);
+            Errors++;
+        }
+        else if(DILB[i].Parent != ROOTDIRECTORY)
+        {
+            number = DILB[i].Parent;
+
+            if((number < 1) || (number > superobj.TotalInodes) || (DILBCore[number - 1].FileType != DIRECTORYFILE))
+            {
+                printf("Inode %d (%s) is in %d which is not a directory\n",i + 1,DILB[i].FileName,number);
+                Errors++;
+            }
+            else
+            {
+                Children[number - 1]++;
+            }
+        }
+    }
+
+    //  Entry count of directory is what rmdir trusts
+    for(i = 0; i < superobj.TotalInodes; i++)
+    {
+        if((DILBCore[i].FileType == DIRECTORYFILE) && (DILBCore[i].ActualFileSize != Children[i]))
+        {
+            printf("Directory %d (%s) counts %lld entries but has %d\n",i + 1,DILB[i].FileName,DILBCore[i].ActualFileSize,Children[i]);
+            Errors++;
+        }
+    }
+
+    for(j = 0; j <= (int)indexobj.Mask; j++)
+    {
+        if(indexobj.Slots[j].InodeNumber != 0)
+        {
+            IndexEntries++;
+        }
+    }
+
+    if((UsedInodes != superobj.TotalInodes - superobj.FreeInodes) || (IndexEntries != UsedInodes - Orphans))
+    {
+        printf("Inode counts differ : used %d, free %d of %d, indexed %d\n",
+               UsedInodes,superobj.FreeInodes,superobj.TotalInodes,IndexEntries);
+        Errors++;
+    }
+
+    //  Ordered index holds every named inode once, in increasing order
+    for(node = orderobj.Head[0]; node != NULL; node = node->Next[0])
+    {
+        Ordered++;
+
+        if((prev != NULL) && (OrderCompare(prev, DILB[node->InodeNumber - 1].Parent, DILB[node->InodeNumber - 1].FileName) >= 0))
+        {
+            printf("Inode %d (%s) is out of order in ordered index\n",node->InodeNumber,DILB[node->InodeNumber - 1].FileName);
+            Errors++;
+        }
+
+        prev = &DILB[node->InodeNumber - 1];
+    }
+
+    if((Ordered != orderobj.Count) || (Ordered != UsedInodes - Orphans))
+    {
+        printf("Ordered index holds %d names (counts %d) for %d named inodes\n",Ordered,orderobj.Count,UsedInodes - Orphans);
+        Errors++;
+    }
+
+    //  Free block list holds distinct blocks
+    memset(Seen, 0, Size);
+    for(i = 0; i < superobj.FreeBlocks; i++)
+    {
+        number = FreeBlockList[i];
+
+        if((number < 1) || (number > superobj.TotalBlocks) || (Seen[number - 1] != 0))
+        {
+            printf("Free block list entry %d (block %d) is invalid\n",i,number);
+            Errors++;
+            continue;
+        }
+
+        Seen[number - 1] = 1;
+    }
+
+    for(i = 0; i < superobj.TotalInodes; i++)
+    {
+        if(DILBCore[i].FileType == 0)
+        {
+            continue;
+        }
+
+        DataBlocks = 0;
+
+        //  Inline data owns no block and fits into Block[]
+        if((DILB[i].Flags & INODE_INLINE) != 0)
+        {
+            if((DILB[i].FileSize != 0) || (DILBCore[i].FileType != REGULARFILE) ||
+               (DILBCore[i].ActualFileSize > INLINEDATASIZE))
+            {
+                printf("Inode %d (%s) is inline with size %lld and %lld block bytes\n",i + 1,DILB[i].FileName,DILBCore[i].ActualFileSize,DILB[i].FileSize);
+                Errors++;
+            }
+            continue;
+        }
+
+        Errors = Errors + CheckInodeBlocks(Refs, &DILB[i], &DataBlocks);
+
+        if((long long)DataBlocks * superobj.BlockSize != DILB[i].FileSize)
+        {
+            printf("Inode %d (%s) has %d data blocks but size %lld\n",i + 1,DILB[i].FileName,DataBlocks,DILB[i].FileSize);
+            Errors++;
+        }
+    }
+
+    //  Snapshot refers the blocks of its table and the roots of its entries
+    for(i = 0; i < MAXSNAPSHOTS; i++)
+    {
+        if(Snapshots[i].Name[0] == '\0')
+        {
+            continue;
+        }
+
+        DataBlocks = 0;
+        Errors = Errors + CheckInodeBlocks(Refs, &Snapshots[i].Table, &DataBlocks);
+
+        if(((long long)DataBlocks * superobj.BlockSize != Snapshots[i].Table.FileSize) ||
+           (Snapshots[i].Table.FileSize < (long long)Snapshots[i].Files * (long long)sizeof(SNAPSHOTENTRY)))
+        {
+            printf("Snapshot %s has %d table blocks for %d entries\n",Snapshots[i].Name,DataBlocks,Snapshots[i].Files);
+            Errors++;
+            continue;
+        }
+
+        for(j = 0; j < Snapshots[i].Files; j++)
+        {
+            SnapshotCopy(&Snapshots[i].Table, (long long)j * sizeof(Entry), (char *)&Entry, sizeof(Entry), false);
+
+            if((Entry.Inode.InodeNumber < 1) || (Entry.Inode.InodeNumber > superobj.TotalInodes) ||
+               (Entry.Core.FileType == 0) || (Entry.Inode.FileName[0] == '\0'))
+            {
+                printf("Snapshot %s entry %d (inode %d) is invalid\n",Snapshots[i].Name,j,Entry.Inode.InodeNumber);
+                Errors++;
+                continue;
+            }
+
+            if((Entry.Inode.Flags & INODE_INLINE) != 0)
+            {
+                continue;
+            }
+
+            DataBlocks = 0;
+            Errors = Errors + CheckInodeBlocks(Refs, &Entry.Inode, &DataBlocks);
+
+            if((long long)DataBlocks * superobj.BlockSize != Entry.Inode.FileSize)
+            {
+                printf("Snapshot %s inode %d (%s) has %d data blocks but size %lld\n",Snapshots[i].Name,
+                       Entry.Inode.InodeNumber,Entry.Inode.FileName,DataBlocks,Entry.Inode.FileSize);
+                Errors++;
+            }
+        }
+    }
+
+    //  Every block is either free or referred as often as its record says
+    for(i = 0; i < superobj.TotalBlocks; i++)
+    {
+        if((Seen[i] == 0) && (Refs[i] == 0))
+        {
+            printf("Block %d is lost\n",i + 1);
+            Errors++;
+        }
+        else if((Seen[i] != 0) && (Refs[i] != 0))
+        {
+            printf("Block %d is free but used\n",i + 1);
+            Errors++;
+        }
+        else if(BlockRecords[i].Refs != Refs[i])
+        {
+            printf("Block %d counts %d references but has %d\n",i + 1,BlockRecords[i].Refs,Refs[i]);
+            Errors++;
+        }
+
+        if(BlockRecords[i].Hash != 0)
+        {
+            Indexed++;
+        }
+
+        //  Stream of a compressed cluster fits into fewer blocks than the cluster
+        if((BlockRecords[i].Refs > 0) && ((BlockRecords[i].Flags & BLOCK_COMPRESSED) != 0))
+        {
+            memcpy(&number, BlockData(i + 1), sizeof(number));
+
+            if((number <= 0) || (number > ((CLUSTERBLOCKS - 1) * superobj.BlockSize) - CLUSTERHEADER))
+            {
+                printf("Block %d holds compressed stream of %d bytes\n",i + 1,number);
+                Errors++;
+            }
+        }
+    }
+
+    //  Dedup index holds every fingerprinted block with its current bytes
+    for(j = 0; j <= (int)dedupobj.Mask; j++)
+    {
+        number = dedupobj.Slots[j].Block;
+
+        if(number == 0)
+        {
+            continue;
+        }
+
+        Indexed--;
+
+        if((number < 1) || (number > superobj.TotalBlocks) ||
+           (BlockRecords[number - 1].Hash != dedupobj.Slots[j].Hash) ||
+           (FingerprintBlock(BlockData(number)) != dedupobj.Slots[j].Hash))
+        {
+            printf("Dedup index entry %d (block %d) does not match its block\n",j,number);
+            Errors++;
+        }
+    }
+
+    if(Indexed != 0)
+    {
+        printf("Dedup index and block records differ by %d blocks\n",Indexed);
+        Errors++;
+    }
+
+    CvfsFree(Seen, Size);
+    CvfsFree(Children, superobj.TotalInodes * sizeof(int));
+    CvfsFree(Refs, superobj.TotalBlocks * sizeof(int));
+
+    return Errors;
+}
@@ -0,0 +1,962 @@
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  cvfstest : Regression tests of Omkar's CVFS
+//
+//  Drives the file API directly, without the shell. Every test starts an
+//  empty file system of its own, checks the results of the calls and
+//  releases it again. Names of failed checks are printed and the exit
+//  status is the number of failed tests, so 0 means all of them passed.
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Header File Inclusion
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+#include<stdio.h>    // For printf, snprintf
+#include<string.h>   // For memset, memcmp
+#include<unistd.h>   // For fork, pipe, unlink of crash test
+#include<sys/wait.h> // For waitpid of crash test
+
+#include "libcvfs_internal.h"   // Library, and MaxFileSize() of the image
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  User Defined Macros
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+#define TESTINODES 16          // Inodes of file system of every test
+#define TESTBLOCKS 1024        // Data blocks of file system of every test
+
+#define CRASHFILES 12          // Files created by workload of crash test
+#define CRASHBYTES 700         // Bytes written into each of them, 2 blocks
+#define CRASHGROUP 4           // Transactions per fsync during crash test
+#define CRASHPOINTS 5000       // Crash points tried at most
+
+//  Reports a failed check and ends the test
+#define EXPECT(condition)                                                   \
+    if(!(condition))                                                        \
+    {                                                                       \
+        printf("    %s:%d : %s\n",__FILE__,__LINE__,#condition);            \
+        return false;                                                       \
+    }
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Structure Name :            TestCase
+//  Description  :              Name of a test and the function which runs it
+//                              on an empty file system of given block size
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+struct TestCase
+{
+    const char *Name;
+    bool (*Run)();
+    int BlockSize;
+};
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         TestSeekPastMaxWrite
+//  Description :           Seeks a small inline file near INT64_MAX and then
+//                          writes. Seek must fail, offset plus size must not
+//                          overflow into the inline bound, and nothing of
+//                          the file changes.
+//  Output :                true if every check passed
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+bool TestSeekPastMaxWrite()
+{
+    char Buffer[16];
+    int fd = CreateFile("small", READ + WRITE);
+
+    EXPECT(fd >= 0);
+    EXPECT(WriteFile(fd, "abc", 3) == 3);
+
+    EXPECT(SeekFile(fd, 9223372036854775800LL, START) == ERR_FILE_TOO_LARGE);
+    EXPECT(SeekFile(fd, MaxFileSize() + 1, START) == ERR_FILE_TOO_LARGE);
+    EXPECT(WriteFileAt(fd, "xyz", 3, 9223372036854775800LL) == ERR_INSUFFICIENT_SPACE);
+    EXPECT(WriteFileAt(fd, "xyz", 3, MaxFileSize()) == ERR_INSUFFICIENT_SPACE);
+
+    memset(Buffer, 0, sizeof(Buffer));
+    EXPECT(ReadFileAt(fd, Buffer, sizeof(Buffer), 0) == 3);
+    EXPECT(memcmp(Buffer, "abc", 3) == 0);
+
+    return true;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         TestBorrowCompressedInline
+//  Description :           Borrows a view of a small file created with
+//                          compression on. Such a file is both inline and
+//                          compressed, and its bytes must be lent from the
+//                          inode instead of being taken as block numbers.
+//  Output :                true if every check passed
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+bool TestBorrowCompressedInline()
+{
+    FILEVIEW View;
+    int fd = 0;
+
+    EXPECT(SetCompression(true) == EXECUTE_SUCCESS);
+
+    fd = CreateFile("packed", READ + WRITE);
+    EXPECT(fd >= 0);
+
+    //  Bytes which would be taken as large block numbers
+    EXPECT(WriteFile(fd, "\xff\xff\xff\x7fzyxw", 8) == 8);
+
+    EXPECT(BorrowFileAt(fd, 0, 8, &View) == 8);
+    EXPECT(memcmp(View.Data, "\xff\xff\xff\x7fzyxw", 8) == 0);
+    ReturnFileView(&View);
+
+    EXPECT(BorrowFileAt(fd, 4, 16, &View) == 4);
+    EXPECT(memcmp(View.Data, "zyxw", 4) == 0);
+    ReturnFileView(&View);
+
+    return true;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         TestWriteBeyond2GB
+//  Description :           Seeks past the 2 GB offset of a file with 1 KB
+//                          blocks, writes there and reads the bytes back.
+//                          The hole before them reads as zeros.
+//  Output :                true if every check passed
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+bool TestWriteBeyond2GB()
+{
+    const long long Offset = (3LL << 30) + 100;
+    char Buffer[16];
+    int fd = CreateFile("large", READ + WRITE);
+
+    EXPECT(fd >= 0);
+    EXPECT(MaxFileSize() > Offset);
+
+    EXPECT(SeekFile(fd, Offset, START) == Offset);
+    EXPECT(WriteFile(fd, "far away", 8) == 8);
+    EXPECT(SeekFile(fd, 0, END) == Offset + 8);
+
+    memset(Buffer, 0, sizeof(Buffer));
+    EXPECT(ReadFileAt(fd, Buffer, sizeof(Buffer), Offset) == 8);
+    EXPECT(memcmp(Buffer, "far away", 8) == 0);
+
+    memset(Buffer, 1, sizeof(Buffer));
+    EXPECT(ReadFileAt(fd, Buffer, sizeof(Buffer), 1LL << 31) == (int)sizeof(Buffer));
+    EXPECT(Buffer[0] == 0 && Buffer[sizeof(Buffer) - 1] == 0);
+
+    return true;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         TestEmptyWritePastEnd
+//  Description :           Writes zero bytes far past the end of an inline
+//                          and of a block file. Neither file may grow,
+//                          take a block or leave its inline storage.
+//  Output :                true if every check passed
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+bool TestEmptyWritePastEnd()
+{
+    char Data[BLOCKSIZE + 10];
+    PINODE ptrinode = NULL;
+    int Free = 0;
+    int fd = CreateFile("empty", READ + WRITE);
+
+    EXPECT(fd >= 0);
+    EXPECT(WriteFile(fd, "abc", 3) == 3);
+    ptrinode = FileTableOf(fd)->ptrinode;
+    Free = superobj.FreeBlocks;
+
+    EXPECT(WriteFileAt(fd, "", 0, 5000) == 0);
+    EXPECT(SeekFile(fd, 0, END) == 3);
+    EXPECT((ptrinode->Flags & INODE_INLINE) != 0);
+    EXPECT(superobj.FreeBlocks == Free);
+
+    memset(Data, 'x', sizeof(Data));
+    EXPECT(WriteFileAt(fd, Data, sizeof(Data), 0) == (int)sizeof(Data));
+    Free = superobj.FreeBlocks;
+
+    EXPECT(WriteFileAt(fd, "", 0, 1LL << 32) == 0);
+    EXPECT(SeekFile(fd, 0, END) == (long long)sizeof(Data));
+    EXPECT(superobj.FreeBlocks == Free);
+    EXPECT(CloseFile(fd) == EXECUTE_SUCCESS);
+
+    return true;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         TestDirectoryPaths
+//  Description :           Builds /docs/sub/note and reaches the file by
+//                          absolute, relative and dotted paths. A directory
+//                          which holds an entry or is the working directory
+//                          must not be removed, and both its entries and the
+//                          tables checked by CheckFileSystem stay intact.
+//  Output :                true if every check passed
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+bool TestDirectoryPaths()
+{
+    FILEENTRY Entries[4];
+    LISTCURSOR Cursor;
+    char Buffer[16];
+    int fd = 0;
+
+    EXPECT(MakeDirectory("docs") == EXECUTE_SUCCESS);
+    EXPECT(MakeDirectory("/docs/sub") == EXECUTE_SUCCESS);
+
+    fd = CreateFile("docs/sub/note", READ + WRITE);
+    EXPECT(fd >= 0);
+    EXPECT(WriteFile(fd, "in a tree", 9) == 9);
+    EXPECT(CloseFile(fd) == EXECUTE_SUCCESS);
+
+    //  Same name in another directory is another file
+    fd = CreateFile("note", READ + WRITE);
+    EXPECT(fd >= 0);
+    EXPECT(WriteFile(fd, "at root", 7) == 7);
+    EXPECT(CloseFile(fd) == EXECUTE_SUCCESS);
+
+    EXPECT(ChangeDirectory("docs") == EXECUTE_SUCCESS);
+    EXPECT(GetWorkingDirectory(Buffer, sizeof(Buffer)) >= 0);
+    EXPECT(strcmp(Buffer, "/docs") == 0);
+
+    EXPECT(IsFileExist("sub/note") == true);
+    EXPECT(IsFileExist("note") == false);
+
+    fd = OpenFile("./sub/../sub/note", READ);
+    EXPECT(fd >= 0);
+    memset(Buffer, 0, sizeof(Buffer));
+    EXPECT(ReadFile(fd, Buffer, sizeof(Buffer)) == 9);
+    EXPECT(memcmp(Buffer, "in a tree", 9) == 0);
+    EXPECT(CloseFile(fd) == EXECUTE_SUCCESS);
+
+    fd = OpenFile("../note", READ);
+    EXPECT(fd >= 0);
+    memset(Buffer, 0, sizeof(Buffer));
+    EXPECT(ReadFile(fd, Buffer, sizeof(Buffer)) == 7);
+    EXPECT(memcmp(Buffer, "at root", 7) == 0);
+    EXPECT(CloseFile(fd) == EXECUTE_SUCCESS);
+
+    //  Size of a directory is its number of entries
+    memset(&Cursor, 0, sizeof(Cursor));
+    EXPECT(ListFiles("", Entries, 4, &Cursor) == 1);
+    EXPECT(strcmp(Entries[0].Name, "sub") == 0);
+    EXPECT((Entries[0].Directory == true) && (Entries[0].Size == 1));
+
+    EXPECT(RemoveDirectory("sub") == ERR_DIRECTORY_NOT_EMPTY);
+    EXPECT(RemoveDirectory("/docs") == ERR_DIRECTORY_NOT_EMPTY);
+    EXPECT(RemoveDirectory("sub/note") == ERR_NOT_DIRECTORY);
+    EXPECT(IsFileExist("/docs/sub/note") == true);
+    EXPECT(CheckFileSystem() == 0);
+
+    EXPECT(UnlinkFile("sub/note") == EXECUTE_SUCCESS);
+    EXPECT(RemoveDirectory("sub") == EXECUTE_SUCCESS);
+    EXPECT(IsFileExist("sub") == false);
+
+    //  Empty now, but still the working directory
+    EXPECT(RemoveDirectory("/docs") == ERR_DIRECTORY_BUSY);
+    EXPECT(ChangeDirectory("..") == EXECUTE_SUCCESS);
+    EXPECT(RemoveDirectory("docs") == EXECUTE_SUCCESS);
+    EXPECT(IsFileExist("docs") == false);
+    EXPECT(IsFileExist("note") == true);
+    EXPECT(CheckFileSystem() == 0);
+
+    return true;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         TestDedupUnlinkSharer
+//  Description :           Writes the same full blocks into two files with
+//                          deduplication on. Second file must take no block
+//                          of its own and every shared block counts both
+//                          files. Unlinking the first leaves the blocks to
+//                          the second with one reference and its data
+//                          intact; unlinking that frees them.
+//  Output :                true if every check passed
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+bool TestDedupUnlinkSharer()
+{
+    char Data[3 * BLOCKSIZE];
+    char Buffer[3 * BLOCKSIZE];
+    PINODE First = NULL;
+    PINODE Second = NULL;
+    int Free = superobj.FreeBlocks;
+    int fd = 0;
+    int i = 0;
+
+    for(i = 0; i < (int)sizeof(Data); i++)
+    {
+        Data[i] = (char)('A' + ((i / BLOCKSIZE) * 5 + i) % 26);
+    }
+
+    EXPECT(SetDeduplication(true) == EXECUTE_SUCCESS);
+
+    fd = CreateFile("first", READ + WRITE);
+    EXPECT(fd >= 0);
+    EXPECT(WriteFile(fd, Data, sizeof(Data)) == (int)sizeof(Data));
+    First = FileTableOf(fd)->ptrinode;
+    EXPECT(CloseFile(fd) == EXECUTE_SUCCESS);
+    EXPECT(superobj.FreeBlocks == Free - 3);
+
+    fd = CreateFile("second", READ + WRITE);
+    EXPECT(fd >= 0);
+    EXPECT(WriteFile(fd, Data, sizeof(Data)) == (int)sizeof(Data));
+    Second = FileTableOf(fd)->ptrinode;
+    EXPECT(superobj.FreeBlocks == Free - 3);
+
+    for(i = 0; i < 3; i++)
+    {
+        EXPECT(Second->Block[i] == First->Block[i]);
+        EXPECT(RecordOf(Second->Block[i])->Refs == 2);
+    }
+    EXPECT(CheckFileSystem() == 0);
+
+    EXPECT(UnlinkFile("first") == EXECUTE_SUCCESS);
+    EXPECT(superobj.FreeBlocks == Free - 3);
+
+    for(i = 0; i < 3; i++)
+    {
+        EXPECT(RecordOf(Second->Block[i])->Refs == 1);
+    }
+
+    memset(Buffer, 0, sizeof(Buffer));
+    EXPECT(ReadFileAt(fd, Buffer, sizeof(Buffer), 0) == (int)sizeof(Buffer));
+    EXPECT(memcmp(Buffer, Data, sizeof(Data)) == 0);
+    EXPECT(CheckFileSystem() == 0);
+
+    EXPECT(CloseFile(fd) == EXECUTE_SUCCESS);
+    EXPECT(UnlinkFile("second") == EXECUTE_SUCCESS);
+    EXPECT(superobj.FreeBlocks == Free);
+
+    return true;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         TestCompressedClusters
+//  Description :           Writes more compressible clusters than the
+//                          decompressed cache holds, plus a partial one,
+//                          and reads them back twice. Clusters must take
+//                          fewer blocks, a cluster is decompressed once for
+//                          all of its blocks and the bytes always match,
+//                          also after a write expands one cluster again.
+//  Output :                true if every check passed
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+bool TestCompressedClusters()
+{
+    const int Clusters = DECOMPCACHESIZE + 4;
+    const int ClusterSize = CLUSTERBLOCKS * BLOCKSIZE;
+    static char Data[(DECOMPCACHESIZE + 4) * CLUSTERBLOCKS * BLOCKSIZE + 100];
+    static char Buffer[sizeof(Data)];
+    long long Misses = compressobj.CacheMisses;
+    long long Hits = 0;
+    int Free = superobj.FreeBlocks;
+    PINODE ptrinode = NULL;
+    int fd = 0;
+    int i = 0;
+
+    //  Text with a cluster number in it, so every cluster differs
+    for(i = 0; i < (int)sizeof(Data); i++)
+    {
+        Data[i] = (i % 40 == 0) ? (char)('a' + (i / ClusterSize) % 26) : "compress me well "[i % 17];
+    }
+
+    EXPECT(SetCompression(true) == EXECUTE_SUCCESS);
+
+    fd = CreateFile("packed", READ + WRITE);
+    EXPECT(fd >= 0);
+    EXPECT(WriteFile(fd, Data, sizeof(Data)) == (int)sizeof(Data));
+    ptrinode = FileTableOf(fd)->ptrinode;
+
+    EXPECT((ptrinode->Flags & INODE_COMPRESS) != 0);
+    EXPECT((RecordOf(ptrinode->Block[0])->Flags & BLOCK_COMPRESSED) != 0);
+    EXPECT(Free - superobj.FreeBlocks < Clusters * CLUSTERBLOCKS);
+    EXPECT(CheckFileSystem() == 0);
+
+    //  Every cluster is decompressed once, so the first ones are evicted
+    memset(Buffer, 0, sizeof(Buffer));
+    EXPECT(ReadFileAt(fd, Buffer, sizeof(Buffer), 0) == (int)sizeof(Buffer));
+    EXPECT(memcmp(Buffer, Data, sizeof(Data)) == 0);
+    EXPECT(compressobj.CacheMisses - Misses >= Clusters);
+
+    //  Blocks of the evicted first cluster cost one decompression
+    Misses = compressobj.CacheMisses;
+    Hits = compressobj.CacheHits;
+    memset(Buffer, 0, sizeof(Buffer));
+
+    for(i = 0; i < CLUSTERBLOCKS; i++)
+    {
+        EXPECT(ReadFileAt(fd, Buffer + i * BLOCKSIZE, BLOCKSIZE, i * BLOCKSIZE) == BLOCKSIZE);
+    }
+
+    EXPECT(memcmp(Buffer, Data, ClusterSize) == 0);
+    EXPECT(compressobj.CacheMisses - Misses == 1);
+    EXPECT(compressobj.CacheHits - Hits == CLUSTERBLOCKS - 1);
+
+    //  Write into the middle of a compressed cluster rewrites it raw
+    memcpy(Data + ClusterSize + 10, "changed", 7);
+    EXPECT(WriteFileAt(fd, "changed", 7, ClusterSize + 10) == 7);
+
+    memset(Buffer, 0, sizeof(Buffer));
+    EXPECT(ReadFileAt(fd, Buffer, sizeof(Buffer), 0) == (int)sizeof(Buffer));
+    EXPECT(memcmp(Buffer, Data, sizeof(Data)) == 0);
+    EXPECT(CheckFileSystem() == 0);
+
+    EXPECT(CloseFile(fd) == EXECUTE_SUCCESS);
+    EXPECT(UnlinkFile("packed") == EXECUTE_SUCCESS);
+    EXPECT(superobj.FreeBlocks == Free);
+
+    return true;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         TestSnapshotRollback
+//  Description :           Freezes a directory with a block file and an
+//                          inline file, then changes, unlinks and creates
+//                          files. Snapshot must share blocks instead of
+//                          copying them, keep its old bytes readable without
+//                          changing the live tree, and rollback must bring
+//                          the frozen tree back.
+//  Output :                true if every check passed
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+bool TestSnapshotRollback()
+{
+    char Data[2 * BLOCKSIZE];
+    char Buffer[2 * BLOCKSIZE];
+    SNAPSHOTINFO Info[2];
+    PINODE ptrinode = NULL;
+    int Free = superobj.FreeBlocks;
+    int Frozen = 0;
+    int Used = 0;
+    int Before = 0;
+    int fd = 0;
+
+    memset(Data, 'o', sizeof(Data));
+
+    EXPECT(MakeDirectory("dir") == EXECUTE_SUCCESS);
+    fd = CreateFile("dir/big", READ + WRITE);
+    EXPECT(fd >= 0);
+    EXPECT(WriteFile(fd, Data, sizeof(Data)) == (int)sizeof(Data));
+    EXPECT(CloseFile(fd) == EXECUTE_SUCCESS);
+
+    fd = CreateFile("small", READ + WRITE);
+    EXPECT(fd >= 0);
+    EXPECT(WriteFile(fd, "old", 3) == 3);
+    EXPECT(CloseFile(fd) == EXECUTE_SUCCESS);
+
+    Used = Free - superobj.FreeBlocks;
+
+    EXPECT(CreateSnapshot("s1") == EXECUTE_SUCCESS);
+    EXPECT(CreateSnapshot("s1") == ERR_FILE_ALREADY_EXIST);
+    EXPECT(ListSnapshots(Info, 2) == 1);
+    EXPECT((strcmp(Info[0].Name, "s1") == 0) && (Info[0].Files == 3));
+
+    //  Only metadata blocks are taken, data blocks get one more reference
+    Frozen = Free - superobj.FreeBlocks - Used;
+    EXPECT(Frozen < Used);
+
+    fd = OpenFile("dir/big", READ + WRITE);
+    EXPECT(fd >= 0);
+    ptrinode = FileTableOf(fd)->ptrinode;
+    EXPECT(RecordOf(ptrinode->Block[0])->Refs == 2);
+
+    //  Live file diverges, snapshot keeps its block
+    EXPECT(WriteFileAt(fd, "new", 3, 0) == 3);
+    EXPECT(RecordOf(ptrinode->Block[0])->Refs == 1);
+    EXPECT(RollbackSnapshot("s1") == ERR_FILE_BUSY);
+    EXPECT(CloseFile(fd) == EXECUTE_SUCCESS);
+
+    EXPECT(UnlinkFile("small") == EXECUTE_SUCCESS);
+    fd = CreateFile("later", READ + WRITE);
+    EXPECT(fd >= 0);
+    EXPECT(CloseFile(fd) == EXECUTE_SUCCESS);
+    EXPECT(CheckFileSystem() == 0);
+
+    //  Reading the snapshot changes nothing of the live tree
+    Before = superobj.FreeBlocks;
+    memset(Buffer, 0, sizeof(Buffer));
+    EXPECT(ReadSnapshotFile("s1", "/dir/big", Buffer, sizeof(Buffer), 0) == (int)sizeof(Buffer));
+    EXPECT(memcmp(Buffer, Data, sizeof(Data)) == 0);
+    EXPECT(ReadSnapshotFile("s1", "small", Buffer, sizeof(Buffer), 0) == 3);
+    EXPECT(memcmp(Buffer, "old", 3) == 0);
+    EXPECT(ReadSnapshotFile("s1", "later", Buffer, sizeof(Buffer), 0) == ERR_FILE_NOT_EXIST);
+    EXPECT(superobj.FreeBlocks == Before);
+    EXPECT(IsFileExist("small") == false);
+
+    fd = OpenFile("dir/big", READ);
+    EXPECT(fd >= 0);
+    EXPECT(ReadFile(fd, Buffer, 3) == 3);
+    EXPECT(memcmp(Buffer, "new", 3) == 0);
+    EXPECT(CloseFile(fd) == EXECUTE_SUCCESS);
+
+    EXPECT(RollbackSnapshot("s1") == EXECUTE_SUCCESS);
+    EXPECT(IsFileExist("later") == false);
+    EXPECT(IsFileExist("small") == true);
+
+    fd = OpenFile("dir/big", READ);
+    EXPECT(fd >= 0);
+    memset(Buffer, 0, sizeof(Buffer));
+    EXPECT(ReadFile(fd, Buffer, sizeof(Buffer)) == (int)sizeof(Buffer));
+    EXPECT(memcmp(Buffer, Data, sizeof(Data)) == 0);
+    EXPECT(CloseFile(fd) == EXECUTE_SUCCESS);
+    EXPECT(CheckFileSystem() == 0);
+
+    //  Snapshot is kept by rollback, deleting it leaves the blocks of the
+    //  frozen tree only
+    EXPECT(ListSnapshots(Info, 2) == 1);
+    EXPECT(DeleteSnapshot("s1") == EXECUTE_SUCCESS);
+    EXPECT(ListSnapshots(Info, 2) == 0);
+    EXPECT(Free - superobj.FreeBlocks == Used);
+    EXPECT(CheckFileSystem() == 0);
+
+    return true;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         TestCloneDiverge
+//  Description :           Clones a file reaching its indirect block and
+//                          writes into a block of the clone behind that
+//                          indirect block. Clone must take no data block,
+//                          the write must copy only the blocks on its path,
+//                          and the source must keep its bytes, also after
+//                          the clone is unlinked.
+//  Output :                true if every check passed
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+bool TestCloneDiverge()
+{
+    static char Data[(NDIRECT + 2) * BLOCKSIZE];
+    static char Buffer[sizeof(Data)];
+    const long long Offset = (NDIRECT + 1) * BLOCKSIZE + 5;
+    PINODE Source = NULL;
+    PINODE Copy = NULL;
+    int Free = 0;
+    int fd = 0;
+    int cfd = 0;
+    int i = 0;
+
+    for(i = 0; i < (int)sizeof(Data); i++)
+    {
+        Data[i] = (char)('a' + (i % 23));
+    }
+
+    fd = CreateFile("source", READ + WRITE);
+    EXPECT(fd >= 0);
+    EXPECT(WriteFile(fd, Data, sizeof(Data)) == (int)sizeof(Data));
+    Source = FileTableOf(fd)->ptrinode;
+    EXPECT(Source->Block[NDIRECT] != 0);
+
+    Free = superobj.FreeBlocks;
+    EXPECT(CloneFile("source", "copy") == EXECUTE_SUCCESS);
+    EXPECT(CloneFile("source", "copy") == ERR_FILE_ALREADY_EXIST);
+    EXPECT(superobj.FreeBlocks == Free);
+
+    cfd = OpenFile("copy", READ + WRITE);
+    EXPECT(cfd >= 0);
+    Copy = FileTableOf(cfd)->ptrinode;
+
+    for(i = 0; i <= NDIRECT; i++)
+    {
+        EXPECT(Copy->Block[i] == Source->Block[i]);
+        EXPECT(RecordOf(Copy->Block[i])->Refs == 2);
+    }
+    EXPECT(CheckFileSystem() == 0);
+
+    //  Write copies the indirect block and one data block below it
+    EXPECT(WriteFileAt(cfd, "diverged", 8, Offset) == 8);
+    EXPECT(superobj.FreeBlocks == Free - 2);
+    EXPECT(Copy->Block[NDIRECT] != Source->Block[NDIRECT]);
+    EXPECT(RecordOf(Source->Block[NDIRECT])->Refs == 1);
+    EXPECT(Copy->Block[0] == Source->Block[0]);
+    EXPECT(CheckFileSystem() == 0);
+
+    memset(Buffer, 0, sizeof(Buffer));
+    EXPECT(ReadFileAt(fd, Buffer, sizeof(Buffer), 0) == (int)sizeof(Buffer));
+    EXPECT(memcmp(Buffer, Data, sizeof(Data)) == 0);
+
+    memcpy(Data + Offset, "diverged", 8);
+    memset(Buffer, 0, sizeof(Buffer));
+    EXPECT(ReadFileAt(cfd, Buffer, sizeof(Buffer), 0) == (int)sizeof(Buffer));
+    EXPECT(memcmp(Buffer, Data, sizeof(Data)) == 0);
+
+    //  Source keeps its bytes when the clone goes away
+    EXPECT(CloseFile(cfd) == EXECUTE_SUCCESS);
+    EXPECT(UnlinkFile("copy") == EXECUTE_SUCCESS);
+    EXPECT(superobj.FreeBlocks == Free);
+    EXPECT(RecordOf(Source->Block[0])->Refs == 1);
+
+    for(i = 0; i < 8; i++)
+    {
+        Data[Offset + i] = (char)('a' + ((Offset + i) % 23));
+    }
+
+    memset(Buffer, 0, sizeof(Buffer));
+    EXPECT(ReadFileAt(fd, Buffer, sizeof(Buffer), 0) == (int)sizeof(Buffer));
+    EXPECT(memcmp(Buffer, Data, sizeof(Data)) == 0);
+    EXPECT(CloseFile(fd) == EXECUTE_SUCCESS);
+
+    return true;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         CrashPayload
+//  Description :           Fills the bytes which workload of crash test
+//                          writes into a file, different for every file.
+//  Input :                 file -> Number of file
+//                          data -> Buffer of CRASHBYTES bytes
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+void CrashPayload(
+                    int file,
+                    char *data
+                )
+{
+    int i = 0;
+
+    for(i = 0; i < CRASHBYTES; i++)
+    {
+        data[i] = (char)('a' + ((file * 7 + i) % 26));
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         CrashStep
+//  Description :           Runs one step of workload of crash test. Even
+//                          step 2 * i creates file i, writes its payload and
+//                          closes it; odd step 2 * i + 1 unlinks file i - 1
+//                          when i % 3 == 2 and does nothing otherwise.
+//  Input :                 step -> Number of step
+//  Output :                true if every call of the step succeeded
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+bool CrashStep(
+                int step
+            )
+{
+    char Name[MAXFILENAME];
+    char Data[CRASHBYTES];
+    int file = step / 2;
+    int fd = 0;
+
+    if((step % 2) == 0)
+    {
+        snprintf(Name, sizeof(Name), "f%d", file);
+        CrashPayload(file, Data);
+
+        fd = CreateFile(Name, READ + WRITE);
+        return (fd >= 0) && (WriteFile(fd, Data, CRASHBYTES) == CRASHBYTES) && (CloseFile(fd) == EXECUTE_SUCCESS);
+    }
+
+    if((file % 3) != 2)
+    {
+        return true;
+    }
+
+    snprintf(Name, sizeof(Name), "f%d", file - 1);
+    return UnlinkFile(Name) == EXECUTE_SUCCESS;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         CheckCrashImage
+//  Description :           Checks a remounted image of crash test. Steps
+//                          below acked were durable before the crash and
+//                          must be found exactly; later steps may or may
+//                          not be found, but never half done.
+//  Input :                 acked -> Number of steps known to be durable
+//  Output :                true if every check passed
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+bool CheckCrashImage(
+                        int acked
+                    )
+{
+    char Name[MAXFILENAME];
+    char Expected[CRASHBYTES];
+    char Buffer[CRASHBYTES + 16];
+    int Unlinked = 0;
+    int Size = 0;
+    int fd = 0;
+    int i = 0;
+
+    EXPECT(CheckFileSystem() == 0);
+
+    for(i = 0; i < CRASHFILES; i++)
+    {
+        snprintf(Name, sizeof(Name), "f%d", i);
+        CrashPayload(i, Expected);
+
+        //  File i is unlinked by odd step of file i + 1, if any
+        Unlinked = (((i + 1) % 3) == 2) ? (2 * (i + 1)) + 1 : -1;
+
+        if((Unlinked >= 0) && (Unlinked < acked))
+        {
+            EXPECT(IsFileExist(Name) == false);
+            continue;
+        }
+
+        if(IsFileExist(Name) == false)
+        {
+            //  Only a step which was not acknowledged may be missing
+            EXPECT(((2 * i) >= acked) || (Unlinked >= 0));
+            continue;
+        }
+
+        fd = OpenFile(Name, READ);
+        EXPECT(fd >= 0);
+        Size = ReadFile(fd, Buffer, sizeof(Buffer));
+        EXPECT(CloseFile(fd) == EXECUTE_SUCCESS);
+
+        //  Write is one transaction, so the file is empty or complete
+        if((2 * i) < acked)
+        {
+            EXPECT(Size == CRASHBYTES);
+        }
+
+        EXPECT((Size == 0) || (Size == CRASHBYTES));
+        EXPECT((Size == 0) || (memcmp(Buffer, Expected, CRASHBYTES) == 0));
+    }
+
+    return true;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         TestCrashRecovery
+//  Description :           Runs the workload on a mounted image with group
+//                          commit and kills it at crash point N, for every
+//                          N until the workload ends without crash. A step
+//                          is acknowledged once a flush of the journal
+//                          carried all of its transactions. Image is then remounted, which
+//                          replays the journal, and checked. Workload and
+//                          remount run in child processes, so the file
+//                          system of the test is not touched.
+//  Output :                true if every check passed
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+bool TestCrashRecovery()
+{
+    char Image[64];
+    char Journal[64 + sizeof(JOURNAL_SUFFIX)];
+    int Pipe[2];
+    int Acked = 0;
+    int Step = 0;
+    int Status = 0;
+    long long Point = 0;
+    long long Flushes = 0;
+    pid_t pid = 0;
+    bool Crashed = true;
+
+    snprintf(Image, sizeof(Image), "/tmp/cvfstest-%d.img", (int)getpid());
+    snprintf(Journal, sizeof(Journal), "%s%s", Image, JOURNAL_SUFFIX);
+
+    for(Point = 1; (Crashed == true) && (Point <= CRASHPOINTS); Point++)
+    {
+        unlink(Image);
+        unlink(Journal);
+
+        EXPECT(pipe(Pipe) == 0);
+
+        pid = fork();
+        EXPECT(pid >= 0);
+
+        //  Workload, acknowledged steps are sent through the pipe
+        if(pid == 0)
+        {
+            close(Pipe[0]);
+
+            if(MountImage(Image) != EXECUTE_SUCCESS)
+            {
+                _exit(1);
+            }
+
+            journalobj.GroupSize = CRASHGROUP;
+            CrashCountdown = Point;     // As CVFS_CRASH_POINT does at mount
+
+            for(Step = 0; Step < 2 * CRASHFILES; Step++)
+            {
+                Flushes = journalobj.Flushes;
+
+                if(CrashStep(Step) == false)
+                {
+                    _exit(1);
+                }
+
+                //  Flush inside the step carried every earlier step
+                if(journalobj.Pending == 0)
+                {
+                    Acked = Step + 1;
+                }
+                else if(journalobj.Flushes != Flushes)
+                {
+                    Acked = Step;
+                }
+
+                if(write(Pipe[1], &Acked, sizeof(Acked)) != sizeof(Acked))
+                {
+                    _exit(1);
+                }
+            }
+
+            CrashCountdown = 0;
+            _exit((UnmountImage() == EXECUTE_SUCCESS) ? 0 : 1);
+        }
+
+        close(Pipe[1]);
+
+        Acked = 0;
+        while(read(Pipe[0], &Step, sizeof(Step)) == sizeof(Step))
+        {
+            Acked = Step;
+        }
+        close(Pipe[0]);
+
+        EXPECT(waitpid(pid, &Status, 0) == pid);
+        EXPECT(WIFEXITED(Status));
+        EXPECT((WEXITSTATUS(Status) == 0) || (WEXITSTATUS(Status) == CRASH_EXIT_CODE));
+
+        Crashed = (WEXITSTATUS(Status) == CRASH_EXIT_CODE);
+
+        //  Recovery
+        pid = fork();
+        EXPECT(pid >= 0);
+
+        if(pid == 0)
+        {
+            Status = MountImage(Image);
+            if(Status != EXECUTE_SUCCESS)
+            {
+                printf("    mount after crash point %lld failed with error %d\n",Point,Status);
+            }
+
+            Status = ((Status == EXECUTE_SUCCESS) && CheckCrashImage(Crashed ? Acked : 2 * CRASHFILES)) ? 0 : 1;
+            fflush(stdout);
+            _exit(Status);
+        }
+
+        EXPECT(waitpid(pid, &Status, 0) == pid);
+
+        if((WIFEXITED(Status) == false) || (WEXITSTATUS(Status) != 0))
+        {
+            printf("    recovery failed after crash point %lld, %d steps acknowledged\n",Point,Acked);
+            Crashed = false;
+            Point = -1;
+        }
+    }
+
+    unlink(Image);
+    unlink(Journal);
+
+    EXPECT(Point > 1);
+    EXPECT(Crashed == false);
+
+    return true;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Entry point function for the tests (main)
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+struct TestCase Tests[] =
+{
+    {"recover journal after crash at every crash point", TestCrashRecovery, BLOCKSIZE},
+    {"seek past largest file size and write", TestSeekPastMaxWrite, BLOCKSIZE},
+    {"borrow view of small compressed file", TestBorrowCompressedInline, BLOCKSIZE},
+    {"write and read beyond 2 GB offset", TestWriteBeyond2GB, 1024},
+    {"write zero bytes past end of file", TestEmptyWritePastEnd, BLOCKSIZE},
+    {"resolve paths and keep nonempty directories", TestDirectoryPaths, BLOCKSIZE},
+    {"keep deduplicated blocks after unlink of one sharer", TestDedupUnlinkSharer, BLOCKSIZE},
+    {"read compressed clusters back through the cache", TestCompressedClusters, BLOCKSIZE},
+    {"roll back to snapshot and read it without changes", TestSnapshotRollback, BLOCKSIZE},
+    {"clone file and diverge it by a write", TestCloneDiverge, BLOCKSIZE},
+};
+
+int main()
+{
+    int Failed = 0;
+    bool Passed = false;
+    size_t i = 0;
+
+    for(i = 0; i < (sizeof(Tests) / sizeof(Tests[0])); i++)
+    {
+        if(StartAuxillaryDataInitialisation(TESTINODES, Tests[i].BlockSize, TESTBLOCKS, false) == false)
+        {
+            printf("Error : Unable to start file system\n");
+            return 1;
+        }
+
+        //  Every test must leave a consistent file system behind
+        Passed = Tests[i].Run() && (CheckFileSystem() == 0);
+        ReleaseAuxillaryData();
+
+        printf("%s : %s\n",(Passed ? "PASS" : "FAIL"),Tests[i].Name);
+
+        if(Passed == false)
+        {
+            Failed++;
+        }
+    }
+
+    printf("%d of %d tests failed\n",Failed,(int)(sizeof(Tests) / sizeof(Tests[0])));
+
+    return Failed;
+}
@@ -0,0 +1,9214 @@
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  libcvfs : Implementation of Omkar's CVFS
+//
+//  Arena, journal, name index, sessions, disk image and the file API.
+//  Nothing here prints, errors are returned to the caller.
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Header File Inclusion
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+#include "libcvfs_internal.h"
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Global variables or objects used in the Project
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+BootBlock bootobj;
+SuperBlock superobj;
+UAREA uareaobj;
+SessionTable sessionobj;
+NAMEINDEX indexobj;
+ORDERINDEX orderobj;
+DEDUPINDEX dedupobj;
+DECOMPCACHE cacheobj;
+COMPRESSSTATS compressobj;
+ARENA arenaobj;
+JOURNAL journalobj;
+WORKERPOOL poolobj;
+thread_local HELDTASKS HeldTasks = {NULL, NULL, 0, false};   // Tasks collected by HoldIoTasks()
+
+#ifndef CVFS_NO_PERF
+struct PerfBlock PerfBlocks[MAXPERFTHREADS + 1];            // Last block is shared
+int PerfBlockCount = 0;                                     // Blocks given to threads so far
+pthread_mutex_t PerfLock = PTHREAD_MUTEX_INITIALIZER;       // Used flags and PerfBlockCount
+pthread_key_t PerfKey;                                      // Calls PerfDetach() at thread exit
+pthread_once_t PerfKeyOnce = PTHREAD_ONCE_INIT;
+thread_local struct PerfBlock *PerfLocal = NULL;            // Block of calling thread
+thread_local unsigned int PerfTick = 0;                     // Calls of calling thread, selects timed calls
+#endif
+
+PINODE DILB = NULL;             // Cold part of inode table (names, buffers)
+PINODECORE DILBCore = NULL;     // Hot part of inode table (type, size, refcount)
+
+int *FreeInodeList = NULL;      // Stack of free inode numbers, FreeInodeList[FreeInodes - 1] is next
+int *FreeBlockList = NULL;      // Stack of free block numbers
+PBLOCKRECORD BlockRecords = NULL;   // Reference count and fingerprint of every block
+PSNAPSHOT Snapshots = NULL;         // Snapshot records inside image header
+char *BlockPool = NULL;         // Data blocks, block N starts at (N - 1) * BlockSize
+int BlockShift = 0;             // log2 of BlockSize
+
+char *ImageBase = NULL;         // Start of image (arena memory or mapped file)
+int ImageFd = -1;               // Host file of mounted image, -1 if in memory only
+char ImagePath[MAXPATHSIZE];    // Host path of mounted image
+
+long long CrashCountdown = 0;   // Crash points left before injected crash, 0 = disabled
+
+struct InodeLock *InodeLocks = NULL;    // One lock per inode of DILB
+pthread_mutex_t NamespaceLock = PTHREAD_MUTEX_INITIALIZER;  // Name index, ordered index, inode allocation
+pthread_mutex_t JournalLock = PTHREAD_MUTEX_INITIALIZER;    // Running transaction
+pthread_mutex_t BlockLock = PTHREAD_MUTEX_INITIALIZER;      // Free block list, block records, dedup index
+pthread_mutex_t CacheLock = PTHREAD_MUTEX_INITIALIZER;      // Decompressed cluster cache
+pthread_mutex_t ArenaLock = PTHREAD_MUTEX_INITIALIZER;      // Slab classes of arena
+thread_local bool JournalHeld = false;  // Calling thread owns JournalLock
+
+pthread_mutex_t SessionLock = PTHREAD_MUTEX_INITIALIZER;    // Session table
+thread_local PUAREA CurrentUArea = &uareaobj;               // Session of calling thread
+long long OpenFileTables = 0;   // File table entries alive in the system
+const char ZeroData[ZEROVIEWSIZE] = {0};  // Lent for blocks which were never written
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :     InitialiseArena
+//  Description :       Prepares the size classes of the arena. No memory is
+//                      mapped until the first allocation.
+//  Input :             hugepages -> true to back mappings with huge pages
+//  Author :            Omkar Sachin Naralwar
+//  Date :              16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+void InitialiseArena(
+                        bool hugepages
+                    )
+{
+    int i = 0;
+
+    memset(&arenaobj, 0, sizeof(arenaobj));
+
+    for(i = 0; i < NSLABCLASS; i++)
+    {
+        arenaobj.Classes[i].Size = (size_t)SLABMINSIZE << i;
+    }
+
+    arenaobj.HugePages = hugepages;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :     ArenaMap
+//  Description :       Takes a new mapping from the operating system and
+//                      links it into the arena. Huge pages are tried first
+//                      when enabled, normal pages are used as fallback.
+//  Input :             size -> Usable bytes required
+//  Output :            Address of usable area (after ARENAHEADER), NULL on failure
+//  Author :            Omkar Sachin Naralwar
+//  Date :              16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+void * ArenaMap(
+                    size_t size
+                )
+{
+    struct ArenaChunk *chunk = NULL;
+    void *ptr = MAP_FAILED;
+    size_t PageSize = (size_t)sysconf(_SC_PAGESIZE);
+    size_t Total = 0;
+
+    if(arenaobj.HugePages == true)
+    {
+        Total = (size + ARENAHEADER + HUGEPAGESIZE - 1) & ~((size_t)HUGEPAGESIZE - 1);
+#ifdef MAP_HUGETLB
+        ptr = mmap(NULL, Total, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+#endif
+    }
+
+    if(ptr == MAP_FAILED)
+    {
+        Total = (size + ARENAHEADER + PageSize - 1) & ~(PageSize - 1);
+        ptr = mmap(NULL, Total, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    }
+
+    if(ptr == MAP_FAILED)
+    {
+        return NULL;
+    }
+
+    chunk = (struct ArenaChunk *)ptr;
+    chunk->Size = Total;
+    chunk->prev = NULL;
+    chunk->next = arenaobj.Chunks;
+
+    if(arenaobj.Chunks != NULL)
+    {
+        arenaobj.Chunks->prev = chunk;
+    }
+    arenaobj.Chunks = chunk;
+
+    arenaobj.MappedBytes = arenaobj.MappedBytes + Total;
+
+    return (char *)ptr + ARENAHEADER;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :     ArenaUnmap
+//  Description :       Unlinks a mapping from the arena and returns it to
+//                      the operating system.
+//  Input :             ptr -> Address returned by ArenaMap()
+//  Author :            Omkar Sachin Naralwar
+//  Date :              16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+void ArenaUnmap(
+                    void *ptr
+                )
+{
+    struct ArenaChunk *chunk = (struct ArenaChunk *)((char *)ptr - ARENAHEADER);
+
+    if(chunk->prev != NULL)
+    {
+        chunk->prev->next = chunk->next;
+    }
+    else
+    {
+        arenaobj.Chunks = chunk->next;
+    }
+
+    if(chunk->next != NULL)
+    {
+        chunk->next->prev = chunk->prev;
+    }
+
+    arenaobj.MappedBytes = arenaobj.MappedBytes - chunk->Size;
+
+    munmap(chunk, chunk->Size);
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :     SlabClassOf
+//  Description :       Finds the smallest size class which can hold size.
+//  Input :             size -> Bytes requested
+//  Output :            Index of size class, NSLABCLASS for large objects
+//  Author :            Omkar Sachin Naralwar
+//  Date :              16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+int SlabClassOf(
+                    size_t size
+                )
+{
+    int i = 0;
+
+    while((i < NSLABCLASS) && (arenaobj.Classes[i].Size < size))
+    {
+        i++;
+    }
+
+    return i;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :     SlabAlloc
+//  Description :       Allocates memory from the arena. Small objects come
+//                      from the free list of their size class or are carved
+//                      from the current slab chunk, aligned to their class
+//                      size (at most CACHELINE). Large objects get their
+//                      own page aligned mapping.
+//  Input :             size -> Bytes requested
+//  Output :            Address of memory, NULL if memory is not available
+//  Author :            Omkar Sachin Naralwar
+//  Date :              16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+void * SlabAlloc(
+                    size_t size
+                )
+{
+    struct SlabClass *Class = NULL;
+    void *ptr = NULL;
+    size_t Align = 0;
+    int i = SlabClassOf(size);
+
+    if(i == NSLABCLASS)
+    {
+        ptr = ArenaMap(size);
+        if(ptr == NULL)
+        {
+            return NULL;
+        }
+
+        arenaobj.LiveBytes = arenaobj.LiveBytes + size;
+    }
+    else
+    {
+        Class = &arenaobj.Classes[i];
+
+        if(Class->FreeList != NULL)
+        {
+            ptr = Class->FreeList;
+            Class->FreeList = *(void **)ptr;
+        }
+        else
+        {
+            Align = (Class->Size < CACHELINE) ? Class->Size : CACHELINE;
+            arenaobj.CurrentUsed = (arenaobj.CurrentUsed + Align - 1) & ~(Align - 1);
+
+            if((arenaobj.Current == NULL) || ((arenaobj.CurrentUsed + Class->Size) > arenaobj.CurrentSize))
+            {
+                arenaobj.Current = (char *)ArenaMap(SLABCHUNKSIZE - ARENAHEADER);
+                if(arenaobj.Current == NULL)
+                {
+                    return NULL;
+                }
+
+                arenaobj.CurrentSize = SLABCHUNKSIZE - ARENAHEADER;
+                arenaobj.CurrentUsed = 0;
+            }
+
+            ptr = arenaobj.Current + arenaobj.CurrentUsed;
+            arenaobj.CurrentUsed = arenaobj.CurrentUsed + Class->Size;
+        }
+
+        Class->Live++;
+        arenaobj.LiveBytes = arenaobj.LiveBytes + Class->Size;
+    }
+
+    arenaobj.Allocations++;
+
+    if(arenaobj.LiveBytes > arenaobj.PeakBytes)
+    {
+        arenaobj.PeakBytes = arenaobj.LiveBytes;
+    }
+
+    return ptr;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :     SlabFree
+//  Description :       Returns memory to the arena. Size must be the same
+//                      which was given to CvfsAlloc(), it selects the size
+//                      class so no header is stored with small objects.
+//  Input :             ptr  -> Address returned by CvfsAlloc(), NULL is ignored
+//                      size -> Bytes requested at allocation
+//  Author :            Omkar Sachin Naralwar
+//  Date :              16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+void SlabFree(
+                void *ptr,
+                size_t size
+            )
+{
+    struct SlabClass *Class = NULL;
+    int i = 0;
+
+    if(ptr == NULL)
+    {
+        return;
+    }
+
+    i = SlabClassOf(size);
+
+    if(i == NSLABCLASS)
+    {
+        ArenaUnmap(ptr);
+        arenaobj.LiveBytes = arenaobj.LiveBytes - size;
+    }
+    else
+    {
+        Class = &arenaobj.Classes[i];
+
+        *(void **)ptr = Class->FreeList;
+        Class->FreeList = ptr;
+
+        Class->Live--;
+        arenaobj.LiveBytes = arenaobj.LiveBytes - Class->Size;
+    }
+
+    arenaobj.Releases++;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :     CvfsAlloc
+//  Description :       Allocates memory from the arena. Safe to call from
+//                      many threads, arena is guarded by ArenaLock.
+//  Input :             size -> Bytes required
+//  Output :            Address of memory, NULL on failure
+//  Author :            Omkar Sachin Naralwar
+//  Date :              16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+void * CvfsAlloc(
+                    size_t size
+                )
+{
+    void *ptr = NULL;
+
+    pthread_mutex_lock(&ArenaLock);
+    ptr = SlabAlloc(size);
+    pthread_mutex_unlock(&ArenaLock);
+
+    return ptr;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :     CvfsFree
+//  Description :       Returns memory taken by CvfsAlloc() to the arena.
+//                      Safe to call from many threads.
+//  Input :             ptr  -> Address returned by CvfsAlloc(), NULL is ignored
+//                      size -> Size passed to CvfsAlloc()
+//  Author :            Omkar Sachin Naralwar
+//  Date :              16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+void CvfsFree(
+                void *ptr,
+                size_t size
+            )
+{
+    pthread_mutex_lock(&ArenaLock);
+    SlabFree(ptr, size);
+    pthread_mutex_unlock(&ArenaLock);
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :     DestroyArena
+//  Description :       Releases every mapping of the arena in one pass.
+//                      All memory handed out by CvfsAlloc() becomes invalid.
+//  Author :            Omkar Sachin Naralwar
+//  Date :              16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+void DestroyArena()
+{
+    struct ArenaChunk *chunk = arenaobj.Chunks;
+    struct ArenaChunk *next = NULL;
+
+    while(chunk != NULL)
+    {
+        next = chunk->next;
+        munmap(chunk, chunk->Size);
+        chunk = next;
+    }
+
+    InitialiseArena(arenaobj.HugePages);
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :     CrashPoint
+//  Description :       Point where a crash can be injected for testing the
+//                      recovery. When CVFS_CRASH_POINT environment variable
+//                      is N at mount time, the process is killed at the Nth
+//                      crash point without flushing anything.
+//  Author :            Omkar Sachin Naralwar
+//  Date :              16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+void CrashPoint()
+{
+    if(CrashCountdown > 0)
+    {
+        CrashCountdown--;
+
+        if(CrashCountdown == 0)
+        {
+            _exit(CRASH_EXIT_CODE);
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :     JournalGrow
+//  Description :       Makes sure that a growable arena array has room for
+//                      the required number of bytes, doubling its capacity.
+//  Input :             array    -> Address of array pointer
+//                      capacity -> Address of capacity in bytes
+//                      used     -> Bytes of array in use
+//                      required -> Bytes required in total
+//  Output :            true on success, false if memory is not available
+//  Author :            Omkar Sachin Naralwar
+//  Date :              16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+bool JournalGrow(
+                    void **array,
+                    long long *capacity,
+                    long long used,
+                    long long required
+                )
+{
+    long long NewCapacity = (*capacity > 0) ? *capacity : 4096;
+    void *NewArray = NULL;
+
+    if(required <= *capacity)
+    {
+        return true;
+    }
+
+    while(NewCapacity < required)
+    {
+        NewCapacity = NewCapacity * 2;
+    }
+
+    NewArray = CvfsAlloc(NewCapacity);
+    if(NewArray == NULL)
+    {
+        return false;
+    }
+
+    if(*array != NULL)
+    {
+        memcpy(NewArray, *array, used);
+        CvfsFree(*array, *capacity);
+    }
+
+    *array = NewArray;
+    *capacity = NewCapacity;
+
+    return true;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :     JournalAddRange
+//  Description :       Appends a byte range to a range list of the journal.
+//  Input :             list     -> Address of range array
+//                      count    -> Address of number of ranges
+//                      capacity -> Address of capacity (in ranges)
+//                      offset   -> Offset of range in image
+//                      length   -> Bytes in range
+//  Output :            true on success, false if list can not grow
+//  Author :            Omkar Sachin Naralwar
+//  Date :              16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+bool JournalAddRange(
+                        struct JournalRange **list,
+                        int *count,
+                        int *capacity,
+                        long long offset,
+                        long long length
+                    )
+{
+    long long Bytes = (long long)(*capacity) * sizeof(struct JournalRange);
+
+    //  Adjacent update of the same range is merged
+    if((*count > 0) && ((*list)[*count - 1].Offset + (*list)[*count - 1].Length == offset))
+    {
+        (*list)[*count - 1].Length = (*list)[*count - 1].Length + length;
+        return true;
+    }
+
+    if(JournalGrow((void **)list, &Bytes, (long long)(*count) * sizeof(struct JournalRange),
+                   (long long)(*count + 1) * sizeof(struct JournalRange)) == false)
+    {
+        return false;
+    }
+
+    *capacity = Bytes / sizeof(struct JournalRange);
+
+    (*list)[*count].Offset = offset;
+    (*list)[*count].Length = length;
+    (*count)++;
+
+    return true;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :     JournalMarkPages
+//  Description :       Marks pages of the image covered by a range as dirty,
+//                      so that checkpoint writes them into the image file.
+//  Input :             journal -> Journal of image
+//                      offset  -> Offset of range in image
+//                      length  -> Bytes in range
+//  Author :            Omkar Sachin Naralwar
+//  Date :              16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+void JournalMarkPages(
+                        JOURNAL *journal,
+                        long long offset,
+                        long long length
+                    )
+{
+    long long PageSize = sysconf(_SC_PAGESIZE);
+    long long Page = offset / PageSize;
+    long long Last = (offset + length - 1) / PageSize;
+
+    for(; Page <= Last; Page++)
+    {
+        journal->DirtyPages[Page / 8] |= (unsigned char)(1 << (Page % 8));
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :     JournalDirty
+//  Description :       Records that metadata of the image was modified by
+//                      the running operation. Memory outside the mounted
+//                      image is ignored, so callers need not check it.
+//                      Range which can not be recorded marks the running
+//                      transaction lost, JournalSeal() then fails it.
+//  Input :             ptr    -> Address of modified bytes
+//                      length -> Number of modified bytes
+//  Author :            Omkar Sachin Naralwar
+//  Date :              16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+void JournalDirty(
+                    const void *ptr,
+                    long long length
+                )
+{
+    long long Offset = (const char *)ptr - ImageBase;
+
+    if((journalobj.Fd < 0) || (Offset < 0) || (Offset + length > superobj.ImageSize) || (length <= 0))
+    {
+        return;
+    }
+
+    CrashPoint();
+
+    JournalMarkPages(&journalobj, Offset, length);
+
+    if(JournalAddRange(&journalobj.Ranges, &journalobj.RangeCount, &journalobj.RangeCapacity, Offset, length) == false)
+    {
+        journalobj.Lost = true;
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :     JournalData
+//  Description :       Records that file data of the image was modified.
+//                      With data journaling the data goes into the journal
+//                      like metadata, otherwise it is written to the image
+//                      before the transaction which refers it (ordered mode).
+//  Input :             ptr    -> Address of modified bytes
+//                      length -> Number of modified bytes
+//  Author :            Omkar Sachin Naralwar
+//  Date :              16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+void JournalData(
+                    const void *ptr,
+                    long long length
+                )
+{
+    long long Offset = (const char *)ptr - ImageBase;
+
+    if(journalobj.DataJournal == true)
+    {
+        JournalDirty(ptr, length);
+        return;
+    }
+
+    if((journalobj.Fd < 0) || (Offset < 0) || (Offset + length > superobj.ImageSize) || (length <= 0))
+    {
+        return;
+    }
+
+    JournalMarkPages(&journalobj, Offset, length);
+
+    //  Metadata must not be logged before data it points to is written
+    if(JournalAddRange(&journalobj.DataRanges, &journalobj.DataCount, &journalobj.DataCapacity, Offset, length) == false)
+    {
+        journalobj.Lost = true;
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :     JournalChecksum
+//  Description :       Calculates 64 bit FNV-1a hash of journal records.
+//  Input :             data   -> Records
+//                      length -> Bytes of records
+//  Output :            Checksum value
+//  Author :            Omkar Sachin Naralwar
+//  Date :              16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+unsigned long long JournalChecksum(
+                                    const char *data,
+                                    long long length
+                                )
+{
+    unsigned long long hash = 14695981039346656037ULL;
+    long long i = 0;
+
+    for(i = 0; i < length; i++)
+    {
+        hash = hash ^ (unsigned char)data[i];
+        hash = hash * 1099511628211ULL;
+    }
+
+    return hash;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :     JournalFlush
+//  Description :       Makes all committed transactions durable. Ordered data
+//                      is written into the image first, then the whole group
+//                      of transactions is appended to the journal with a
+//                      single fsync. Big journal triggers a checkpoint.
+//  Output :            EXECUTE_SUCCESS on success, ERR_IMAGE_IO on failure
+//  Author :            Omkar Sachin Naralwar
+//  Date :              16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+int JournalFlush()
+{
+    int i = 0;
+    struct JournalRange *Range = NULL;
+
+    if((journalobj.Fd < 0) || (journalobj.Pending == 0))
+    {
+        return EXECUTE_SUCCESS;
+    }
+
+    //  Data must reach the image before metadata which points to it
+    for(i = 0; i < journalobj.DataCount; i++)
+    {
+        Range = &journalobj.DataRanges[i];
+
+        if(pwrite(ImageFd, ImageBase + Range->Offset, Range->Length, Range->Offset) != (ssize_t)Range->Length)
+        {
+            return ERR_IMAGE_IO;
+        }
+    }
+
+    if((journalobj.DataCount > 0) && (fdatasync(ImageFd) != 0))
+    {
+        return ERR_IMAGE_IO;
+    }
+
+    journalobj.DataCount = 0;
+
+    CrashPoint();
+
+    if(pwrite(journalobj.Fd, journalobj.Buffer, journalobj.BufferUsed, journalobj.FileSize) != (ssize_t)journalobj.BufferUsed)
+    {
+        return ERR_IMAGE_IO;
+    }
+
+    CrashPoint();
+
+    if(fdatasync(journalobj.Fd) != 0)
+    {
+        return ERR_IMAGE_IO;
+    }
+
+    CrashPoint();
+
+    journalobj.FileSize = journalobj.FileSize + journalobj.BufferUsed;
+    journalobj.BufferUsed = 0;
+    journalobj.Pending = 0;
+    journalobj.StableFree = superobj.FreeBlocks;
+    journalobj.Flushes++;
+
+    if(journalobj.FileSize > JOURNAL_LIMIT)
+    {
+        return JournalCheckpoint();
+    }
+
+    return EXECUTE_SUCCESS;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :     JournalSeal
+//  Description :       Closes the running transaction. SuperBlock is copied
+//                      into the image header, then every recorded range is
+//                      copied into one transaction of the journal buffer.
+//                      Buffer is flushed once GroupSize transactions wait.
+//                      Transaction which lost a range is never logged, its
+//                      changes reach the image file only by a checkpoint.
+//  Output :            EXECUTE_SUCCESS on success, ERR_IMAGE_IO on failure,
+//                      ERR_NO_MEMORY if a range of it could not be recorded
+//  Author :            Omkar Sachin Naralwar
+//  Date :              16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+int JournalSeal()
+{
+    struct JournalHeader Header;
+    struct JournalRange *Range = NULL;
+    long long Required = sizeof(Header);
+    long long Position = 0;
+    int i = 0;
+
+    if(journalobj.Fd < 0)
+    {
+        return EXECUTE_SUCCESS;
+    }
+
+    //  Counters of SuperBlock are part of every transaction
+    memcpy(ImageBase + SUPERBLOCKOFFSET, &superobj, sizeof(superobj));
+    JournalDirty(ImageBase + SUPERBLOCKOFFSET, sizeof(superobj));
+
+    if(journalobj.Lost == true)
+    {
+        journalobj.RangeCount = 0;
+        journalobj.Lost = false;
+        return ERR_NO_MEMORY;
+    }
+
+    for(i = 0; i < journalobj.RangeCount; i++)
+    {
+        Required = Required + sizeof(long long) * 2 + journalobj.Ranges[i].Length;
+    }
+
+    if(JournalGrow((void **)&journalobj.Buffer, &journalobj.BufferCapacity,
+                   journalobj.BufferUsed, journalobj.BufferUsed + Required) == false)
+    {
+        return ERR_NO_MEMORY;
+    }
+
+    //  Records : offset, length, bytes
+    Position = journalobj.BufferUsed + sizeof(Header);
+
+    for(i = 0; i < journalobj.RangeCount; i++)
+    {
+        Range = &journalobj.Ranges[i];
+
+        memcpy(journalobj.Buffer + Position, &Range->Offset, sizeof(long long));
+        memcpy(journalobj.Buffer + Position + sizeof(long long), &Range->Length, sizeof(long long));
+        memcpy(journalobj.Buffer + Position + sizeof(long long) * 2, ImageBase + Range->Offset, Range->Length);
+
+        Position = Position + sizeof(long long) * 2 + Range->Length;
+    }
+
+    Header.Magic = JOURNAL_MAGIC;
+    Header.Records = journalobj.RangeCount;
+    Header.Sequence = journalobj.Sequence;
+    Header.Bytes = Required - sizeof(Header);
+    Header.Checksum = JournalChecksum(journalobj.Buffer + journalobj.BufferUsed + sizeof(Header), Header.Bytes);
+
+    memcpy(journalobj.Buffer + journalobj.BufferUsed, &Header, sizeof(Header));
+
+    journalobj.BufferUsed = journalobj.BufferUsed + Required;
+    journalobj.RangeCount = 0;
+    journalobj.Sequence++;
+    journalobj.Pending++;
+    journalobj.Commits++;
+
+    if(journalobj.Pending >= journalobj.GroupSize)
+    {
+        return JournalFlush();
+    }
+
+    return EXECUTE_SUCCESS;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :     JournalBegin
+//  Description :       Starts an operation which modifies the mounted image.
+//                      Operations are serialized by JournalLock until they
+//                      commit, so a transaction never holds a half done
+//                      operation of another thread. Without a mounted image
+//                      nothing is journaled and no lock is taken.
+//  Author :            Omkar Sachin Naralwar
+//  Date :              16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+void JournalBegin()
+{
+    if(journalobj.Fd >= 0)
+    {
+        pthread_mutex_lock(&JournalLock);
+        JournalHeld = true;
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :     JournalEnd
+//  Description :       Releases JournalLock taken by JournalBegin().
+//  Author :            Omkar Sachin Naralwar
+//  Date :              16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+void JournalEnd()
+{
+    if(JournalHeld == true)
+    {
+        JournalHeld = false;
+        pthread_mutex_unlock(&JournalLock);
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :     JournalCommit
+//  Description :       Ends the operation started by JournalBegin(). Its
+//                      changes become one transaction of the journal.
+//  Output :            EXECUTE_SUCCESS on success, error code on failure
+//  Author :            Omkar Sachin Naralwar
+//  Date :              16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+int JournalCommit()
+{
+    int iRet = JournalSeal();
+
+    JournalEnd();
+
+    return iRet;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :     JournalCheckpoint
+//  Description :       Writes every dirty page of the image into the image
+//                      file and empties the journal. Journal is flushed
+//                      first, so a crash in the middle of checkpoint is
+//                      repaired by replaying it.
+//  Output :            EXECUTE_SUCCESS on success, ERR_IMAGE_IO on failure
+//  Author :            Omkar Sachin Naralwar
+//  Date :              16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+int JournalCheckpoint()
+{
+    long long PageSize = sysconf(_SC_PAGESIZE);
+    long long Page = 0;
+    long long First = 0;
+    long long Offset = 0;
+    long long Length = 0;
+    int iRet = 0;
+
+    if(journalobj.Fd < 0)
+    {
+        return EXECUTE_SUCCESS;
+    }
+
+    iRet = JournalFlush();
+    if(iRet != EXECUTE_SUCCESS)
+    {
+        return iRet;
+    }
+
+    //  Write runs of consecutive dirty pages
+    while(Page < journalobj.PageCount)
+    {
+        if((journalobj.DirtyPages[Page / 8] & (1 << (Page % 8))) == 0)
+        {
+            Page++;
+            continue;
+        }
+
+        First = Page;
+        while((Page < journalobj.PageCount) && ((journalobj.DirtyPages[Page / 8] & (1 << (Page % 8))) != 0))
+        {
+            Page++;
+        }
+
+        Offset = First * PageSize;
+        Length = (Page - First) * PageSize;
+        if(Offset + Length > superobj.ImageSize)
+        {
+            Length = superobj.ImageSize - Offset;
+        }
+
+        if(pwrite(ImageFd, ImageBase + Offset, Length, Offset) != (ssize_t)Length)
+        {
+            return ERR_IMAGE_IO;
+        }
+
+        CrashPoint();
+    }
+
+    if(fsync(ImageFd) != 0)
+    {
+        return ERR_IMAGE_IO;
+    }
+
+    CrashPoint();
+
+    memset(journalobj.DirtyPages, 0, (journalobj.PageCount + 7) / 8);
+
+    if((ftruncate(journalobj.Fd, 0) != 0) || (fsync(journalobj.Fd) != 0))
+    {
+        return ERR_IMAGE_IO;
+    }
+
+    journalobj.FileSize = 0;
+    journalobj.StableFree = superobj.FreeBlocks;
+    journalobj.Checkpoints++;
+
+    return EXECUTE_SUCCESS;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :     JournalOpen
+//  Description :       Opens (or creates) the journal of an image and
+//                      allocates dirty page map of the image. Group size and
+//                      data mode are taken from the current journal.
+//  Input :             journal   -> Journal to be prepared
+//                      path      -> Host path of image
+//                      imagesize -> Bytes in image
+//                      fresh     -> true to discard old journal contents
+//  Output :            EXECUTE_SUCCESS on success, error code on failure
+//  Author :            Omkar Sachin Naralwar
+//  Date :              16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+int JournalOpen(
+                    JOURNAL *journal,
+                    const char *path,
+                    long long imagesize,
+                    bool fresh
+                )
+{
+    long long PageSize = sysconf(_SC_PAGESIZE);
+
+    memset(journal, 0, sizeof(JOURNAL));
+    journal->Fd = -1;
+    journal->GroupSize = (journalobj.GroupSize > 0) ? journalobj.GroupSize : JOURNAL_GROUP;
+    journal->DataJournal = journalobj.DataJournal;
+
+    snprintf(journal->Path, sizeof(journal->Path), "%s%s", path, JOURNAL_SUFFIX);
+
+    journal->PageCount = (imagesize + PageSize - 1) / PageSize;
+    journal->DirtyPages = (unsigned char *)CvfsAlloc((journal->PageCount + 7) / 8);
+    if(journal->DirtyPages == NULL)
+    {
+        return ERR_NO_MEMORY;
+    }
+    memset(journal->DirtyPages, 0, (journal->PageCount + 7) / 8);
+
+    journal->Fd = open(journal->Path, O_RDWR | O_CREAT | (fresh ? O_TRUNC : 0), 0644);
+    if(journal->Fd < 0)
+    {
+        return ERR_IMAGE_IO;
+    }
+
+    return EXECUTE_SUCCESS;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :     JournalRelease
+//  Description :       Closes journal host file and releases journal memory.
+//                      Caller checkpoints the image before releasing.
+//  Input :             journal -> Journal to be released
+//  Author :            Omkar Sachin Naralwar
+//  Date :              16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+void JournalRelease(
+                        JOURNAL *journal
+                    )
+{
+    int GroupSize = journal->GroupSize;
+    bool DataJournal = journal->DataJournal;
+
+    if(journal->Fd >= 0)
+    {
+        close(journal->Fd);
+    }
+
+    CvfsFree(journal->Ranges, (long long)journal->RangeCapacity * sizeof(struct JournalRange));
+    CvfsFree(journal->DataRanges, (long long)journal->DataCapacity * sizeof(struct JournalRange));
+    CvfsFree(journal->Buffer, journal->BufferCapacity);
+    CvfsFree(journal->DirtyPages, (journal->PageCount + 7) / 8);
+
+    //  Settings survive for the next mount
+    memset(journal, 0, sizeof(JOURNAL));
+    journal->Fd = -1;
+    journal->GroupSize = GroupSize;
+    journal->DataJournal = DataJournal;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :     JournalReplay
+//  Description :       Applies every complete transaction of the journal to
+//                      the mapped image. Replay stops at the first torn or
+//                      corrupted transaction, which was never acknowledged.
+//                      Replayed pages are marked dirty for checkpoint.
+//  Input :             journal   -> Opened journal of image
+//                      base      -> Address of mapped image
+//                      imagesize -> Bytes in image
+//  Output :            Number of transactions replayed, ERR_IMAGE_IO on failure
+//  Author :            Omkar Sachin Naralwar
+//  Date :              16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+long long JournalReplay(
+                            JOURNAL *journal,
+                            char *base,
+                            long long imagesize
+                        )
+{
+    struct JournalHeader Header;
+    struct stat Info;
+    char *Data = NULL;
+    long long Size = 0;
+    long long Position = 0;
+    long long Record = 0;
+    long long Offset = 0;
+    long long Length = 0;
+    long long Count = 0;
+    unsigned int i = 0;
+    bool Valid = true;
+
+    if(fstat(journal->Fd, &Info) != 0)
+    {
+        return ERR_IMAGE_IO;
+    }
+
+    Size = Info.st_size;
+    if(Size == 0)
+    {
+        return 0;
+    }
+
+    Data = (char *)CvfsAlloc(Size);
+    if((Data == NULL) || (pread(journal->Fd, Data, Size, 0) != (ssize_t)Size))
+    {
+        CvfsFree(Data, Size);
+        return ERR_IMAGE_IO;
+    }
+
+    while(Position + (long long)sizeof(Header) <= Size)
+    {
+        memcpy(&Header, Data + Position, sizeof(Header));
+        Record = Position + sizeof(Header);
+
+        if((Header.Magic != JOURNAL_MAGIC) || (Header.Bytes < 0) || (Record + Header.Bytes > Size) ||
+           (JournalChecksum(Data + Record, Header.Bytes) != Header.Checksum))
+        {
+            break;
+        }
+
+        //  Check every record before touching the image
+        Valid = true;
+        Position = Record;
+        for(i = 0; (i < Header.Records) && (Valid == true); i++)
+        {
+            memcpy(&Offset, Data + Position, sizeof(long long));
+            memcpy(&Length, Data + Position + sizeof(long long), sizeof(long long));
+
+            Valid = (Offset >= 0) && (Length > 0) && (Offset + Length <= imagesize) &&
+                    (Position + (long long)sizeof(long long) * 2 + Length <= Record + Header.Bytes);
+
+            Position = Position + sizeof(long long) * 2 + Length;
+        }
+
+        if(Valid == false)
+        {
+            break;
+        }
+
+        Position = Record;
+        for(i = 0; i < Header.Records; i++)
+        {
+            memcpy(&Offset, Data + Position, sizeof(long long));
+            memcpy(&Length, Data + Position + sizeof(long long), sizeof(long long));
+
+            memcpy(base + Offset, Data + Position + sizeof(long long) * 2, Length);
+            JournalMarkPages(journal, Offset, Length);
+
+            Position = Position + sizeof(long long) * 2 + Length;
+        }
+
+        journal->Sequence = Header.Sequence + 1;
+        Count++;
+    }
+
+    CvfsFree(Data, Size);
+
+    journal->Replayed = Count;
+
+    return Count;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :     HashFileName
+//  Description :       Calculates FNV-1a hash of the file name, started from
+//                      the number of its directory. It is used to select the
+//                      home slot of file in the name index, so equal names
+//                      of different directories land in different slots.
+//  Input :             parent -> Inode of directory, ROOTDIRECTORY for root
+//                      name   -> File name
+//  Output :            32 bit hash value
+//  Author :            Omkar Sachin Naralwar
+//  Date :              16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+unsigned int HashFileName(
+                            int parent,             //  Directory of file
+                            const char *name        //  File name
+                        )
+{
+    unsigned int hash = (2166136261u ^ (unsigned int)parent) * 16777619u;
+
+    while(*name != '\0')
+    {
+        hash = hash ^ (unsigned char)(*name);
+        hash = hash * 16777619u;
+        name++;
+    }
+
+    return hash;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :     NameIndexCapacity
+//  Description :       Calculates the number of slots of the name index. It is
+//                      the smallest power of 2 which is at least NAMEINDEX_LOAD
+//                      times the number of files, so probe chains stay short.
+//  Input :             count -> Maximum number of files stored in index
+//  Output :            Number of slots
+//  Author :            Omkar Sachin Naralwar
+//  Date :              16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+unsigned int NameIndexCapacity(
+                                int count
+                            )
+{
+    unsigned int Capacity = 8;
+
+    while(Capacity < (unsigned int)count * NAMEINDEX_LOAD)
+    {
+        Capacity = Capacity * 2;
+    }
+
+    return Capacity;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :     NameIndexCreate
+//  Description :       Allocates slots of a private name index (used by the
+//                      benchmark). Index of file system lives in the image.
+//  Input :             index -> Name index to initialise
+//                      count -> Maximum number of files stored in index
+//                      table -> Inode table which the index refers
+//  Output :            true on success, false if memory is not available
+//  Author :            Omkar Sachin Naralwar
+//  Date :              16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+bool NameIndexCreate(
+                        PNAMEINDEX index,
+                        int count,
+                        PINODE table
+                    )
+{
+    unsigned int Capacity = NameIndexCapacity(count);
+
+    index->Slots = (struct NameIndexEntry *)CvfsAlloc(Capacity * sizeof(struct NameIndexEntry));
+    if(index->Slots == NULL)
+    {
+        return false;
+    }
+
+    memset(index->Slots, 0, Capacity * sizeof(struct NameIndexEntry));
+
+    index->Mask = Capacity - 1;
+    index->Count = 0;
+    index->Table = table;
+
+    return true;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :     NameIndexDestroy
+//  Description :       Releases the slots of the name index.
+//  Input :             index -> Name index to release
+//  Author :            Omkar Sachin Naralwar
+//  Date :              16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+void NameIndexDestroy(
+                        PNAMEINDEX index
+                    )
+{
+    CvfsFree(index->Slots, (index->Mask + 1) * sizeof(struct NameIndexEntry));
+    index->Slots = NULL;
+    index->Mask = 0;
+    index->Count = 0;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :     NameIndexLookup
+//  Description :       Searches the inode of given file name using linear
+//                      probing from its home slot. Probing stops at the first
+//                      empty slot.
+//  Input :             index  -> Name index
+//                      parent -> Directory which holds the file
+//                      name   -> File name to be searched
+//  Output :            Address of inode if file is present, NULL otherwise
+//  Author :            Omkar Sachin Naralwar
+//  Date :              16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+PINODE NameIndexLookup(
+                        PNAMEINDEX index,
+                        int parent,
+                        const char *name
+                    )
+{
+    unsigned int hash = HashFileName(parent, name);
+    unsigned int i = hash & index->Mask;
+    PINODE temp = NULL;
+
+    while(index->Slots[i].InodeNumber != 0)
+    {
+        temp = &index->Table[index->Slots[i].InodeNumber - 1];
+
+        if((index->Slots[i].Hash == hash) && (temp->Parent == parent) && (strcmp(temp->FileName, name) == 0))
+        {
+            return &index->Table[index->Slots[i].InodeNumber - 1];
+        }
+        i = (i + 1) & index->Mask;
+    }
+
+    return NULL;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :     NameIndexInsert
+//  Description :       Adds the inode into the name index using its Parent
+//                      and FileName. Caller makes sure that name is not
+//                      already present in that directory.
+//  Input :             index    -> Name index
+//                      ptrinode -> Inode whose Parent and FileName are set
+//  Author :            Omkar Sachin Naralwar
+//  Date :              16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+void NameIndexInsert(
+                        PNAMEINDEX index,
+                        PINODE ptrinode
+                    )
+{
+    unsigned int hash = HashFileName(ptrinode->Parent, ptrinode->FileName);
+    unsigned int i = hash & index->Mask;
+
+    while(index->Slots[i].InodeNumber != 0)
+    {
+        i = (i + 1) & index->Mask;
+    }
+
+    index->Slots[i].Hash = hash;
+    index->Slots[i].InodeNumber = ptrinode->InodeNumber;
+    index->Count++;
+
+    JournalDirty(&index->Slots[i], sizeof(index->Slots[i]));
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :     NameIndexRemove
+//  Description :       Removes the entry of given file name from the index.
+//                      Instead of leaving a tombstone, following entries of
+//                      the same probe chain are shifted back so that lookup
+//                      cost does not degrade under create/unlink churn.
+//  Input :             index  -> Name index
+//                      parent -> Directory which holds the file
+//                      name   -> File name to be removed
+//  Output :            true if entry was removed, false if it was not present
+//  Author :            Omkar Sachin Naralwar
+//  Date :              16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+bool NameIndexRemove(
+                        PNAMEINDEX index,
+                        int parent,
+                        const char *name
+                    )
+{
+    unsigned int hash = HashFileName(parent, name);
+    unsigned int i = hash & index->Mask;
+    unsigned int j = 0;
+    unsigned int home = 0;
+    PINODE temp = NULL;
+
+    //  Locate the slot of file
+    while(index->Slots[i].InodeNumber != 0)
+    {
+        temp = &index->Table[index->Slots[i].InodeNumber - 1];
+
+        if((index->Slots[i].Hash == hash) && (temp->Parent == parent) && (strcmp(temp->FileName, name) == 0))
+        {
+            break;
+        }
+        i = (i + 1) & index->Mask;
+    }
+
+    if(index->Slots[i].InodeNumber == 0)
+    {
+        return false;
+    }
+
+    //  Backward shift deletion
+    j = i;
+    while(1)
+    {
+        j = (j + 1) & index->Mask;
+
+        if(index->Slots[j].InodeNumber == 0)
+        {
+            break;
+        }
+
+        home = index->Slots[j].Hash & index->Mask;
+
+        //  Entry at j may move to i only if i lies on its probe path
+        if(((j - home) & index->Mask) >= ((j - i) & index->Mask))
+        {
+            index->Slots[i] = index->Slots[j];
+            JournalDirty(&index->Slots[i], sizeof(index->Slots[i]));
+            i = j;
+        }
+    }
+
+    index->Slots[i].InodeNumber = 0;
+    index->Slots[i].Hash = 0;
+    index->Count--;
+
+    JournalDirty(&index->Slots[i], sizeof(index->Slots[i]));
+
+    return true;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :     OrderNodeCreate
+//  Description :       Allocates a node of the ordered index. Its number of
+//                      levels is taken from a mixed counter : every level is
+//                      kept with probability 1 / 2^ORDERLEVELBITS. Counter is
+//                      advanced atomically, so the node may be allocated
+//                      before NamespaceLock is taken.
+//  Input :             index -> Ordered index which will hold the node
+//  Output :            New node, NULL if memory is not available
+//  Author :            Omkar Sachin Naralwar
+//  Date :              16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+struct OrderNode * OrderNodeCreate(
+                                    PORDERINDEX index
+                                )
+{
+    struct OrderNode *node = NULL;
+    unsigned long long x = __atomic_add_fetch(&index->Seed, 0x9E3779B97F4A7C15ull, __ATOMIC_RELAXED);
+    int Levels = 1;
+
+    //  splitmix64 finaliser, trailing zero bits decide the level
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    x = x ^ (x >> 31);
+
+    Levels = 1 + (__builtin_ctzll(x | (1ull << 63)) / ORDERLEVELBITS);
+    if(Levels > ORDERMAXLEVEL)
+    {
+        Levels = ORDERMAXLEVEL;
+    }
+
+    node = (struct OrderNode *)CvfsAlloc(sizeof(struct OrderNode) + ((Levels - 1) * sizeof(struct OrderNode *)));
+    if(node == NULL)
+    {
+        return NULL;
+    }
+
+    node->InodeNumber = 0;
+    node->Levels = Levels;
+
+    return node;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :     OrderNodeFree
+//  Description :       Releases a node of the ordered index.
+//  Input :             node -> Node from OrderNodeCreate(), may be NULL
+//  Author :            Omkar Sachin Naralwar
+//  Date :              16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+void OrderNodeFree(
+                    struct OrderNode *node
+                )
+{
+    if(node != NULL)
+    {
+        CvfsFree(node, sizeof(struct OrderNode) + ((node->Levels - 1) * sizeof(struct OrderNode *)));
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :     OrderCompare
+//  Description :       Compares key of an inode with (parent, name). Parent
+//                      is compared first, so entries of a directory are
+//                      adjacent, then names byte by byte.
+//  Input :             ptrinode -> Inode of a node
+//                      parent   -> Directory of key
+//                      name     -> Name of key
+//  Output :            Negative, 0 or positive as inode sorts before, equal
+//                      to or after the key
+//  Author :            Omkar Sachin Naralwar
+//  Date :              16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+int OrderCompare(
+                    PINODE ptrinode,
+                    int parent,
+                    const char *name
+                )
+{
+    if(ptrinode->Parent != parent)
+    {
+        return (ptrinode->Parent < parent) ? -1 : 1;
+    }
+
+    return strcmp(ptrinode->FileName, name);
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :     OrderIndexSeek
+//  Description :       Finds the first node whose key is not below (or with
+//                      after, above) given key, going down from the highest
+//                      level, so about log n nodes are visited.
+//  Input :             index  -> Ordered index
+//                      parent -> Directory of key
+//                      name   -> Name of key
+//                      after  -> true to skip a node equal to key
+//                      path   -> NULL, or array of ORDERMAXLEVEL entries which
+//                                receives last node before the result at every
+//                                level in use (NULL for the head)
+//  Output :            Node found, NULL if every key is below given key
+//  Author :            Omkar Sachin Naralwar
+//  Date :              16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+struct OrderNode * OrderIndexSeek(
+                                    PORDERINDEX index,
+                                    int parent,
+                                    const char *name,
+                                    bool after,
+                                    struct OrderNode **path
+                                )
+{
+    struct OrderNode **Next = index->Head;
+    struct OrderNode *prev = NULL;
+    int level = 0;
+    int c = 0;
+
+    for(level = index->Levels - 1; level >= 0; level--)
+    {
+        while(Next[level] != NULL)
+        {
+            c = OrderCompare(&index->Table[Next[level]->InodeNumber - 1], parent, name);
+
+            if((c > 0) || ((c == 0) && (after == false)))
+            {
+                break;
+            }
+
+            prev = Next[level];
+            Next = prev->Next;
+        }
+
+        if(path != NULL)
+        {
+            path[level] = prev;
+        }
+    }
+
+    return Next[0];
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :     OrderIndexInsert
+//  Description :       Links a node for the inode at its sorted position.
+//                      Caller makes sure that name is not already present.
+//  Input :             index    -> Ordered index
+//                      node     -> Node from OrderNodeCreate()
+//                      ptrinode -> Inode whose Parent and FileName are set
+//  Author :            Omkar Sachin Naralwar
+//  Date :              16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+void OrderIndexInsert(
+                        PORDERINDEX index,
+                        struct OrderNode *node,
+                        PINODE ptrinode
+                    )
+{
+    struct OrderNode *path[ORDERMAXLEVEL] = {NULL};
+    struct OrderNode **Link = NULL;
+    int level = 0;
+
+    OrderIndexSeek(index, ptrinode->Parent, ptrinode->FileName, false, path);
+
+    node->InodeNumber = ptrinode->InodeNumber;
+
+    for(level = 0; level < node->Levels; level++)
+    {
+        Link = (path[level] == NULL) ? &index->Head[level] : &path[level]->Next[level];
+        node->Next[level] = *Link;
+        *Link = node;
+    }
+
+    if(node->Levels > index->Levels)
+    {
+        index->Levels = node->Levels;
+    }
+
+    index->Count++;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :     OrderIndexRemove
+//  Description :       Unlinks and releases the node of given file.
+//  Input :             index  -> Ordered index
+//                      parent -> Directory which holds the file
+//                      name   -> File name to be removed
+//  Output :            true if node was removed, false if it was not present
+//  Author :            Omkar Sachin Naralwar
+//  Date :              16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+bool OrderIndexRemove(
+                        PORDERINDEX index,
+                        int parent,
+                        const char *name
+                    )
+{
+    struct OrderNode *path[ORDERMAXLEVEL] = {NULL};
+    struct OrderNode *node = OrderIndexSeek(index, parent, name, false, path);
+    struct OrderNode **Link = NULL;
+    int level = 0;
+
+    if((node == NULL) || (OrderCompare(&index->Table[node->InodeNumber - 1], parent, name) != 0))
+    {
+        return false;
+    }
+
+    for(level = 0; level < node->Levels; level++)
+    {
+        Link = (path[level] == NULL) ? &index->Head[level] : &path[level]->Next[level];
+        *Link = node->Next[level];
+    }
+
+    while((index->Levels > 0) && (index->Head[index->Levels - 1] == NULL))
+    {
+        index->Levels--;
+    }
+
+    index->Count--;
+    OrderNodeFree(node);
+
+    return true;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :     OrderIndexBuild
+//  Description :       Fills an empty ordered index with every named inode
+//                      of its table. Used when an image is mounted, before
+//                      the image becomes the current file system.
+//  Input :             index -> Ordered index whose Table is set
+//                      core  -> Hot fields of inodes of Table
+//                      count -> Number of inodes in Table
+//  Output :            true on success, false if memory is not available
+//                      (index is left empty)
+//  Author :            Omkar Sachin Naralwar
+//  Date :              16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+bool OrderIndexBuild(
+                        PORDERINDEX index,
+                        PINODECORE core,
+                        int count
+                    )
+{
+    struct OrderNode *node = NULL;
+    int i = 0;
+
+    for(i = 0; i < count; i++)
+    {
+        if((core[i].FileType == 0) || (index->Table[i].FileName[0] == '\0'))
+        {
+            continue;
+        }
+
+        node = OrderNodeCreate(index);
+        if(node == NULL)
+        {
+            OrderIndexDestroy(index);
+            return false;
+        }
+
+        OrderIndexInsert(index, node, &index->Table[i]);
+    }
+
+    return true;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :     OrderIndexDestroy
+//  Description :       Releases every node of the ordered index.
+//  Input :             index -> Ordered index to be emptied
+//  Author :            Omkar Sachin Naralwar
+//  Date :              16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+void OrderIndexDestroy(
+                        PORDERINDEX index
+                    )
+{
+    struct OrderNode *node = index->Head[0];
+    struct OrderNode *next = NULL;
+
+    while(node != NULL)
+    {
+        next = node->Next[0];
+        OrderNodeFree(node);
+        node = next;
+    }
+
+    memset(index->Head, 0, sizeof(index->Head));
+    index->Levels = 0;
+    index->Count = 0;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :     WalkPath
+//  Description :       Resolves a path one component at a time, each with one
+//                      probe of the name index keyed by (directory, name).
+//                      Path starting with PATHSEPARATOR starts at root, any
+//                      other at working directory of session. "." and ".."
+//                      are followed without a probe. Caller holds
+//                      NamespaceLock.
+//  Input :             path   -> Path to be resolved
+//                      number -> Receives inode of file (ROOTDIRECTORY for
+//                                root), or of its directory if leaf is given
+//                      leaf   -> NULL to resolve whole path, otherwise buffer
+//                                of MAXFILENAME bytes which receives the last
+//                                component, left to caller to create or remove
+//  Output :            EXECUTE_SUCCESS, ERR_FILE_NOT_EXIST if a component is
+//                      missing, ERR_NOT_DIRECTORY if a file is used as
+//                      directory, ERR_INVALID_PARAMETER if a component is too
+//                      long or leaf is asked for a path without one
+//  Author :            Omkar Sachin Naralwar
+//  Date :              16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+int WalkPath(
+                const char *path,
+                int *number,
+                char *leaf
+            )
+{
+    char Name[MAXFILENAME];
+    PINODE temp = NULL;
+    int dir = ROOTDIRECTORY;
+    int Length = 0;
+
+    if((path == NULL) || (path[0] == '\0'))
+    {
+        return ERR_INVALID_PARAMETER;
+    }
+
+    if(path[0] != PATHSEPARATOR)
+    {
+        dir = CurrentUArea->Cwd;
+    }
+
+    while(*path == PATHSEPARATOR)
+    {
+        path++;
+    }
+
+    while(*path != '\0')
+    {
+        Length = 0;
+        while((path[Length] != '\0') && (path[Length] != PATHSEPARATOR))
+        {
+            Length++;
+        }
+
+        if(Length >= MAXFILENAME)
+        {
+            return ERR_INVALID_PARAMETER;
+        }
+
+        memcpy(Name, path, Length);
+        Name[Length] = '\0';
+
+        path = path + Length;
+        while(*path == PATHSEPARATOR)
+        {
+            path++;
+        }
+
+        //  Last component is created or removed by caller
+        if((leaf != NULL) && (*path == '\0'))
+        {
+            if((strcmp(Name, ".") == 0) || (strcmp(Name, "..") == 0))
+            {
+                return ERR_INVALID_PARAMETER;
+            }
+
+            strcpy(leaf, Name);
+            *number = dir;
+            return EXECUTE_SUCCESS;
+        }
+
+        if(strcmp(Name, ".") == 0)
+        {
+            continue;
+        }
+
+        //  Parent of root is root
+        if(strcmp(Name, "..") == 0)
+        {
+            if(dir != ROOTDIRECTORY)
+            {
+                dir = DILB[dir - 1].Parent;
+            }
+            continue;
+        }
+
+        temp = NameIndexLookup(&indexobj, dir, Name);
+
+        if(temp == NULL)
+        {
+            return ERR_FILE_NOT_EXIST;
+        }
+
+        if((*path != '\0') && (CoreOf(temp)->FileType != DIRECTORYFILE))
+        {
+            return ERR_NOT_DIRECTORY;
+        }
+
+        dir = temp->InodeNumber;
+    }
+
+    //  Path names a directory without a last component, like "/" or ".."
+    if(leaf != NULL)
+    {
+        return ERR_INVALID_PARAMETER;
+    }
+
+    *number = dir;
+
+    return EXECUTE_SUCCESS;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :     AddDirectoryEntry
+//  Description :       Changes the number of entries of a directory, which
+//                      is kept in its ActualFileSize, so rmdir knows whether
+//                      it is empty without a scan. Root has no inode and its
+//                      entries are not counted. Caller holds NamespaceLock
+//                      and the journal.
+//  Input :             directory -> Inode of directory
+//                      change    -> 1 for a new entry, -1 for a removed one
+//  Author :            Omkar Sachin Naralwar
+//  Date :              16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+void AddDirectoryEntry(
+                        int directory,
+                        int change
+                    )
+{
+    if(directory == ROOTDIRECTORY)
+    {
+        return;
+    }
+
+    DILBCore[directory - 1].ActualFileSize = DILBCore[directory - 1].ActualFileSize + change;
+    JournalDirty(&DILBCore[directory - 1], sizeof(INODECORE));
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :     HoldDirectory
+//  Description :       Takes a reference of a directory for a session which
+//                      uses it as working directory, so that it is not
+//                      removed. Caller holds NamespaceLock.
+//  Input :             directory -> Inode of directory
+//  Author :            Omkar Sachin Naralwar
+//  Date :              16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+void HoldDirectory(
+                    int directory
+                )
+{
+    if(directory != ROOTDIRECTORY)
+    {
+        DILBCore[directory - 1].ReferenceCount++;
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :     ReleaseDirectory
+//  Description :       Drops the reference taken by HoldDirectory().
+//                      Caller holds NamespaceLock.
+//  Input :             directory -> Inode of directory
+//  Author :            Omkar Sachin Naralwar
+//  Date :              16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+void ReleaseDirectory(
+                        int directory
+                    )
+{
+    if(directory != ROOTDIRECTORY)
+    {
+        DILBCore[directory - 1].ReferenceCount--;
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :     BuildDescriptorMap
+//  Description :       Allocates the descriptor bitmap of a session for given
+//                      capacity and fills it from UFDT. Bits of upper levels
+//                      which do not cover any word below are set, so that
+//                      they are never taken as free.
+//                      Caller holds FdLock of session (or owns it alone).
+//  Input :             uarea    -> Session
+//                      table    -> UFDT which the bitmap describes
+//                      capacity -> Entries in table, multiple of FDWORDBITS
+//  Output :            true on success, false if memory is not available
+//  Author :            Omkar Sachin Naralwar
+//  Date :              16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+bool BuildDescriptorMap(
+                            PUAREA uarea,
+                            PFILETABLE *table,
+                            int capacity
+                        )
+{
+    unsigned long long *Bits = NULL;
+    int Words[FDMAXLEVELS];
+    int Depth = 0;
+    int Total = 0;
+    int Level = 0;
+    int i = 0;
+    int Child = 0;
+
+    //  Words of every level, last level has a single word
+    Words[0] = capacity / FDWORDBITS;
+    Total = Words[0];
+    Depth = 1;
+
+    while(Words[Depth - 1] > 1)
+    {
+        Words[Depth] = (Words[Depth - 1] + FDWORDBITS - 1) / FDWORDBITS;
+        Total = Total + Words[Depth];
+        Depth++;
+    }
+
+    Bits = (unsigned long long *)CvfsAlloc(Total * sizeof(unsigned long long));
+
+    if(Bits == NULL)
+    {
+        return false;
+    }
+
+    memset(Bits, 0, Total * sizeof(unsigned long long));
+
+    CvfsFree(uarea->FdBits, uarea->FdBitsWords * sizeof(unsigned long long));
+
+    uarea->FdBits = Bits;
+    uarea->FdBitsWords = Total;
+    uarea->FdDepth = Depth;
+
+    for(Level = 0; Level < Depth; Level++)
+    {
+        uarea->FdLevel[Level] = Bits;
+        uarea->FdWords[Level] = Words[Level];
+        Bits = Bits + Words[Level];
+    }
+
+    //  Level 0 from UFDT
+    for(i = 0; i < capacity; i++)
+    {
+        if((i < FDRESERVED) || (table[i] != NULL))
+        {
+            uarea->FdLevel[0][i / FDWORDBITS] |= (1ULL << (i % FDWORDBITS));
+        }
+    }
+
+    //  Upper levels from the level below
+    for(Level = 1; Level < Depth; Level++)
+    {
+        for(i = 0; i < Words[Level] * FDWORDBITS; i++)
+        {
+            Child = i;
+
+            if((Child >= Words[Level - 1]) || (uarea->FdLevel[Level - 1][Child] == ~0ULL))
+            {
+                uarea->FdLevel[Level][i / FDWORDBITS] |= (1ULL << (i % FDWORDBITS));
+            }
+        }
+    }
+
+    return true;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :     FindFreeDescriptor
+//  Description :       Returns the lowest free descriptor of a session. One
+//                      word is read on every level of the bitmap, so the
+//                      cost does not depend on number of open files.
+//                      Caller holds FdLock of session.
+//  Input :             uarea -> Session
+//  Output :            Descriptor, -1 if UFDT is full
+//  Author :            Omkar Sachin Naralwar
+//  Date :              16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+int FindFreeDescriptor(
+                        PUAREA uarea
+                    )
+{
+    unsigned long long Word = 0;
+    int Level = 0;
+    int Index = 0;
+
+    for(Level = uarea->FdDepth - 1; Level >= 0; Level--)
+    {
+        Word = uarea->FdLevel[Level][Index];
+
+        if(Word == ~0ULL)
+        {
+            return -1;
+        }
+
+        Index = (Index * FDWORDBITS) + __builtin_ctzll(~Word);
+    }
+
+    return Index;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :     MarkDescriptor
+//  Description :       Sets or clears the bit of a descriptor. Change is
+//                      carried to upper levels only while a word turns
+//                      full or stops being full.
+//                      Caller holds FdLock of session.
+//  Input :             uarea -> Session
+//                      fd    -> Descriptor
+//                      used  -> true when descriptor gets used
+//  Author :            Omkar Sachin Naralwar
+//  Date :              16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+void MarkDescriptor(
+                        PUAREA uarea,
+                        int fd,
+                        bool used
+                    )
+{
+    unsigned long long *Word = NULL;
+    unsigned long long Bit = 0;
+    bool WasFull = false;
+    int Level = 0;
+    int Index = fd;
+
+    for(Level = 0; Level < uarea->FdDepth; Level++)
+    {
+        Word = &uarea->FdLevel[Level][Index / FDWORDBITS];
+        Bit = 1ULL << (Index % FDWORDBITS);
+        WasFull = (*Word == ~0ULL);
+
+        if(used == true)
+        {
+            *Word |= Bit;
+
+            if(*Word != ~0ULL)
+            {
+                break;
+            }
+        }
+        else
+        {
+            *Word &= ~Bit;
+
+            if(WasFull == false)
+            {
+                break;
+            }
+        }
+
+        Index = Index / FDWORDBITS;
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :     GrowDescriptors
+//  Description :       Doubles the UFDT of a session. New array is published
+//                      before the new capacity, so lock free readers never
+//                      index past the array they see. Old array is retired,
+//                      not released, as readers may still hold it.
+//                      Caller holds FdLock of session (or owns it alone).
+//  Input :             uarea -> Session
+//  Output :            EXECUTE_SUCCESS on success
+//                      ERR_MAX_FILES_OPEN if UFDT has MAXDESCRIPTORS entries
+//                      ERR_NO_MEMORY if memory is not available
+//  Author :            Omkar Sachin Naralwar
+//  Date :              16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+int GrowDescriptors(
+                        PUAREA uarea
+                    )
+{
+    PFILETABLE *Old = uarea->UFDT;
+    PFILETABLE *UFDT = NULL;
+    int Capacity = 2 * uarea->Capacity;
+
+    if((Capacity > MAXDESCRIPTORS) || (uarea->RetiredCount == FDMAXGROWTH))
+    {
+        return ERR_MAX_FILES_OPEN;
+    }
+
+    UFDT = (PFILETABLE *)CvfsAlloc(Capacity * sizeof(PFILETABLE));
+
+    if(UFDT == NULL)
+    {
+        return ERR_NO_MEMORY;
+    }
+
+    memset(UFDT, 0, Capacity * sizeof(PFILETABLE));
+    memcpy(UFDT, Old, uarea->Capacity * sizeof(PFILETABLE));
+
+    if(BuildDescriptorMap(uarea, UFDT, Capacity) == false)
+    {
+        CvfsFree(UFDT, Capacity * sizeof(PFILETABLE));
+        return ERR_NO_MEMORY;
+    }
+
+    __atomic_store_n(&uarea->UFDT, UFDT, __ATOMIC_RELEASE);
+    __atomic_store_n(&uarea->Capacity, Capacity, __ATOMIC_RELEASE);
+
+    uarea->Retired[uarea->RetiredCount] = Old;
+    uarea->RetiredCount++;
+
+    return EXECUTE_SUCCESS;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :     InitialiseDescriptors
+//  Description :       Gives a session an empty UFDT of MAXOPENFILES entries
+//                      and its bitmap. Descriptors 0 1 2 are marked used.
+//  Input :             uarea -> Session
+//  Output :            true on success, false if memory is not available
+//  Author :            Omkar Sachin Naralwar
+//  Date :              16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+bool InitialiseDescriptors(
+                            PUAREA uarea
+                        )
+{
+    uarea->UFDT = (PFILETABLE *)CvfsAlloc(MAXOPENFILES * sizeof(PFILETABLE));
+
+    if(uarea->UFDT == NULL)
+    {
+        return false;
+    }
+
+    memset(uarea->UFDT, 0, MAXOPENFILES * sizeof(PFILETABLE));
+
+    uarea->Capacity = MAXOPENFILES;
+    uarea->OpenCount = 0;
+    uarea->FdBits = NULL;
+    uarea->FdBitsWords = 0;
+    uarea->RetiredCount = 0;
+
+    if(BuildDescriptorMap(uarea, uarea->UFDT, MAXOPENFILES) == false)
+    {
+        CvfsFree(uarea->UFDT, MAXOPENFILES * sizeof(PFILETABLE));
+        uarea->UFDT = NULL;
+        uarea->Capacity = 0;
+        return false;
+    }
+
+    pthread_mutex_init(&uarea->FdLock, NULL);
+
+    return true;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :     DestroyDescriptors
+//  Description :       Releases UFDT, retired arrays and bitmap of a session
+//                      whose descriptors are all released.
+//  Input :             uarea -> Session
+//  Author :            Omkar Sachin Naralwar
+//  Date :              16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+void DestroyDescriptors(
+                        PUAREA uarea
+                    )
+{
+    int i = 0;
+
+    for(i = 0; i < uarea->RetiredCount; i++)
+    {
+        CvfsFree(uarea->Retired[i], (MAXOPENFILES << i) * sizeof(PFILETABLE));
+    }
+
+    CvfsFree(uarea->UFDT, uarea->Capacity * sizeof(PFILETABLE));
+    CvfsFree(uarea->FdBits, uarea->FdBitsWords * sizeof(unsigned long long));
+
+    pthread_mutex_destroy(&uarea->FdLock);
+
+    uarea->UFDT = NULL;
+    uarea->FdBits = NULL;
+    uarea->Capacity = 0;
+    uarea->FdBitsWords = 0;
+    uarea->RetiredCount = 0;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :     InitialiseUAREA
+//  Description :       This function prepares the UAREA (User Area) structure for use.
+//                      It sets the default process name and marks all entries in the
+//                      User File Descriptor Table (UFDT) as NULL, which means no files
+//                      are opened at the start of the system.
+//                      It is called once during system boot.
+//  Effect :            - Sets process name to "Myexe"
+//                      - Makes all UFDT entries empty (no open files)
+//                      - Registers it as session 1 of the session table
+//  Output :            true on success, false if memory is not available
+//  Author :            Omkar Sachin Narlawar
+//  Date :              13/01/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+bool InitialiseUAREA()
+{
+    strcpy(uareaobj.ProcessName,"Myexe");
+
+    //  No file opened initially
+    if(InitialiseDescriptors(&uareaobj) == false)
+    {
+        return false;
+    }
+
+    //  Shell is the first session
+    memset(&sessionobj, 0, sizeof(sessionobj));
+    sessionobj.Sessions = (PUAREA *)CvfsAlloc(sizeof(PUAREA));
+    if(sessionobj.Sessions == NULL)
+    {
+        return false;
+    }
+
+    sessionobj.Sessions[0] = &uareaobj;
+    sessionobj.Capacity = 1;
+    sessionobj.Count = 1;
+
+    uareaobj.SessionId = 1;
+    CurrentUArea = &uareaobj;
+
+    return true;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         LayoutImage
+//  Description :           Calculates offset of every area of the image and
+//                          the image size from inode count, block size and
+//                          block count of the given super block.
+//  Input :                 super -> Super block whose counts are set
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+void LayoutImage(
+                    struct SuperBlock *super
+                )
+{
+    long long Offset = HEADERSIZE;
+    long long PageSize = sysconf(_SC_PAGESIZE);
+
+    super->IndexCapacity = NameIndexCapacity(super->TotalInodes);
+    super->DedupCapacity = NameIndexCapacity(super->TotalBlocks);
+
+    super->FreeInodeOffset = Offset;
+    Offset = AlignUp(Offset + ((long long)super->TotalInodes * sizeof(int)), CACHELINE);
+
+    super->FreeBlockOffset = Offset;
+    Offset = AlignUp(Offset + ((long long)super->TotalBlocks * sizeof(int)), CACHELINE);
+
+    super->RecordOffset = Offset;
+    Offset = AlignUp(Offset + ((long long)super->TotalBlocks * sizeof(BLOCKRECORD)), CACHELINE);
+
+    super->DedupOffset = Offset;
+    Offset = AlignUp(Offset + ((long long)super->DedupCapacity * sizeof(struct DedupEntry)), CACHELINE);
+
+    super->IndexOffset = Offset;
+    Offset = AlignUp(Offset + ((long long)super->IndexCapacity * sizeof(struct NameIndexEntry)), CACHELINE);
+
+    super->CoreOffset = Offset;
+    Offset = AlignUp(Offset + ((long long)super->TotalInodes * sizeof(INODECORE)), CACHELINE);
+
+    super->DILBOffset = Offset;
+    Offset = Offset + ((long long)super->TotalInodes * sizeof(INODE));
+
+    super->DataOffset = AlignUp(AlignUp(Offset, PageSize), super->BlockSize);
+    super->ImageSize = super->DataOffset + ((long long)super->TotalBlocks * super->BlockSize);
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         InitialiseSuperBlock
+//  Description :           This function initializes the SuperBlock which keeps
+//                          track of total and free inodes (files) in the file
+//                          system.
+//                          At the beginning all inodes and blocks are free.
+//                          It also decides the layout of the image :
+//
+//                          +------------------------------+  0
+//                          | BootBlock                    |
+//                          | SuperBlock                   |  SUPERBLOCKOFFSET
+//                          | Snapshot records             |  SNAPSHOTOFFSET
+//                          +------------------------------+  HEADERSIZE
+//                          | Free inode stack             |
+//                          | Free block stack             |
+//                          | Block records (refcounts)    |
+//                          | Dedup index                  |
+//                          | Name index                   |
+//                          | DILBCore (hot inode fields)  |
+//                          | DILB (cold inode fields)     |
+//                          +------------------------------+  DataOffset
+//                          | Data blocks                  |
+//                          +------------------------------+  ImageSize
+//
+//                          Areas are cache line aligned and data blocks start
+//                          at a page and block size boundary.
+//  Input :                 count      -> Number of inodes in the file system
+//                          blocksize  -> Bytes in one data block
+//                          blockcount -> Number of data blocks
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  13/01/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+void InitialiseSuperBlock(
+                            int count,
+                            int blocksize,
+                            int blockcount
+                        )
+{
+    memset(&superobj, 0, sizeof(superobj));
+
+    superobj.TotalInodes = count;
+    superobj.FreeInodes = 0;
+
+    superobj.BlockSize = blocksize;
+    superobj.TotalBlocks = blockcount;
+    superobj.FreeBlocks = 0;
+
+    superobj.State = STATE_DIRTY;
+    superobj.InlineSize = INLINEDATASIZE;
+
+    LayoutImage(&superobj);
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         AttachImage
+//  Description :           Points the global tables (free lists, block
+//                          records, name and dedup index, inode tables and
+//                          block pool) into the image using
+//                          the offsets recorded in the SuperBlock.
+//  Input :                 base -> Start of image in memory
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+void AttachImage(
+                    char *base
+                )
+{
+    ImageBase = base;
+
+    FreeInodeList = (int *)(base + superobj.FreeInodeOffset);
+    FreeBlockList = (int *)(base + superobj.FreeBlockOffset);
+    BlockRecords = (PBLOCKRECORD)(base + superobj.RecordOffset);
+    Snapshots = (PSNAPSHOT)(base + SNAPSHOTOFFSET);
+    DILBCore = (PINODECORE)(base + superobj.CoreOffset);
+    DILB = (PINODE)(base + superobj.DILBOffset);
+    BlockPool = base + superobj.DataOffset;
+
+    //  Block size is a power of 2, offsets are split with shift and mask
+    BlockShift = __builtin_ctz(superobj.BlockSize);
+
+    indexobj.Slots = (struct NameIndexEntry *)(base + superobj.IndexOffset);
+    indexobj.Mask = superobj.IndexCapacity - 1;
+    indexobj.Count = superobj.TotalInodes - superobj.FreeInodes;
+    indexobj.Table = DILB;
+
+    orderobj.Table = DILB;
+
+    dedupobj.Slots = (struct DedupEntry *)(base + superobj.DedupOffset);
+    dedupobj.Mask = superobj.DedupCapacity - 1;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         CreateInodeLocks
+//  Description :           Allocates and initialises one reader/writer lock
+//                          for every inode of the table.
+//  Input :                 count -> Number of inodes
+//  Output :                Array of locks, NULL if memory is not available
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+struct InodeLock * CreateInodeLocks(
+                                        int count
+                                    )
+{
+    struct InodeLock *Locks = (struct InodeLock *)CvfsAlloc((size_t)count * sizeof(struct InodeLock));
+    int i = 0;
+
+    if(Locks == NULL)
+    {
+        return NULL;
+    }
+
+    for(i = 0; i < count; i++)
+    {
+        pthread_rwlock_init(&Locks[i].Lock, NULL);
+    }
+
+    return Locks;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         DestroyInodeLocks
+//  Description :           Destroys and releases locks of an inode table.
+//  Input :                 Locks -> Array returned by CreateInodeLocks()
+//                          count -> Number of inodes
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+void DestroyInodeLocks(
+                        struct InodeLock *Locks,
+                        int count
+                    )
+{
+    int i = 0;
+
+    if(Locks == NULL)
+    {
+        return;
+    }
+
+    for(i = 0; i < count; i++)
+    {
+        pthread_rwlock_destroy(&Locks[i].Lock);
+    }
+
+    CvfsFree(Locks, (size_t)count * sizeof(struct InodeLock));
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         CreateImage
+//  Description :           Allocates the in-memory image of the size decided by
+//                          InitialiseSuperBlock() and attaches the tables to it.
+//                          The image is zero filled, so every inode is free and
+//                          the name index is empty.
+//  Output :                true on success, false if memory is not available
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+bool CreateImage()
+{
+    char *base = (char *)CvfsAlloc(superobj.ImageSize);
+
+    InodeLocks = CreateInodeLocks(superobj.TotalInodes);
+
+    if((base == NULL) || (InodeLocks == NULL))
+    {
+        return false;
+    }
+
+    memset(base, 0, superobj.ImageSize);
+
+    AttachImage(base);
+
+    return true;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         AllocateInode
+//  Description :           Pops a free inode from the free inode list of the
+//                          super block in constant time. Caller holds
+//                          NamespaceLock, which creat needs anyway to keep
+//                          names unique, so the pop itself takes no lock.
+//  Output :                Address of free inode, NULL if none is left
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+PINODE AllocateInode()
+{
+    if(superobj.FreeInodes == 0)
+    {
+        return NULL;
+    }
+
+    superobj.FreeInodes--;
+
+    return &DILB[FreeInodeList[superobj.FreeInodes] - 1];
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         ReleaseInode
+//  Description :           Pushes the inode back on the free inode list of
+//                          the super block in constant time. Caller holds
+//                          NamespaceLock.
+//  Input :                 ptrinode -> Inode which became free
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+void ReleaseInode(
+                    PINODE ptrinode
+                )
+{
+    FreeInodeList[superobj.FreeInodes] = ptrinode->InodeNumber;
+    JournalDirty(&FreeInodeList[superobj.FreeInodes], sizeof(int));
+    superobj.FreeInodes++;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         CreateDILB
+//  Description :           This function creates the Disk Inode List Block (DILB)
+//                          as a contiguous table of inodes inside the image.
+//                          Each inode represents a possible file. Initially
+//                          all inodes are marked as free and have no data.
+//                          Hot fields (type, size, refcount) live in DILBCore
+//                          and the rest in DILB, both aligned to cache line, so
+//                          scans over millions of inodes read memory sequentially.
+//  Effect :                - Numbers the inodes of zero filled table
+//                          - Marks each inode as unused (FileType = 0)
+//                          - Pushes every inode on the free inode list
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  13/01/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+void CreateDILB()
+{
+    int i = 0;
+
+    for(i = 0; i < superobj.TotalInodes; i++)
+    {
+        DILB[i].InodeNumber = i + 1;
+    }
+
+    //  Push in reverse order so that inode 1 is allocated first
+    for(i = superobj.TotalInodes - 1; i >= 0; i--)
+    {
+        ReleaseInode(&DILB[i]);
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         AllocateBlock
+//  Description :           Pops a free data block from the free block list
+//                          of the super block and clears its contents.
+//                          Only the pop is done under BlockLock, so writers
+//                          of different files hold it for a few instructions.
+//                          In ordered mode data of a block reaches the image
+//                          before the transaction which freed it, so blocks
+//                          freed since the last flush are not reused.
+//  Output :                Block number, 0 if pool is exhausted
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+int AllocateBlock()
+{
+    int block = 0;
+    int Stable = 0;
+
+    pthread_mutex_lock(&BlockLock);
+
+    //  Entries below StableFree were free when the last group was flushed
+    Stable = superobj.FreeBlocks;
+    if((journalobj.Fd >= 0) && (journalobj.DataJournal == false) && (journalobj.StableFree < Stable))
+    {
+        Stable = journalobj.StableFree;
+    }
+
+    if(Stable == 0)
+    {
+        pthread_mutex_unlock(&BlockLock);
+        return 0;
+    }
+
+    //  Top of the list fills the hole of the taken entry
+    Stable--;
+    superobj.FreeBlocks--;
+    block = FreeBlockList[Stable];
+
+    if(Stable != superobj.FreeBlocks)
+    {
+        FreeBlockList[Stable] = FreeBlockList[superobj.FreeBlocks];
+        JournalDirty(&FreeBlockList[Stable], sizeof(int));
+    }
+
+    if(journalobj.StableFree > Stable)
+    {
+        journalobj.StableFree = Stable;
+    }
+
+    RecordOf(block)->Hash = 0;
+    RecordOf(block)->Flags = 0;
+    __atomic_store_n(&RecordOf(block)->Refs, 1, __ATOMIC_RELEASE);
+    JournalDirty(RecordOf(block), sizeof(BLOCKRECORD));
+
+    pthread_mutex_unlock(&BlockLock);
+
+    memset(BlockData(block), 0, superobj.BlockSize);
+    JournalData(BlockData(block), superobj.BlockSize);
+
+    return block;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         ReleaseBlock
+//  Description :           Pushes the data block back on the free block list.
+//  Input :                 block -> Block number which became free
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+void ReleaseBlock(
+                    int block
+                )
+{
+    pthread_mutex_lock(&BlockLock);
+
+    FreeBlockList[superobj.FreeBlocks] = block;
+    JournalDirty(&FreeBlockList[superobj.FreeBlocks], sizeof(int));
+    superobj.FreeBlocks++;
+
+    pthread_mutex_unlock(&BlockLock);
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         DropBlock
+//  Description :           Removes one reference of a block. When the last
+//                          reference goes the block leaves the dedup index
+//                          and the decompressed cache, caller then releases
+//                          it (and its children).
+//  Input :                 block -> Block number
+//  Output :                true if block has no reference left
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+bool DropBlock(
+                int block
+            )
+{
+    PBLOCKRECORD Record = RecordOf(block);
+    int Refs = 0;
+
+    pthread_mutex_lock(&BlockLock);
+
+    Refs = __atomic_sub_fetch(&Record->Refs, 1, __ATOMIC_RELEASE);
+
+    if((Refs == 0) && (Record->Hash != 0))
+    {
+        DedupRemove(block);
+    }
+
+    //  Number of a released block may be reused by another cluster
+    if((Refs == 0) && ((Record->Flags & BLOCK_COMPRESSED) != 0))
+    {
+        CacheInvalidate(block);
+    }
+
+    JournalDirty(Record, sizeof(*Record));
+
+    pthread_mutex_unlock(&BlockLock);
+
+    return (Refs == 0);
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         ReleaseBlockTree
+//  Description :           Drops one reference of a block. A block whose last
+//                          reference went is released and, for indirect
+//                          blocks, so are the blocks reachable from it.
+//                          Shared blocks and their children stay.
+//  Input :                 block -> Block number, 0 is ignored
+//                          level -> 0 for data block, 1 for single indirect,
+//                                   2 for double indirect, 3 for triple
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+void ReleaseBlockTree(
+                        int block,
+                        int level
+                    )
+{
+    int i = 0;
+    int *Entries = NULL;
+    int PerBlock = superobj.BlockSize / sizeof(int);
+
+    if((block == 0) || (DropBlock(block) == false))
+    {
+        return;
+    }
+
+    if(level > 0)
+    {
+        Entries = (int *)BlockData(block);
+
+        for(i = 0; i < PerBlock; i++)
+        {
+            ReleaseBlockTree(Entries[i], level - 1);
+        }
+    }
+
+    ReleaseBlock(block);
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Structure Name :        Crc32cTable
+//  Description :           Lookup table of CRC32C for one byte, built at
+//                          compile time. Used when the CPU has no crc32
+//                          instruction.
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+struct Crc32cTable
+{
+    unsigned int Entry[256];
+
+    constexpr Crc32cTable() : Entry()
+    {
+        unsigned int i = 0;
+        unsigned int crc = 0;
+        int bit = 0;
+
+        for(i = 0; i < 256; i++)
+        {
+            crc = i;
+
+            for(bit = 0; bit < 8; bit++)
+            {
+                crc = (crc >> 1) ^ ((crc & 1) ? CRC32C_POLY : 0);
+            }
+
+            Entry[i] = crc;
+        }
+    }
+};
+
+static constexpr Crc32cTable Crc32cTableobj;
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         Crc32cSoftware
+//  Description :           Calculates CRC32C of a buffer one byte at a time.
+//  Input :                 data   -> Bytes to hash
+//                          length -> Number of bytes
+//  Output :                CRC32C value
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+unsigned int Crc32cSoftware(
+                                const char *data,
+                                size_t length
+                            )
+{
+    unsigned int crc = 0xFFFFFFFFu;
+    size_t i = 0;
+
+    for(i = 0; i < length; i++)
+    {
+        crc = Crc32cTableobj.Entry[(crc ^ (unsigned char)data[i]) & 0xFF] ^ (crc >> 8);
+    }
+
+    return ~crc;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         Crc32cMultiply
+//  Description :           Multiplies two polynomials modulo CRC32C_POLY in
+//                          the bit reflected form of the crc register, like
+//                          multmodp() of zlib. Multiplying a crc by x^(8n)
+//                          gives the crc after n more zero bytes.
+//  Input :                 a -> First polynomial, x^0 is bit 31
+//                          b -> Second polynomial
+//  Output :                a * b modulo CRC32C_POLY
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+unsigned int Crc32cMultiply(
+                                unsigned int a,
+                                unsigned int b
+                            )
+{
+    unsigned int Product = 0;
+    unsigned int Bit = 0x80000000u;
+
+    for(Bit = 0x80000000u; Bit != 0; Bit = Bit >> 1)
+    {
+        if((a & Bit) != 0)
+        {
+            Product = Product ^ b;
+        }
+
+        b = (b >> 1) ^ ((b & 1) ? CRC32C_POLY : 0);
+    }
+
+    return Product;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         Crc32cPower
+//  Description :           Calculates x^n modulo CRC32C_POLY by squaring.
+//                          Used for fold constants of Crc32cHardware.
+//  Input :                 bits -> Exponent n
+//  Output :                x^n modulo CRC32C_POLY, reflected
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+unsigned int Crc32cPower(
+                            unsigned long long bits
+                        )
+{
+    unsigned int Result = 0x80000000u;     // x^0
+    unsigned int Square = 0x40000000u;     // x^1
+
+    while(bits != 0)
+    {
+        if((bits & 1) != 0)
+        {
+            Result = Crc32cMultiply(Result, Square);
+        }
+
+        Square = Crc32cMultiply(Square, Square);
+        bits = bits >> 1;
+    }
+
+    return Result;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         Crc32cHardware
+//  Description :           Calculates CRC32C of a buffer 8 bytes at a time
+//                          with the SSE4.2 crc32 instruction. The buffer is
+//                          split in three lanes of equal length hashed in
+//                          the same loop, so that the 3 cycle latency of
+//                          the instruction overlaps. A lane is folded into
+//                          the next one by a carry-less multiply with
+//                          x^(8 * lane length - 33), and the 64 bit product
+//                          is reduced by crc32 again. The constant is kept
+//                          for the last lane length, as blocks have one
+//                          size. Tail is hashed in one lane. Returns the
+//                          same value as Crc32cSoftware.
+//  Input :                 data   -> Bytes to hash
+//                          length -> Number of bytes
+//  Output :                CRC32C value
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+#if defined(__x86_64__)
+unsigned long long Crc32cFold = 0;     // Lane length << 32 | its fold constant
+
+__attribute__((target("sse4.2,pclmul")))
+unsigned int Crc32cHardware(
+                                const char *data,
+                                size_t length
+                            )
+{
+    unsigned long long crc = 0xFFFFFFFFu;
+    unsigned long long crc1 = 0;
+    unsigned long long crc2 = 0;
+    unsigned long long word = 0;
+    unsigned long long Fold = 0;
+    __m128i Constant;
+    size_t Lane = (length / 24) * 8;
+    size_t i = 0;
+
+    //  Short buffers and lanes too long for the cache are hashed in one lane
+    if((Lane >= CRC32C_MINLANE) && (Lane <= 0xFFFFFFFFu))
+    {
+        for(i = 0; i < Lane; i = i + 8)
+        {
+            memcpy(&word, data + i, sizeof(word));
+            crc = _mm_crc32_u64(crc, word);
+            memcpy(&word, data + Lane + i, sizeof(word));
+            crc1 = _mm_crc32_u64(crc1, word);
+            memcpy(&word, data + (2 * Lane) + i, sizeof(word));
+            crc2 = _mm_crc32_u64(crc2, word);
+        }
+
+        Fold = __atomic_load_n(&Crc32cFold, __ATOMIC_RELAXED);
+
+        if((Fold >> 32) != Lane)
+        {
+            Fold = ((unsigned long long)Lane << 32) | Crc32cPower((8 * Lane) - 33);
+            __atomic_store_n(&Crc32cFold, Fold, __ATOMIC_RELAXED);
+        }
+
+        Constant = _mm_cvtsi32_si128((int)(unsigned int)Fold);
+
+        word = _mm_cvtsi128_si64(_mm_clmulepi64_si128(_mm_cvtsi32_si128((int)(unsigned int)crc), Constant, 0));
+        crc = _mm_crc32_u64(0, word) ^ crc1;
+        word = _mm_cvtsi128_si64(_mm_clmulepi64_si128(_mm_cvtsi32_si128((int)(unsigned int)crc), Constant, 0));
+        crc = _mm_crc32_u64(0, word) ^ crc2;
+        i = 3 * Lane;
+    }
+
+    for(; i + 8 <= length; i = i + 8)
+    {
+        memcpy(&word, data + i, sizeof(word));
+        crc = _mm_crc32_u64(crc, word);
+    }
+
+    for(; i < length; i++)
+    {
+        crc = _mm_crc32_u8((unsigned int)crc, (unsigned char)data[i]);
+    }
+
+    return ~(unsigned int)crc;
+}
+#else
+unsigned int Crc32cHardware(
+                                const char *data,
+                                size_t length
+                            )
+{
+    return Crc32cSoftware(data, length);
+}
+#endif
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         FingerprintBlock
+//  Description :           Calculates fingerprint of a data block for the
+//                          dedup index. Hardware crc32 is used when the CPU
+//                          has it. 0 marks a block which is not indexed, so
+//                          it is never returned.
+//  Input :                 data -> Start of data block
+//  Output :                Non zero fingerprint
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+unsigned int FingerprintBlock(
+                                const char *data
+                            )
+{
+#if defined(__x86_64__)
+    static const bool Hardware = __builtin_cpu_supports("sse4.2") && __builtin_cpu_supports("pclmul");
+#else
+    static const bool Hardware = false;
+#endif
+    unsigned int hash = 0;
+
+    if(Hardware == true)
+    {
+        hash = Crc32cHardware(data, superobj.BlockSize);
+    }
+    else
+    {
+        hash = Crc32cSoftware(data, superobj.BlockSize);
+    }
+
+    return (hash == 0) ? 1 : hash;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         DedupLookup
+//  Description :           Searches the dedup index for a block which holds
+//                          given bytes. Fingerprints may collide, so bytes
+//                          of every candidate are compared. Caller holds
+//                          BlockLock.
+//  Input :                 hash -> Fingerprint of data
+//                          data -> Bytes of one block
+//  Output :                Block number, 0 if no block holds the bytes
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+int DedupLookup(
+                    unsigned int hash,
+                    const char *data
+                )
+{
+    unsigned int i = hash & dedupobj.Mask;
+
+    while(dedupobj.Slots[i].Block != 0)
+    {
+        if((dedupobj.Slots[i].Hash == hash) && (memcmp(BlockData(dedupobj.Slots[i].Block), data, superobj.BlockSize) == 0))
+        {
+            return dedupobj.Slots[i].Block;
+        }
+        i = (i + 1) & dedupobj.Mask;
+    }
+
+    return 0;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         DedupInsert
+//  Description :           Adds a block to the dedup index and records its
+//                          fingerprint. Caller holds BlockLock.
+//  Input :                 block -> Block which is not in the index
+//                          hash  -> Fingerprint of its data
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+void DedupInsert(
+                    int block,
+                    unsigned int hash
+                )
+{
+    unsigned int i = hash & dedupobj.Mask;
+
+    while(dedupobj.Slots[i].Block != 0)
+    {
+        i = (i + 1) & dedupobj.Mask;
+    }
+
+    dedupobj.Slots[i].Hash = hash;
+    dedupobj.Slots[i].Block = block;
+    JournalDirty(&dedupobj.Slots[i], sizeof(dedupobj.Slots[i]));
+
+    __atomic_store_n(&RecordOf(block)->Hash, hash, __ATOMIC_RELEASE);
+    JournalDirty(RecordOf(block), sizeof(BLOCKRECORD));
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         DedupRemove
+//  Description :           Removes a block from the dedup index, shifting
+//                          back following entries of the probe chain like
+//                          NameIndexRemove. Caller holds BlockLock.
+//  Input :                 block -> Block whose Hash is non zero
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+void DedupRemove(
+                    int block
+                )
+{
+    unsigned int i = RecordOf(block)->Hash & dedupobj.Mask;
+    unsigned int j = 0;
+    unsigned int home = 0;
+
+    while(dedupobj.Slots[i].Block != block)
+    {
+        i = (i + 1) & dedupobj.Mask;
+    }
+
+    //  Backward shift deletion
+    j = i;
+    while(1)
+    {
+        j = (j + 1) & dedupobj.Mask;
+
+        if(dedupobj.Slots[j].Block == 0)
+        {
+            break;
+        }
+
+        home = dedupobj.Slots[j].Hash & dedupobj.Mask;
+
+        if(((j - home) & dedupobj.Mask) >= ((j - i) & dedupobj.Mask))
+        {
+            dedupobj.Slots[i] = dedupobj.Slots[j];
+            JournalDirty(&dedupobj.Slots[i], sizeof(dedupobj.Slots[i]));
+            i = j;
+        }
+    }
+
+    dedupobj.Slots[i].Block = 0;
+    dedupobj.Slots[i].Hash = 0;
+    JournalDirty(&dedupobj.Slots[i], sizeof(dedupobj.Slots[i]));
+
+    __atomic_store_n(&RecordOf(block)->Hash, 0, __ATOMIC_RELEASE);
+    JournalDirty(RecordOf(block), sizeof(BLOCKRECORD));
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         WritableBlock
+//  Description :           Makes the block referred by a slot safe to modify.
+//                          A shared block is copied (copy on write) and the
+//                          slot is pointed to the copy; copy of an indirect
+//                          block adds a reference to each of its children.
+//                          A block in the dedup index is removed from it,
+//                          as its bytes are about to change.
+//                          Caller holds write lock of inode and the journal.
+//  Input :                 slot  -> Block pointer (inode or indirect block)
+//                          level -> 0 for data block, 1 to 3 for indirect
+//  Output :                Block number to modify,
+//                          ERR_INSUFFICIENT_SPACE if copy can not be made
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+int WritableBlock(
+                    int *slot,
+                    int level
+                )
+{
+    PBLOCKRECORD Record = RecordOf(*slot);
+    int PerBlock = superobj.BlockSize / sizeof(int);
+    int *Entries = NULL;
+    int block = 0;
+    int i = 0;
+
+    //  Common case : block is private and not indexed
+    if((__atomic_load_n(&Record->Refs, __ATOMIC_ACQUIRE) == 1) && (__atomic_load_n(&Record->Hash, __ATOMIC_ACQUIRE) == 0))
+    {
+        return *slot;
+    }
+
+    pthread_mutex_lock(&BlockLock);
+
+    if(Record->Refs == 1)
+    {
+        if(Record->Hash != 0)
+        {
+            DedupRemove(*slot);
+        }
+
+        pthread_mutex_unlock(&BlockLock);
+        return *slot;
+    }
+
+    pthread_mutex_unlock(&BlockLock);
+
+    block = AllocateBlock();
+    if(block == 0)
+    {
+        return ERR_INSUFFICIENT_SPACE;
+    }
+
+    memcpy(BlockData(block), BlockData(*slot), superobj.BlockSize);
+
+    //  Copy of first block of a compressed cluster is compressed too
+    if(Record->Flags != 0)
+    {
+        RecordOf(block)->Flags = Record->Flags;
+        JournalDirty(RecordOf(block), sizeof(BLOCKRECORD));
+    }
+
+    if(level == 0)
+    {
+        JournalData(BlockData(block), superobj.BlockSize);
+    }
+    else
+    {
+        JournalDirty(BlockData(block), superobj.BlockSize);
+
+        Entries = (int *)BlockData(block);
+
+        pthread_mutex_lock(&BlockLock);
+
+        for(i = 0; i < PerBlock; i++)
+        {
+            if(Entries[i] != 0)
+            {
+                __atomic_add_fetch(&RecordOf(Entries[i])->Refs, 1, __ATOMIC_RELEASE);
+                JournalDirty(RecordOf(Entries[i]), sizeof(BLOCKRECORD));
+            }
+        }
+
+        pthread_mutex_unlock(&BlockLock);
+    }
+
+    //  Other owners may have dropped the block meanwhile
+    ReleaseBlockTree(*slot, level);
+
+    *slot = block;
+    JournalDirty(slot, sizeof(int));
+
+    return block;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         DedupBlock
+//  Description :           Called after a data block was written to its end.
+//                          If another block holds the same bytes the slot is
+//                          pointed to it and the written block is released,
+//                          otherwise the block is added to the dedup index.
+//                          Caller holds write lock of inode and the journal.
+//  Input :                 slot -> Block pointer of a private, unindexed block
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+void DedupBlock(
+                    int *slot
+                )
+{
+    int block = *slot;
+    int other = 0;
+    unsigned int hash = FingerprintBlock(BlockData(block));
+
+    pthread_mutex_lock(&BlockLock);
+
+    other = DedupLookup(hash, BlockData(block));
+
+    if(other == 0)
+    {
+        DedupInsert(block, hash);
+        pthread_mutex_unlock(&BlockLock);
+        return;
+    }
+
+    __atomic_add_fetch(&RecordOf(other)->Refs, 1, __ATOMIC_RELEASE);
+    JournalDirty(RecordOf(other), sizeof(BLOCKRECORD));
+
+    pthread_mutex_unlock(&BlockLock);
+
+    *slot = other;
+    JournalDirty(slot, sizeof(int));
+
+    ReleaseBlockTree(block, 0);
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         MaxFileSize
+//  Description :           Computes the largest size of a file, which is set
+//                          by the direct blocks and the single, double and
+//                          triple indirect trees for current block size.
+//                          Sizes which do not fit into 64 bits are clamped.
+//  Output :                Largest file size in bytes
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+long long MaxFileSize()
+{
+    long long PerBlock = superobj.BlockSize / sizeof(int);
+    long long Span = 1;
+    long long Blocks = NDIRECT;
+    long long Bytes = 0;
+    int level = 0;
+
+    for(level = 1; level <= 3; level++)
+    {
+        if(__builtin_mul_overflow(Span, PerBlock, &Span) || __builtin_add_overflow(Blocks, Span, &Blocks))
+        {
+            return LLONG_MAX;
+        }
+    }
+
+    if(__builtin_mul_overflow(Blocks, (long long)superobj.BlockSize, &Bytes))
+    {
+        return LLONG_MAX;
+    }
+
+    return Bytes;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         MapBlock
+//  Description :           Translates logical block number of a file into the
+//                          data block which stores it. Block numbers below
+//                          NDIRECT are found in the inode, the rest through
+//                          single, double and triple indirect blocks.
+//                          Missing blocks are allocated when requested, and
+//                          then every block on the path is made writable
+//                          (shared blocks are copied).
+//  Input :                 ptrinode -> Inode of file
+//                          logical  -> Logical block number inside the file
+//                          allocate -> true to allocate missing blocks
+//                          slot     -> Receives block pointer of data
+//                                      block, may be NULL
+//  Output :                Block number, 0 if block is not allocated
+//                          ERR_INSUFFICIENT_SPACE if pool is exhausted or the
+//                          offset is beyond triple indirect range
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+int MapBlock(
+                PINODE ptrinode,
+                long long logical,
+                bool allocate,
+                int **slot
+            )
+{
+    long long PerBlock = superobj.BlockSize / sizeof(int);
+    long long Span = 1;
+    int *Slot = NULL;
+    int level = 0;
+    int block = 0;
+
+    //  Select the root pointer and the depth of the tree
+    if(logical < NDIRECT)
+    {
+        Slot = &ptrinode->Block[logical];
+        level = 0;
+    }
+    else
+    {
+        logical = logical - NDIRECT;
+
+        for(level = 1; level <= 3; level++)
+        {
+            Span = Span * PerBlock;
+
+            if(logical < Span)
+            {
+                break;
+            }
+
+            logical = logical - Span;
+        }
+
+        if(level > 3)
+        {
+            return ERR_INSUFFICIENT_SPACE;
+        }
+
+        Slot = &ptrinode->Block[INDIRECT + level - 1];
+    }
+
+    //  Walk down the tree, Span is number of data blocks below Slot
+    while(1)
+    {
+        if(*Slot == 0)
+        {
+            if(allocate == false)
+            {
+                return 0;
+            }
+
+            block = AllocateBlock();
+            if(block == 0)
+            {
+                return ERR_INSUFFICIENT_SPACE;
+            }
+
+            *Slot = block;
+            JournalDirty(Slot, sizeof(int));
+
+            if(level == 0)
+            {
+                ptrinode->FileSize = ptrinode->FileSize + superobj.BlockSize;
+                JournalDirty(&ptrinode->FileSize, sizeof(ptrinode->FileSize));
+            }
+            else
+            {
+                //  Pointers of a new indirect block are metadata
+                JournalDirty(BlockData(block), superobj.BlockSize);
+            }
+        }
+        else if(allocate == true)
+        {
+            block = WritableBlock(Slot, level);
+            if(block < 0)
+            {
+                return block;
+            }
+        }
+
+        if(level == 0)
+        {
+            if(slot != NULL)
+            {
+                *slot = Slot;
+            }
+            return *Slot;
+        }
+
+        Span = Span / PerBlock;
+        Slot = (int *)BlockData(*Slot) + (logical / Span);
+        logical = logical % Span;
+        level--;
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         ReleaseFileBlocks
+//  Description :           Releases every data and indirect block of a file.
+//                          Inline data owns no block and is only cleared.
+//  Input :                 ptrinode -> Inode of file
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+void ReleaseFileBlocks(
+                        PINODE ptrinode
+                    )
+{
+    int i = 0;
+
+    if((ptrinode->Flags & INODE_INLINE) == 0)
+    {
+        for(i = 0; i < NDIRECT; i++)
+        {
+            ReleaseBlockTree(ptrinode->Block[i], 0);
+        }
+
+        ReleaseBlockTree(ptrinode->Block[INDIRECT], 1);
+        ReleaseBlockTree(ptrinode->Block[DINDIRECT], 2);
+        ReleaseBlockTree(ptrinode->Block[TINDIRECT], 3);
+    }
+
+    memset(ptrinode->Block, 0, sizeof(ptrinode->Block));
+    ptrinode->FileSize = 0;
+    ptrinode->Flags = 0;
+
+    JournalDirty(ptrinode, sizeof(*ptrinode));
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         HoldFileBlocks
+//  Description :           Adds one reference to every root block pointer of
+//                          a file, so that a second inode (a snapshot entry)
+//                          may point to the same blocks. Blocks below the
+//                          roots are shared through them and get their own
+//                          references only when a root is copied on write.
+//  Input :                 ptrinode -> Inode whose blocks are shared
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+void HoldFileBlocks(
+                        PINODE ptrinode
+                    )
+{
+    int i = 0;
+
+    if((ptrinode->Flags & INODE_INLINE) != 0)
+    {
+        return;
+    }
+
+    pthread_mutex_lock(&BlockLock);
+
+    for(i = 0; i < NBLOCKPTR; i++)
+    {
+        if(ptrinode->Block[i] != 0)
+        {
+            __atomic_add_fetch(&RecordOf(ptrinode->Block[i])->Refs, 1, __ATOMIC_RELEASE);
+            JournalDirty(RecordOf(ptrinode->Block[i]), sizeof(BLOCKRECORD));
+        }
+    }
+
+    pthread_mutex_unlock(&BlockLock);
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         PromoteInlineData
+//  Description :           Moves inline data of a file into its first data
+//                          block, so that Block[] holds block numbers again.
+//                          Used when a write would grow the file beyond
+//                          InlineSize. Caller holds write lock of inode and
+//                          the journal.
+//  Input :                 ptrinode -> Inode with INODE_INLINE
+//  Output :                EXECUTE_SUCCESS, ERR_INSUFFICIENT_SPACE if no
+//                          block is free (file stays inline)
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+int PromoteInlineData(
+                        PINODE ptrinode
+                    )
+{
+    char Data[sizeof(ptrinode->Block)];
+    int Size = CoreOf(ptrinode)->ActualFileSize;
+    int block = 0;
+
+    memcpy(Data, ptrinode->Block, sizeof(Data));
+    memset(ptrinode->Block, 0, sizeof(ptrinode->Block));
+    ptrinode->Flags = ptrinode->Flags & ~INODE_INLINE;
+
+    //  Empty file needs no block until data is written
+    if(Size > 0)
+    {
+        block = MapBlock(ptrinode, 0, true, NULL);
+
+        if(block <= 0)
+        {
+            memcpy(ptrinode->Block, Data, sizeof(Data));
+            ptrinode->Flags = ptrinode->Flags | INODE_INLINE;
+            return ERR_INSUFFICIENT_SPACE;
+        }
+
+        memcpy(BlockData(block), Data, Size);
+        JournalData(BlockData(block), Size);
+    }
+
+    JournalDirty(ptrinode, sizeof(*ptrinode));
+
+    return EXECUTE_SUCCESS;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         Lz4Compress
+//  Description :           Compresses a buffer into LZ4 block format : a
+//                          sequence is a token (literal and match length),
+//                          the literals, a 16 bit offset and extra length
+//                          bytes. Matches of 4 or more bytes are found with a
+//                          hash table of the last position of every 4 bytes.
+//                          Runs without matches are skipped faster and faster
+//                          so that data which does not compress costs little.
+//  Input :                 src      -> Bytes to compress
+//                          length   -> Number of bytes
+//                          dst      -> Destination of compressed stream
+//                          capacity -> Bytes available at dst
+//  Output :                Bytes of compressed stream, 0 if it does not fit
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+int Lz4Compress(
+                    const char *src,
+                    int length,
+                    char *dst,
+                    int capacity
+                )
+{
+    int Table[1 << LZ4HASHBITS];        // Position + 1 of last occurrence, 0 if none
+    const unsigned char *in = (const unsigned char *)src;
+    unsigned char *out = (unsigned char *)dst;
+    unsigned char *token = NULL;
+    unsigned int sequence = 0;
+    unsigned int hash = 0;
+    int ip = 0;
+    int op = 0;
+    int ref = 0;
+    int anchor = 0;
+    int literals = 0;
+    int match = 0;
+    int misses = 0;
+    int n = 0;
+
+    memset(Table, 0, sizeof(Table));
+
+    while(ip < length - LZ4MFLIMIT)
+    {
+        memcpy(&sequence, in + ip, sizeof(sequence));
+        hash = (sequence * 2654435761u) >> (32 - LZ4HASHBITS);
+        ref = Table[hash] - 1;
+        Table[hash] = ip + 1;
+
+        if((ref < 0) || ((ip - ref) > LZ4MAXOFFSET) || (memcmp(in + ref, in + ip, LZ4MINMATCH) != 0))
+        {
+            misses++;
+            ip = ip + 1 + (misses >> 6);
+            continue;
+        }
+
+        misses = 0;
+
+        //  Extend match, stream must end with literals
+        match = LZ4MINMATCH;
+        while(((ip + match) < (length - LZ4LASTLITERALS)) && (in[ref + match] == in[ip + match]))
+        {
+            match++;
+        }
+
+        literals = ip - anchor;
+
+        //  Token, literals, offset and the longest length encodings
+        if((op + 1 + (literals / 255) + 1 + literals + 2 + ((match - LZ4MINMATCH) / 255) + 1) > capacity)
+        {
+            return 0;
+        }
+
+        token = &out[op++];
+        *token = (unsigned char)(((literals >= 15) ? 15 : literals) << 4);
+
+        if(literals >= 15)
+        {
+            for(n = literals - 15; n >= 255; n = n - 255)
+            {
+                out[op++] = 255;
+            }
+            out[op++] = (unsigned char)n;
+        }
+
+        memcpy(out + op, in + anchor, literals);
+        op = op + literals;
+
+        out[op++] = (unsigned char)((ip - ref) & 0xFF);
+        out[op++] = (unsigned char)((ip - ref) >> 8);
+
+        n = match - LZ4MINMATCH;
+        *token = *token | (unsigned char)((n >= 15) ? 15 : n);
+
+        if(n >= 15)
+        {
+            for(n = n - 15; n >= 255; n = n - 255)
+            {
+                out[op++] = 255;
+            }
+            out[op++] = (unsigned char)n;
+        }
+
+        ip = ip + match;
+        anchor = ip;
+    }
+
+    //  Last literals
+    literals = length - anchor;
+
+    if((op + 1 + (literals / 255) + 1 + literals) > capacity)
+    {
+        return 0;
+    }
+
+    token = &out[op++];
+    *token = (unsigned char)(((literals >= 15) ? 15 : literals) << 4);
+
+    if(literals >= 15)
+    {
+        for(n = literals - 15; n >= 255; n = n - 255)
+        {
+            out[op++] = 255;
+        }
+        out[op++] = (unsigned char)n;
+    }
+
+    memcpy(out + op, in + anchor, literals);
+
+    return op + literals;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         Lz4Decompress
+//  Description :           Decompresses a stream of Lz4Compress. Every length
+//                          and offset is checked, so a damaged image can not
+//                          make it read or write outside the buffers.
+//  Input :                 src      -> Compressed stream
+//                          length   -> Bytes of stream
+//                          dst      -> Destination of data
+//                          capacity -> Bytes available at dst
+//  Output :                Bytes of data, -1 if stream is damaged
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+int Lz4Decompress(
+                    const char *src,
+                    int length,
+                    char *dst,
+                    int capacity
+                )
+{
+    const unsigned char *in = (const unsigned char *)src;
+    unsigned char *out = (unsigned char *)dst;
+    int ip = 0;
+    int op = 0;
+    int token = 0;
+    int count = 0;
+    int offset = 0;
+    int from = 0;
+    int i = 0;
+    int b = 0;
+
+    while(ip < length)
+    {
+        token = in[ip++];
+
+        //  Literals
+        count = token >> 4;
+        if(count == 15)
+        {
+            do
+            {
+                if(ip >= length)
+                {
+                    return -1;
+                }
+                b = in[ip++];
+                count = count + b;
+            }
+            while(b == 255);
+        }
+
+        if((count > (length - ip)) || (count > (capacity - op)))
+        {
+            return -1;
+        }
+
+        memcpy(out + op, in + ip, count);
+        ip = ip + count;
+        op = op + count;
+
+        //  Last sequence has no match
+        if(ip == length)
+        {
+            break;
+        }
+
+        if((length - ip) < 2)
+        {
+            return -1;
+        }
+
+        offset = in[ip] | (in[ip + 1] << 8);
+        ip = ip + 2;
+
+        if((offset == 0) || (offset > op))
+        {
+            return -1;
+        }
+
+        count = token & 15;
+        if(count == 15)
+        {
+            do
+            {
+                if(ip >= length)
+                {
+                    return -1;
+                }
+                b = in[ip++];
+                count = count + b;
+            }
+            while(b == 255);
+        }
+        count = count + LZ4MINMATCH;
+
+        if(count > (capacity - op))
+        {
+            return -1;
+        }
+
+        //  Match may overlap the bytes it produces (runs) : the pattern
+        //  before op repeats, so the copied span doubles every round
+        from = op - offset;
+        while(count > 0)
+        {
+            i = ((op - from) < count) ? (op - from) : count;
+            memcpy(out + op, out + from, i);
+            op = op + i;
+            count = count - i;
+        }
+    }
+
+    return op;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         DestroyDecompCache
+//  Description :           Releases memory of the decompressed cluster cache.
+//                          Used when the file system is released or replaced
+//                          by a mounted image, whose block numbers differ.
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+void DestroyDecompCache()
+{
+    pthread_mutex_lock(&CacheLock);
+
+    if(cacheobj.Memory != NULL)
+    {
+        CvfsFree(cacheobj.Memory, (size_t)(DECOMPCACHESIZE + 2) * cacheobj.ClusterSize);
+    }
+
+    memset(&cacheobj, 0, sizeof(cacheobj));
+
+    pthread_mutex_unlock(&CacheLock);
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         CacheInvalidate
+//  Description :           Forgets decompressed data of a cluster whose first
+//                          block is released or rewritten raw.
+//  Input :                 block -> First block of cluster
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+void CacheInvalidate(
+                        int block
+                    )
+{
+    int i = 0;
+
+    pthread_mutex_lock(&CacheLock);
+
+    for(i = 0; i < DECOMPCACHESIZE; i++)
+    {
+        if(cacheobj.Entries[i].Block == block)
+        {
+            cacheobj.Entries[i].Block = 0;
+            cacheobj.Entries[i].Used = false;
+        }
+    }
+
+    pthread_mutex_unlock(&CacheLock);
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         LookupCluster
+//  Description :           Returns decompressed data of a compressed cluster.
+//                          A cached cluster is returned directly, otherwise
+//                          its stream is gathered from its blocks and
+//                          decompressed into an entry chosen by the clock.
+//                          Cache is allocated on first use. Caller holds
+//                          CacheLock and read or write lock of inode.
+//  Input :                 ptrinode -> Inode of file
+//                          first    -> Logical block where cluster starts
+//                          head     -> Block mapped at first (BLOCK_COMPRESSED)
+//                          pin      -> true to pin the entry for a view
+//  Output :                CLUSTERBLOCKS blocks of data, valid until
+//                          CacheLock is released (or the pin is dropped)
+//                          NULL if memory is not available, every entry is
+//                          pinned (pin only) or the stream is damaged
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+char * LookupCluster(
+                        PINODE ptrinode,
+                        long long first,
+                        int head,
+                        bool pin
+                    )
+{
+    int ClusterSize = CLUSTERBLOCKS * superobj.BlockSize;
+    struct CacheEntry *entry = NULL;
+    char *Target = NULL;
+    long long Start = 0;
+    int Length = 0;
+    int block = 0;
+    int i = 0;
+
+    if(cacheobj.ClusterSize != ClusterSize)
+    {
+        if(cacheobj.Memory != NULL)
+        {
+            CvfsFree(cacheobj.Memory, (size_t)(DECOMPCACHESIZE + 2) * cacheobj.ClusterSize);
+            memset(&cacheobj, 0, sizeof(cacheobj));
+        }
+
+        cacheobj.Memory = (char *)CvfsAlloc((size_t)(DECOMPCACHESIZE + 2) * ClusterSize);
+        if(cacheobj.Memory == NULL)
+        {
+            return NULL;
+        }
+
+        cacheobj.ClusterSize = ClusterSize;
+        cacheobj.Spare = cacheobj.Memory + ((size_t)DECOMPCACHESIZE * ClusterSize);
+        cacheobj.Scratch = cacheobj.Spare + ClusterSize;
+
+        for(i = 0; i < DECOMPCACHESIZE; i++)
+        {
+            cacheobj.Entries[i].Data = cacheobj.Memory + ((size_t)i * ClusterSize);
+        }
+    }
+
+    for(i = 0; i < DECOMPCACHESIZE; i++)
+    {
+        if(cacheobj.Entries[i].Block == head)
+        {
+            entry = &cacheobj.Entries[i];
+            entry->Used = true;
+            entry->Pins = entry->Pins + (pin ? 1 : 0);
+            compressobj.CacheHits++;
+            return entry->Data;
+        }
+    }
+
+    //  Clock : skip pinned entries and give used ones a second chance
+    for(i = 0; i < 2 * DECOMPCACHESIZE; i++)
+    {
+        entry = &cacheobj.Entries[cacheobj.Hand];
+        cacheobj.Hand = (cacheobj.Hand + 1) % DECOMPCACHESIZE;
+
+        if(entry->Pins > 0)
+        {
+            continue;
+        }
+
+        if(entry->Used == false)
+        {
+            Target = entry->Data;
+            break;
+        }
+
+        entry->Used = false;
+    }
+
+    if(Target == NULL)
+    {
+        if(pin == true)
+        {
+            return NULL;
+        }
+
+        entry = NULL;
+        Target = cacheobj.Spare;
+    }
+
+    //  Gather stream from blocks of cluster
+    memcpy(&Length, BlockData(head), sizeof(Length));
+    if((Length <= 0) || (Length > (ClusterSize - superobj.BlockSize - CLUSTERHEADER)))
+    {
+        return NULL;
+    }
+
+    for(i = 0; (i * superobj.BlockSize) < (Length + CLUSTERHEADER); i++)
+    {
+        block = (i == 0) ? head : MapBlock(ptrinode, first + i, false, NULL);
+        if(block <= 0)
+        {
+            return NULL;
+        }
+        memcpy(cacheobj.Scratch + ((size_t)i * superobj.BlockSize), BlockData(block), superobj.BlockSize);
+    }
+
+    Start = PerfClock();
+
+    if(Lz4Decompress(cacheobj.Scratch + CLUSTERHEADER, Length, Target, ClusterSize) != ClusterSize)
+    {
+        return NULL;
+    }
+
+    compressobj.DecompressNs = compressobj.DecompressNs + (PerfClock() - Start);
+    compressobj.DecompressBytes = compressobj.DecompressBytes + ClusterSize;
+    compressobj.CacheMisses++;
+
+    if(entry != NULL)
+    {
+        entry->Block = head;
+        entry->Used = true;
+        entry->Pins = (pin ? 1 : 0);
+    }
+
+    return Target;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         ClusterHead
+//  Description :           Finds the compressed cluster holding a logical
+//                          block of a file with INODE_COMPRESS.
+//  Input :                 ptrinode -> Inode of file
+//                          logical  -> Logical block number
+//                          first    -> Receives logical block where cluster starts
+//  Output :                First block of cluster if it is compressed, 0 otherwise
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+int ClusterHead(
+                PINODE ptrinode,
+                long long logical,
+                long long *first
+            )
+{
+    int head = 0;
+
+    *first = logical & ~(long long)(CLUSTERBLOCKS - 1);
+
+    head = MapBlock(ptrinode, *first, false, NULL);
+
+    if((head > 0) && ((__atomic_load_n(&RecordOf(head)->Flags, __ATOMIC_ACQUIRE) & BLOCK_COMPRESSED) != 0))
+    {
+        return head;
+    }
+
+    return 0;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         PunchBlock
+//  Description :           Releases the data block at a logical block number,
+//                          leaving a hole. Caller holds write lock of inode
+//                          and the journal.
+//  Input :                 ptrinode -> Inode of file
+//                          logical  -> Logical block number
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+void PunchBlock(
+                PINODE ptrinode,
+                long long logical
+            )
+{
+    int *Slot = NULL;
+
+    if(MapBlock(ptrinode, logical, false, NULL) <= 0)
+    {
+        return;
+    }
+
+    //  Pointer is modified, so indirect blocks above it must be private
+    if(MapBlock(ptrinode, logical, true, &Slot) <= 0)
+    {
+        return;
+    }
+
+    ReleaseBlockTree(*Slot, 0);
+    *Slot = 0;
+    JournalDirty(Slot, sizeof(int));
+
+    ptrinode->FileSize = ptrinode->FileSize - superobj.BlockSize;
+    JournalDirty(&ptrinode->FileSize, sizeof(ptrinode->FileSize));
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         CompressCluster
+//  Description :           Called when a write of a file with INODE_COMPRESS
+//                          reaches the end of a cluster. The CLUSTERBLOCKS
+//                          blocks are compressed; if the stream (with its
+//                          length in front) needs fewer blocks it is stored
+//                          from the first block of the cluster on, that block
+//                          is flagged BLOCK_COMPRESSED and the rest are
+//                          released. Otherwise the cluster stays raw.
+//                          Caller holds write lock of inode and the journal.
+//  Input :                 ptrinode -> Inode of file
+//                          first    -> Logical block where cluster starts
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+void CompressCluster(
+                        PINODE ptrinode,
+                        long long first
+                    )
+{
+    int ClusterSize = CLUSTERBLOCKS * superobj.BlockSize;
+    int Blocks[CLUSTERBLOCKS] = {0};
+    char *In = NULL;
+    char *Out = NULL;
+    long long Start = 0;
+    int Length = 0;
+    int Used = 0;
+    int i = 0;
+
+    //  Without memory the cluster simply stays raw
+    In = (char *)CvfsAlloc((size_t)2 * ClusterSize);
+    if(In == NULL)
+    {
+        return;
+    }
+    Out = In + ClusterSize;
+
+    for(i = 0; i < CLUSTERBLOCKS; i++)
+    {
+        Blocks[i] = MapBlock(ptrinode, first + i, false, NULL);
+
+        if(Blocks[i] > 0)
+        {
+            memcpy(In + ((size_t)i * superobj.BlockSize), BlockData(Blocks[i]), superobj.BlockSize);
+        }
+        else
+        {
+            memset(In + ((size_t)i * superobj.BlockSize), 0, superobj.BlockSize);
+        }
+    }
+
+    Start = PerfClock();
+    Length = Lz4Compress(In, ClusterSize, Out + CLUSTERHEADER, ClusterSize - superobj.BlockSize - CLUSTERHEADER);
+
+    __atomic_add_fetch(&compressobj.CompressNs, PerfClock() - Start, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&compressobj.BytesIn, ClusterSize, __ATOMIC_RELAXED);
+
+    if(Length == 0)
+    {
+        __atomic_add_fetch(&compressobj.BytesOut, ClusterSize, __ATOMIC_RELAXED);
+        __atomic_add_fetch(&compressobj.Incompressible, 1, __ATOMIC_RELAXED);
+        CvfsFree(In, (size_t)2 * ClusterSize);
+        return;
+    }
+
+    __atomic_add_fetch(&compressobj.BytesOut, Length + CLUSTERHEADER, __ATOMIC_RELAXED);
+
+    memcpy(Out, &Length, sizeof(Length));
+    Used = (Length + CLUSTERHEADER + superobj.BlockSize - 1) >> BlockShift;
+
+    //  Every block of the stream is made private before any is overwritten
+    for(i = 0; i < Used; i++)
+    {
+        Blocks[i] = MapBlock(ptrinode, first + i, true, NULL);
+
+        if(Blocks[i] <= 0)
+        {
+            CvfsFree(In, (size_t)2 * ClusterSize);
+            return;
+        }
+    }
+
+    //  Stream is journaled with the flag, a crash leaves the cluster whole
+    for(i = 0; i < Used; i++)
+    {
+        memcpy(BlockData(Blocks[i]), Out + ((size_t)i * superobj.BlockSize), superobj.BlockSize);
+        JournalDirty(BlockData(Blocks[i]), superobj.BlockSize);
+    }
+
+    __atomic_store_n(&RecordOf(Blocks[0])->Flags, BLOCK_COMPRESSED, __ATOMIC_RELEASE);
+    JournalDirty(RecordOf(Blocks[0]), sizeof(BLOCKRECORD));
+
+    for(i = Used; i < CLUSTERBLOCKS; i++)
+    {
+        PunchBlock(ptrinode, first + i);
+    }
+
+    __atomic_add_fetch(&compressobj.Compressed, 1, __ATOMIC_RELAXED);
+
+    CvfsFree(In, (size_t)2 * ClusterSize);
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         ExpandCluster
+//  Description :           Rewrites a compressed cluster raw, so that a write
+//                          can modify it in place. All its blocks are taken
+//                          first; if that fails the cluster stays compressed.
+//                          Caller holds write lock of inode and the journal.
+//  Input :                 ptrinode -> Inode of file
+//                          first    -> Logical block where cluster starts
+//                          head     -> Block mapped at first (BLOCK_COMPRESSED)
+//  Output :                EXECUTE_SUCCESS, ERR_INSUFFICIENT_SPACE or
+//                          ERR_NO_MEMORY
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+int ExpandCluster(
+                    PINODE ptrinode,
+                    long long first,
+                    int head
+                )
+{
+    int ClusterSize = CLUSTERBLOCKS * superobj.BlockSize;
+    int Blocks[CLUSTERBLOCKS] = {0};
+    char *Data = NULL;
+    char *Source = NULL;
+    int i = 0;
+
+    Data = (char *)CvfsAlloc(ClusterSize);
+    if(Data == NULL)
+    {
+        return ERR_NO_MEMORY;
+    }
+
+    pthread_mutex_lock(&CacheLock);
+
+    Source = LookupCluster(ptrinode, first, head, false);
+
+    //  Damaged stream reads as zeros, like a hole
+    if(Source != NULL)
+    {
+        memcpy(Data, Source, ClusterSize);
+    }
+    else
+    {
+        memset(Data, 0, ClusterSize);
+    }
+
+    pthread_mutex_unlock(&CacheLock);
+
+    //  Copy of a shared first block keeps its flag, so readers still decompress
+    for(i = 0; i < CLUSTERBLOCKS; i++)
+    {
+        Blocks[i] = MapBlock(ptrinode, first + i, true, NULL);
+
+        if(Blocks[i] <= 0)
+        {
+            CvfsFree(Data, ClusterSize);
+            return ERR_INSUFFICIENT_SPACE;
+        }
+    }
+
+    //  Journaled with the flag, like the stream in CompressCluster
+    for(i = 0; i < CLUSTERBLOCKS; i++)
+    {
+        memcpy(BlockData(Blocks[i]), Data + ((size_t)i * superobj.BlockSize), superobj.BlockSize);
+        JournalDirty(BlockData(Blocks[i]), superobj.BlockSize);
+    }
+
+    __atomic_store_n(&RecordOf(Blocks[0])->Flags, 0, __ATOMIC_RELEASE);
+    JournalDirty(RecordOf(Blocks[0]), sizeof(BLOCKRECORD));
+    CacheInvalidate(Blocks[0]);
+
+    __atomic_add_fetch(&compressobj.Expanded, 1, __ATOMIC_RELAXED);
+
+    CvfsFree(Data, ClusterSize);
+
+    return EXECUTE_SUCCESS;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         CreateBlockPool
+//  Description :           Pushes every data block of the image on the free
+//                          block list. Files take blocks from here as they grow.
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+void CreateBlockPool()
+{
+    int i = 0;
+
+    //  Push in reverse order so that block 1 is allocated first
+    for(i = superobj.TotalBlocks; i >= 1; i--)
+    {
+        ReleaseBlock(i);
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         StartAuxillaryDataInitialisation
+//  Description :           It is used to call all such functions which are 
+//                          used to initialise auxillary data.
+//                          This is the master initialization routine of CVFS.
+//                          It sets the boot message and calls all other
+//                          initialization functions required before the file
+//                          system starts. Nothing is printed, the caller
+//                          reports the result.
+//  Calls internally :      - InitialiseArena()
+//                          - InitialiseSuperBlock()
+//                          - CreateImage()
+//                          - CreateDILB()
+//                          - CreateBlockPool()
+//                          - InitialiseUAREA()
+//  Effect :                The virtual file system becomes ready to accept commands.                        
+//  Input :                 count      -> Number of inodes in the file system
+//                          blocksize  -> Bytes in one data block
+//                          blockcount -> Number of data blocks
+//                          hugepages  -> true to back memory with huge pages
+//  Output :                true on success, false if memory is not available
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  13/01/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+bool StartAuxillaryDataInitialisation(
+                                        int count,
+                                        int blocksize,
+                                        int blockcount,
+                                        bool hugepages
+                                    )
+{
+    bootobj.Magic = CVFS_MAGIC;
+    bootobj.Version = CVFS_VERSION;
+    strcpy(bootobj.Information,"Booting process of Omkar's CVFS is done");
+
+    InitialiseArena(hugepages);
+
+    //  No journal until an image is mounted
+    journalobj.Fd = -1;
+    journalobj.GroupSize = JOURNAL_GROUP;
+
+    InitialiseSuperBlock(count, blocksize, blockcount);
+
+    if(CreateImage() == false)
+    {
+        return false;
+    }
+
+    CreateDILB();
+
+    CreateBlockPool();
+
+    return InitialiseUAREA();
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         ReleaseInodeData
+//  Description :           Releases data blocks of a deleted file and returns
+//                          its inode to the free inode list. Caller holds
+//                          NamespaceLock, write lock of inode and journal.
+//  Input :                 ptrinode -> Inode of deleted file
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+void ReleaseInodeData(
+                        PINODE ptrinode
+                    )
+{
+    //  Return data blocks to the pool (also resets FileSize)
+    ReleaseFileBlocks(ptrinode);
+
+    // Reset all values of inode
+    // Dont deallocate memory of inode
+    ptrinode->Permission = 0;
+    ptrinode->Parent = ROOTDIRECTORY;
+    CoreOf(ptrinode)->ActualFileSize = 0;
+    CoreOf(ptrinode)->FileType = 0;
+    CoreOf(ptrinode)->ReferenceCount = 0;
+
+    //////////////////////////////////////////////////////////////////////////////////
+    //
+    //  Use of memset()
+    //  Description :
+    //      memset() is used to clear a block of memory by setting all bytes
+    //      to a specific value. In this project, it is used while deleting
+    //      a file to erase the file name stored in the inode.
+    //
+    //  Why it is used :
+    //      When a file is deleted, the inode is reused for future files.
+    //      Clearing the old file name avoids garbage values and ensures
+    //      correct file listing and existence checks.
+    //
+    //  Statement Used :
+    //      memset(ptrinode->FileName, '\0', sizeof(ptrinode->FileName));
+    //
+    //////////////////////////////////////////////////////////////////////////////////
+
+    memset(ptrinode->FileName, '\0', sizeof(ptrinode->FileName));
+
+    //  Return inode to free inode list (increments free inodes count)
+    ReleaseInode(ptrinode);
+
+    JournalDirty(ptrinode, sizeof(*ptrinode));
+    JournalDirty(CoreOf(ptrinode), sizeof(INODECORE));
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         ReleaseFileTable
+//  Description :           Drops one descriptor reference of a system wide
+//                          file table entry. Last reference releases the entry
+//                          and drops reference count of its inode; a file
+//                          which was unlinked while open is deleted now.
+//  Input :                 ptrfile -> File table entry
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+void ReleaseFileTable(
+                        PFILETABLE ptrfile
+                    )
+{
+    PINODE temp = ptrfile->ptrinode;
+
+    if(__atomic_sub_fetch(&ptrfile->Count, 1, __ATOMIC_ACQ_REL) > 0)
+    {
+        return;
+    }
+
+    pthread_mutex_lock(&NamespaceLock);
+
+    CoreOf(temp)->ReferenceCount--;
+
+    //  Unlinked file has no name, it lived only for its open descriptors
+    if((CoreOf(temp)->ReferenceCount == 0) && (temp->FileName[0] == '\0'))
+    {
+        pthread_rwlock_wrlock(LockOf(temp));
+        JournalBegin();
+
+        ReleaseInodeData(temp);
+
+        JournalCommit();
+        pthread_rwlock_unlock(LockOf(temp));
+    }
+
+    pthread_mutex_unlock(&NamespaceLock);
+
+    __atomic_sub_fetch(&OpenFileTables, 1, __ATOMIC_RELAXED);
+
+    CvfsFree(ptrfile, sizeof(FILETABLE));
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         ReleaseDescriptor
+//  Description :           Empties a UFDT entry of a session and drops the
+//                          reference of its file table entry. Descriptor
+//                          becomes the lowest free one if it is below all
+//                          other free descriptors.
+//  Input :                 uarea -> Session
+//                          fd    -> File descriptor
+//  Output :                true if descriptor was in use
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+bool ReleaseDescriptor(
+                        PUAREA uarea,
+                        int fd
+                    )
+{
+    PFILETABLE ptrfile = NULL;
+
+    if(fd < FDRESERVED)
+    {
+        return false;
+    }
+
+    pthread_mutex_lock(&uarea->FdLock);
+
+    if(fd < uarea->Capacity)
+    {
+        ptrfile = uarea->UFDT[fd];
+    }
+
+    if(ptrfile == NULL)
+    {
+        pthread_mutex_unlock(&uarea->FdLock);
+        return false;
+    }
+
+    __atomic_store_n(&uarea->UFDT[fd], (PFILETABLE)NULL, __ATOMIC_RELEASE);
+    MarkDescriptor(uarea, fd, false);
+    uarea->OpenCount--;
+
+    pthread_mutex_unlock(&uarea->FdLock);
+
+    ReleaseFileTable(ptrfile);
+
+    return true;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         CloseAllFiles
+//  Description :           Releases every descriptor of every session, which
+//                          releases all file table entries and drops the
+//                          reference counts of their inodes. Every session
+//                          goes back to root directory.
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+void CloseAllFiles()
+{
+    int i = 0;
+    int fd = 0;
+
+    pthread_mutex_lock(&SessionLock);
+
+    for(i = 0; i < sessionobj.Capacity; i++)
+    {
+        if(sessionobj.Sessions[i] == NULL)
+        {
+            continue;
+        }
+
+        for(fd = FDRESERVED; fd < sessionobj.Sessions[i]->Capacity; fd++)
+        {
+            ReleaseDescriptor(sessionobj.Sessions[i], fd);
+        }
+
+        //  Inode numbers mean nothing in the next file system
+        pthread_mutex_lock(&NamespaceLock);
+        ReleaseDirectory(sessionobj.Sessions[i]->Cwd);
+        sessionobj.Sessions[i]->Cwd = ROOTDIRECTORY;
+        pthread_mutex_unlock(&NamespaceLock);
+    }
+
+    pthread_mutex_unlock(&SessionLock);
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         WriteImageHeader
+//  Description :           Copies BootBlock and SuperBlock into the header of
+//                          the image so that they are stored with it.
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+void WriteImageHeader()
+{
+    memcpy(ImageBase, &bootobj, sizeof(bootobj));
+    memcpy(ImageBase + SUPERBLOCKOFFSET, &superobj, sizeof(superobj));
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         SyncImage
+//  Description :           Makes every committed operation durable and then
+//                          checkpoints the journal, so that the host file
+//                          alone holds the current file system.
+//  Output :                EXECUTE_SUCCESS on success
+//                          ERR_NOT_MOUNTED if no image is mounted
+//                          ERR_IMAGE_IO if host file can not be written
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+int SyncImage()
+{
+    if(ImageFd < 0)
+    {
+        return ERR_NOT_MOUNTED;
+    }
+
+    WriteImageHeader();
+    JournalDirty(ImageBase, sizeof(bootobj));
+
+    return JournalCheckpoint();
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         UnmountImage
+//  Description :           Closes all files, marks the image clean, syncs it
+//                          and removes the mapping of host file. Journal is
+//                          empty after a clean unmount.
+//  Output :                EXECUTE_SUCCESS on success, error code on failure
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+int UnmountImage()
+{
+    int iRet = 0;
+
+    if(ImageFd < 0)
+    {
+        return ERR_NOT_MOUNTED;
+    }
+
+    CloseAllFiles();
+
+    superobj.State = STATE_CLEAN;
+
+    iRet = JournalCommit();
+    if(iRet == EXECUTE_SUCCESS)
+    {
+        iRet = SyncImage();
+    }
+
+    munmap(ImageBase, superobj.ImageSize);
+    close(ImageFd);
+    JournalRelease(&journalobj);
+
+    ImageBase = NULL;
+    ImageFd = -1;
+    ImagePath[0] = '\0';
+
+    return iRet;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         SaveImage
+//  Description :           Creates a new host file and writes the current
+//                          file system into it, header included.
+//  Input :                 path -> Host path of new image
+//  Output :                File descriptor of host file, -1 on failure
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+int SaveImage(
+                const char *path
+            )
+{
+    long long Done = 0;
+    ssize_t Ret = 0;
+    int fd = open(path, O_RDWR | O_CREAT | O_EXCL, 0644);
+
+    if(fd < 0)
+    {
+        return -1;
+    }
+
+    WriteImageHeader();
+
+    while(Done < superobj.ImageSize)
+    {
+        Ret = pwrite(fd, ImageBase + Done, superobj.ImageSize - Done, Done);
+        if(Ret <= 0)
+        {
+            close(fd);
+            unlink(path);
+            return -1;
+        }
+        Done = Done + Ret;
+    }
+
+    if(fsync(fd) != 0)
+    {
+        close(fd);
+        unlink(path);
+        return -1;
+    }
+
+    return fd;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         MountImage
+//  Description :           Mounts the CVFS image stored in a host file. The
+//                          header is validated (magic, version and layout)
+//                          and the whole file is memory mapped, so no file
+//                          data is read while mounting. Mapping is private:
+//                          changes reach the host file only through the
+//                          journal and checkpoint. Complete transactions of
+//                          the journal are replayed, which recovers every
+//                          operation committed before a crash. If the host
+//                          file does not exist, current file system is saved
+//                          into it first. Files opened on the previous file
+//                          system are closed.
+//  Input :                 path -> Host path of image
+//  Output :                EXECUTE_SUCCESS on success
+//                          ERR_INVALID_PARAMETER if path is missing or too long
+//                          ERR_IMAGE_IO if host file can not be used
+//                          ERR_IMAGE_INVALID if file is not a CVFS image
+//                          ERR_NO_MEMORY if locks or journal can not be allocated
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+int MountImage(
+                const char *path
+            )
+{
+    struct BootBlock Boot;
+    struct SuperBlock Super;
+    struct SuperBlock Expected;
+    struct stat Info;
+    char *base = NULL;
+    int fd = -1;
+    int i = 0;
+    int iRet = 0;
+    bool Created = false;
+    JOURNAL Next;
+    ORDERINDEX Order;
+    struct InodeLock *Locks = NULL;
+
+    if((path == NULL) || (path[0] == '\0') || (strlen(path) >= MAXPATHSIZE))
+    {
+        return ERR_INVALID_PARAMETER;
+    }
+
+    fd = open(path, O_RDWR);
+
+    if((fd < 0) && (errno == ENOENT))
+    {
+        fd = SaveImage(path);
+        Created = true;
+    }
+
+    if(fd < 0)
+    {
+        return ERR_IMAGE_IO;
+    }
+
+    //  Validate header before mapping anything
+    if((pread(fd, &Boot, sizeof(Boot), 0) != (ssize_t)sizeof(Boot)) ||
+       (pread(fd, &Super, sizeof(Super), SUPERBLOCKOFFSET) != (ssize_t)sizeof(Super)) ||
+       (fstat(fd, &Info) != 0))
+    {
+        close(fd);
+        return ERR_IMAGE_IO;
+    }
+
+    if((Boot.Magic != CVFS_MAGIC) || (Boot.Version != CVFS_VERSION))
+    {
+        close(fd);
+        return ERR_IMAGE_INVALID;
+    }
+
+    memcpy(&Expected, &Super, sizeof(Expected));
+    if((Super.TotalInodes <= 0) || (Super.TotalBlocks <= 0) ||
+       (Super.BlockSize < MINBLOCKSIZE) || ((Super.BlockSize & (Super.BlockSize - 1)) != 0) ||
+       (Super.InlineSize < 0) || (Super.InlineSize > INLINEDATASIZE) ||
+       ((Super.Dedup != 0) && (Super.Dedup != 1)) || ((Super.Compress != 0) && (Super.Compress != 1)))
+    {
+        close(fd);
+        return ERR_IMAGE_INVALID;
+    }
+
+    LayoutImage(&Expected);
+    if((memcmp(&Expected, &Super, sizeof(Super)) != 0) || (Info.st_size != Super.ImageSize))
+    {
+        close(fd);
+        return ERR_IMAGE_INVALID;
+    }
+
+    base = (char *)mmap(NULL, Super.ImageSize, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    if(base == MAP_FAILED)
+    {
+        close(fd);
+        return ERR_IMAGE_IO;
+    }
+
+    //  Recover committed operations before giving up the current file system
+    iRet = JournalOpen(&Next, path, Super.ImageSize, Created);
+    if((iRet == EXECUTE_SUCCESS) && (JournalReplay(&Next, base, Super.ImageSize) < 0))
+    {
+        iRet = ERR_IMAGE_IO;
+    }
+
+    Locks = CreateInodeLocks(Super.TotalInodes);
+    if((iRet == EXECUTE_SUCCESS) && (Locks == NULL))
+    {
+        iRet = ERR_NO_MEMORY;
+    }
+
+    //  Sorted names are not stored in image, they are collected from DILB
+    memset(&Order, 0, sizeof(Order));
+    Order.Table = (PINODE)(base + Super.DILBOffset);
+    Order.Seed = orderobj.Seed;
+    if((iRet == EXECUTE_SUCCESS) &&
+       (OrderIndexBuild(&Order, (PINODECORE)(base + Super.CoreOffset), Super.TotalInodes) == false))
+    {
+        iRet = ERR_NO_MEMORY;
+    }
+
+    if(iRet != EXECUTE_SUCCESS)
+    {
+        OrderIndexDestroy(&Order);
+        DestroyInodeLocks(Locks, Super.TotalInodes);
+        JournalRelease(&Next);
+        munmap(base, Super.ImageSize);
+        close(fd);
+        return iRet;
+    }
+
+    //  Replay may have changed the counters of super block
+    memcpy(&Super, base + SUPERBLOCKOFFSET, sizeof(Super));
+
+    //  Leave the previous file system
+    if(ImageFd >= 0)
+    {
+        UnmountImage();
+    }
+    else
+    {
+        CloseAllFiles();
+        CvfsFree(ImageBase, superobj.ImageSize);
+    }
+
+    DestroyInodeLocks(InodeLocks, superobj.TotalInodes);
+    InodeLocks = Locks;
+
+    OrderIndexDestroy(&orderobj);
+    memcpy(&orderobj, &Order, sizeof(orderobj));
+    DestroyDecompCache();
+
+    memcpy(&bootobj, &Boot, sizeof(bootobj));
+    memcpy(&superobj, &Super, sizeof(superobj));
+
+    AttachImage(base);
+    ImageFd = fd;
+    strcpy(ImagePath, path);
+    memcpy(&journalobj, &Next, sizeof(journalobj));
+    CrashCountdown = (getenv("CVFS_CRASH_POINT") != NULL) ? atoll(getenv("CVFS_CRASH_POINT")) : 0;
+
+    //  Reference counts of a crashed session are stale, no file is open now
+    //  Files unlinked while they were open are deleted now
+    if(superobj.State != STATE_CLEAN)
+    {
+        JournalBegin();
+
+        for(i = 0; i < superobj.TotalInodes; i++)
+        {
+            DILBCore[i].ReferenceCount = 0;
+
+            if((DILBCore[i].FileType != 0) && (DILB[i].FileName[0] == '\0'))
+            {
+                ReleaseInodeData(&DILB[i]);
+            }
+        }
+
+        JournalCommit();
+    }
+
+    superobj.State = STATE_DIRTY;
+
+    //  Image on host now matches the replayed state and is marked dirty
+    return SyncImage();
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         ReleaseAuxillaryData
+//  Description :           Releases everything created by
+//                          StartAuxillaryDataInitialisation(). Mounted image is
+//                          synced and unmapped, rest of CVFS memory is owned
+//                          by the arena, so it is released at once.
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+void ReleaseAuxillaryData()
+{
+    if(ImageFd >= 0)
+    {
+        UnmountImage();
+    }
+
+    DestroyInodeLocks(InodeLocks, superobj.TotalInodes);
+    InodeLocks = NULL;
+
+    DestroyDecompCache();
+    DestroyArena();
+
+    memset(&superobj, 0, sizeof(superobj));
+    memset(&uareaobj, 0, sizeof(uareaobj));
+    memset(&sessionobj, 0, sizeof(sessionobj));
+    CurrentUArea = &uareaobj;
+    memset(&indexobj, 0, sizeof(indexobj));
+    memset(&orderobj, 0, sizeof(orderobj));
+    memset(&dedupobj, 0, sizeof(dedupobj));
+    memset(&compressobj, 0, sizeof(compressobj));
+
+    DILB = NULL;
+    DILBCore = NULL;
+    FreeInodeList = NULL;
+    FreeBlockList = NULL;
+    BlockRecords = NULL;
+    Snapshots = NULL;
+    BlockPool = NULL;
+    ImageBase = NULL;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         SetInlineSize
+//  Description :           Changes the largest file whose data is kept inside
+//                          its inode instead of data blocks. It is stored in
+//                          the SuperBlock, so a mounted image keeps it. Files
+//                          created from now on use it; a file which is
+//                          already inline moves to blocks on its next write
+//                          beyond the new size.
+//  Input :                 bytes -> 0 to INLINEDATASIZE, 0 disables inline data
+//  Output :                EXECUTE_SUCCESS, ERR_INVALID_PARAMETER if out of range
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+int SetInlineSize(
+                    int bytes
+                )
+{
+    if((bytes < 0) || (bytes > INLINEDATASIZE))
+    {
+        return ERR_INVALID_PARAMETER;
+    }
+
+    //  SuperBlock is part of every transaction
+    JournalBegin();
+    __atomic_store_n(&superobj.InlineSize, bytes, __ATOMIC_RELAXED);
+
+    return JournalCommit();
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         SetDeduplication
+//  Description :           Turns block deduplication on or off. While it is
+//                          on, every data block written to its end is looked
+//                          up by fingerprint and shared with a block holding
+//                          the same bytes. Blocks shared earlier stay shared
+//                          when it is turned off. Stored in the SuperBlock.
+//  Input :                 enable -> true to deduplicate new writes
+//  Output :                EXECUTE_SUCCESS or error of journal commit
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+int SetDeduplication(
+                        bool enable
+                    )
+{
+    JournalBegin();
+    __atomic_store_n(&superobj.Dedup, (enable == true) ? 1 : 0, __ATOMIC_RELAXED);
+
+    return JournalCommit();
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         SetCompression
+//  Description :           Turns compression of new files on or off. Data of
+//                          a file created while it is on is compressed in
+//                          clusters of CLUSTERBLOCKS blocks. Files keep the
+//                          mode they were created with. Stored in the
+//                          SuperBlock.
+//  Input :                 enable -> true to compress files created from now on
+//  Output :                EXECUTE_SUCCESS or error of journal commit
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+int SetCompression(
+                    bool enable
+                )
+{
+    JournalBegin();
+    __atomic_store_n(&superobj.Compress, (enable == true) ? 1 : 0, __ATOMIC_RELAXED);
+
+    return JournalCommit();
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         IsFileExist
+//  Description :           It is used to check whether file is already exist or not
+//                          Name index is probed instead of walking the DILB,
+//                          so the cost does not depend on number of inodes.
+//                          A path costs one probe per directory in it.
+//  Input :                 It accepts file name,
+//                          Path of file or directory to be searched.
+//  Output :                true  -> file is present
+//                          false -> file is not present
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/01/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+bool IsFileExist(
+                    const char *name            //  File name
+                )
+{
+    PERF_SCOPE(PERF_LOOKUP);
+    bool bRet = false;
+
+    int number = 0;
+
+    pthread_mutex_lock(&NamespaceLock);
+    bRet = (WalkPath(name, &number, NULL) == EXECUTE_SUCCESS);
+    pthread_mutex_unlock(&NamespaceLock);
+
+    return bRet;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         ListFiles
+//  Description :           Copies files and directories whose name starts
+//                          with given prefix into entries, sorted by name.
+//                          Part of prefix up to its last PATHSEPARATOR names
+//                          the directory listed, otherwise working directory
+//                          is listed. Ordered index is searched for the first
+//                          name after cursor, so cost depends on number of
+//                          entries returned and not on number of inodes.
+//                          Unlinked files which are still open have no name
+//                          and are not listed.
+//  Input :                 prefix  -> Prefix of names, NULL or "" for all
+//                          entries -> Destination array
+//                          count   -> Entries in destination array
+//                          cursor  -> Continuation token, zero filled for first
+//                                     call, updated to last entry returned
+//  Output :                Number of entries filled, 0 after last file
+//                          Error code of path if directory can not be used
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+int ListFiles(
+                const char *prefix,
+                PFILEENTRY entries,
+                int count,
+                PLISTCURSOR cursor
+            )
+{
+    char Path[MAXPATHSIZE];     // Directory part of prefix
+    const char *Name = "";      // Name part of prefix
+    const char *Separator = NULL;
+    struct OrderNode *node = NULL;
+    PINODE temp = NULL;
+    int dir = CurrentUArea->Cwd;
+    int Length = 0;
+    int Filled = 0;
+    int iRet = EXECUTE_SUCCESS;
+
+    if((entries == NULL) || (count <= 0) || (cursor == NULL) ||
+       (memchr(cursor->After, '\0', MAXFILENAME) == NULL))
+    {
+        return ERR_INVALID_PARAMETER;
+    }
+
+    if(prefix != NULL)
+    {
+        Name = prefix;
+        Separator = strrchr(prefix, PATHSEPARATOR);
+    }
+
+    if(Separator != NULL)
+    {
+        Name = Separator + 1;
+        Length = (Separator == prefix) ? 1 : (int)(Separator - prefix);
+
+        if(Length >= MAXPATHSIZE)
+        {
+            return ERR_INVALID_PARAMETER;
+        }
+
+        memcpy(Path, prefix, Length);
+        Path[Length] = '\0';
+    }
+
+    if(strlen(Name) >= MAXFILENAME)
+    {
+        return ERR_INVALID_PARAMETER;
+    }
+
+    pthread_mutex_lock(&NamespaceLock);
+
+    if(Separator != NULL)
+    {
+        iRet = WalkPath(Path, &dir, NULL);
+
+        if((iRet == EXECUTE_SUCCESS) && (dir != ROOTDIRECTORY) && (DILBCore[dir - 1].FileType != DIRECTORYFILE))
+        {
+            iRet = ERR_NOT_DIRECTORY;
+        }
+    }
+
+    if(iRet != EXECUTE_SUCCESS)
+    {
+        pthread_mutex_unlock(&NamespaceLock);
+        return iRet;
+    }
+
+    //  Names with prefix are adjacent, listing starts at prefix or after cursor
+    if((cursor->After[0] != '\0') && (strcmp(cursor->After, Name) >= 0))
+    {
+        node = OrderIndexSeek(&orderobj, dir, cursor->After, true, NULL);
+    }
+    else
+    {
+        node = OrderIndexSeek(&orderobj, dir, Name, false, NULL);
+    }
+
+    Length = strlen(Name);
+
+    for(; (node != NULL) && (Filled < count); node = node->Next[0])
+    {
+        temp = &DILB[node->InodeNumber - 1];
+
+        if((temp->Parent != dir) || (strncmp(temp->FileName, Name, Length) != 0))
+        {
+            break;
+        }
+
+        memcpy(entries[Filled].Name, temp->FileName, MAXFILENAME);
+        entries[Filled].InodeNumber = temp->InodeNumber;
+        entries[Filled].Size = CoreOf(temp)->ActualFileSize;
+        entries[Filled].Directory = (CoreOf(temp)->FileType == DIRECTORYFILE);
+        Filled++;
+    }
+
+    pthread_mutex_unlock(&NamespaceLock);
+
+    if(Filled > 0)
+    {
+        memcpy(cursor->After, entries[Filled - 1].Name, MAXFILENAME);
+    }
+
+    return Filled;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         FileTableOf
+//  Description :           Returns the file table of given descriptor of the
+//                          session of calling thread. UFDT entries are
+//                          published atomically, so the table is seen
+//                          completely initialised. Capacity is read before
+//                          the array, and a grown array is published before
+//                          its capacity, so no lock is needed.
+//  Input :                 fd -> File descriptor
+//  Output :                File table, NULL if fd is invalid or not in use
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+PFILETABLE FileTableOf(
+                        int fd
+                    )
+{
+    PUAREA uarea = CurrentUArea;
+    PFILETABLE *UFDT = NULL;
+
+    if(fd < 0 || fd >= __atomic_load_n(&uarea->Capacity, __ATOMIC_ACQUIRE))
+    {
+        return NULL;
+    }
+
+    UFDT = __atomic_load_n(&uarea->UFDT, __ATOMIC_ACQUIRE);
+
+    return __atomic_load_n(&UFDT[fd], __ATOMIC_ACQUIRE);
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         AllocateDescriptor
+//  Description :           Stores file table in the lowest free UFDT entry
+//                          of the session of calling thread. Entry is found
+//                          with the descriptor bitmap in O(1), UFDT is
+//                          doubled when it is full. Descriptor lock of the
+//                          session is per session, so threads of different
+//                          sessions never wait for each other. It is taken
+//                          after JournalLock and before ArenaLock.
+//  Input :                 ptrfile -> Initialised file table
+//  Output :                File descriptor
+//                          ERR_MAX_FILES_OPEN if UFDT can not grow any more
+//                          ERR_NO_MEMORY if memory is not available
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+int AllocateDescriptor(
+                        PFILETABLE ptrfile
+                    )
+{
+    PUAREA uarea = CurrentUArea;
+    int fd = 0;
+    int iRet = 0;
+
+    pthread_mutex_lock(&uarea->FdLock);
+
+    // Note : 0 1 2 are reserved, their bits are always set
+    fd = FindFreeDescriptor(uarea);
+
+    if(fd < 0)
+    {
+        iRet = GrowDescriptors(uarea);
+
+        if(iRet != EXECUTE_SUCCESS)
+        {
+            pthread_mutex_unlock(&uarea->FdLock);
+            return iRet;
+        }
+
+        fd = FindFreeDescriptor(uarea);
+    }
+
+    MarkDescriptor(uarea, fd, true);
+    uarea->OpenCount++;
+    __atomic_store_n(&uarea->UFDT[fd], ptrfile, __ATOMIC_RELEASE);
+
+    pthread_mutex_unlock(&uarea->FdLock);
+
+    return fd;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         CreateSession
+//  Description :           Creates a new session (UAREA) with an empty UFDT
+//                          and gives it the lowest free session number.
+//  Input :                 name -> Process name of session
+//  Output :                New session, NULL if memory is not available
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+PUAREA CreateSession(
+                        const char *name
+                    )
+{
+    PUAREA uarea = (PUAREA)CvfsAlloc(sizeof(UAREA));
+    PUAREA *Sessions = NULL;
+    int i = 0;
+
+    if(uarea == NULL)
+    {
+        return NULL;
+    }
+
+    memset(uarea, 0, sizeof(UAREA));
+    strncpy(uarea->ProcessName, name, sizeof(uarea->ProcessName) - 1);
+
+    if(InitialiseDescriptors(uarea) == false)
+    {
+        CvfsFree(uarea, sizeof(UAREA));
+        return NULL;
+    }
+
+    pthread_mutex_lock(&SessionLock);
+
+    for(i = 0; i < sessionobj.Capacity; i++)
+    {
+        if(sessionobj.Sessions[i] == NULL)
+        {
+            break;
+        }
+    }
+
+    //  Table is full, double it
+    if(i == sessionobj.Capacity)
+    {
+        Sessions = (PUAREA *)CvfsAlloc(2 * sessionobj.Capacity * sizeof(PUAREA));
+        if(Sessions == NULL)
+        {
+            pthread_mutex_unlock(&SessionLock);
+            DestroyDescriptors(uarea);
+            CvfsFree(uarea, sizeof(UAREA));
+            return NULL;
+        }
+
+        memset(Sessions, 0, 2 * sessionobj.Capacity * sizeof(PUAREA));
+        memcpy(Sessions, sessionobj.Sessions, sessionobj.Capacity * sizeof(PUAREA));
+        CvfsFree(sessionobj.Sessions, sessionobj.Capacity * sizeof(PUAREA));
+
+        sessionobj.Sessions = Sessions;
+        sessionobj.Capacity = 2 * sessionobj.Capacity;
+    }
+
+    sessionobj.Sessions[i] = uarea;
+    sessionobj.Count++;
+    uarea->SessionId = i + 1;
+
+    pthread_mutex_unlock(&SessionLock);
+
+    return uarea;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         SessionOf
+//  Description :           Returns the session with given number.
+//  Input :                 id -> Session number
+//  Output :                Session, NULL if there is no such session
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+PUAREA SessionOf(
+                    int id
+                )
+{
+    PUAREA uarea = NULL;
+
+    pthread_mutex_lock(&SessionLock);
+
+    if((id >= 1) && (id <= sessionobj.Capacity))
+    {
+        uarea = sessionobj.Sessions[id - 1];
+    }
+
+    pthread_mutex_unlock(&SessionLock);
+
+    return uarea;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         SwitchSession
+//  Description :           Makes given session the session of calling thread.
+//                          Descriptors passed to the file API are looked up
+//                          in the UFDT of this session.
+//  Input :                 uarea -> Session
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+void SwitchSession(
+                    PUAREA uarea
+                )
+{
+    CurrentUArea = uarea;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         DestroySession
+//  Description :           Releases every descriptor and working directory of
+//                          a session and removes it from the session table.
+//                          The shell session (1)
+//                          and the session of calling thread can not be
+//                          destroyed.
+//  Input :                 uarea -> Session
+//  Output :                EXECUTE_SUCCESS on success
+//                          ERR_INVALID_PARAMETER for shell or current session
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+int DestroySession(
+                    PUAREA uarea
+                )
+{
+    int fd = 0;
+
+    if((uarea == NULL) || (uarea == &uareaobj) || (uarea == CurrentUArea))
+    {
+        return ERR_INVALID_PARAMETER;
+    }
+
+    for(fd = FDRESERVED; fd < uarea->Capacity; fd++)
+    {
+        ReleaseDescriptor(uarea, fd);
+    }
+
+    pthread_mutex_lock(&NamespaceLock);
+    ReleaseDirectory(uarea->Cwd);
+    pthread_mutex_unlock(&NamespaceLock);
+
+    pthread_mutex_lock(&SessionLock);
+    sessionobj.Sessions[uarea->SessionId - 1] = NULL;
+    sessionobj.Count--;
+    pthread_mutex_unlock(&SessionLock);
+
+    DestroyDescriptors(uarea);
+    CvfsFree(uarea, sizeof(UAREA));
+
+    return EXECUTE_SUCCESS;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         ForkSession
+//  Description :           Creates a child of given session, like fork().
+//                          Every descriptor of the parent is copied and refers
+//                          the same file table entry, so parent and child
+//                          share read and write offsets. UFDT of child is
+//                          grown to the size of UFDT of parent.
+//  Input :                 parent -> Session to be copied
+//  Output :                Child session, NULL if memory is not available
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+PUAREA ForkSession(
+                    PUAREA parent
+                )
+{
+    PUAREA child = CreateSession(parent->ProcessName);
+    PFILETABLE ptrfile = NULL;
+    int fd = 0;
+
+    if(child == NULL)
+    {
+        return NULL;
+    }
+
+    //  Child starts in working directory of parent
+    pthread_mutex_lock(&NamespaceLock);
+    child->Cwd = parent->Cwd;
+    HoldDirectory(child->Cwd);
+    pthread_mutex_unlock(&NamespaceLock);
+
+    pthread_mutex_lock(&parent->FdLock);
+
+    //  Child is not used by any thread yet, its lock is not needed
+    while(child->Capacity < parent->Capacity)
+    {
+        if(GrowDescriptors(child) != EXECUTE_SUCCESS)
+        {
+            pthread_mutex_unlock(&parent->FdLock);
+            DestroySession(child);
+            return NULL;
+        }
+    }
+
+    for(fd = FDRESERVED; fd < parent->Capacity; fd++)
+    {
+        ptrfile = parent->UFDT[fd];
+
+        if(ptrfile != NULL)
+        {
+            __atomic_add_fetch(&ptrfile->Count, 1, __ATOMIC_RELAXED);
+            child->UFDT[fd] = ptrfile;
+            MarkDescriptor(child, fd, true);
+            child->OpenCount++;
+        }
+    }
+
+    pthread_mutex_unlock(&parent->FdLock);
+
+    return child;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         DupFile
+//  Description :           Creates a second descriptor for an open file, like
+//                          dup(). Both refer the same file table entry.
+//  Input :                 fd -> Open file descriptor
+//  Output :                New descriptor (lowest free one) or error code
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+int DupFile(
+                int fd
+            )
+{
+    PFILETABLE ptrfile = FileTableOf(fd);
+    int NewFd = 0;
+
+    if(fd < 0)
+    {
+        return ERR_INVALID_PARAMETER;
+    }
+
+    if(ptrfile == NULL)
+    {
+        return ERR_FILE_NOT_EXIST;
+    }
+
+    __atomic_add_fetch(&ptrfile->Count, 1, __ATOMIC_RELAXED);
+
+    NewFd = AllocateDescriptor(ptrfile);
+
+    if(NewFd < 0)
+    {
+        __atomic_sub_fetch(&ptrfile->Count, 1, __ATOMIC_RELAXED);
+    }
+
+    return NewFd;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         CreateFile
+//  Description :           This function creates a new regular file
+//  Working :               - Validates parameters
+//                          - Checks free inode availability
+//                          - Checks duplicate file name
+//                          - Allocates inode and file table
+//                          - Updates super block information
+//                          Data blocks are allocated later by WriteFile()
+//                          Safe to call from many threads, names are
+//                          checked and inserted under NamespaceLock.
+//  Input :                 It accepts -
+//                                   name        -> Name of file
+//                                   permission  -> 1(Read),2(Write),3(Read+Write)
+//  Output :                It returns File descriptor on success
+//                          Error code on failure
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/01/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+int CreateFile(
+                    const char *name,             // Path of new file
+                    int permission          // Permission for that file
+                )
+{
+    PERF_SCOPE(PERF_CREATE);
+    PINODE temp = NULL;
+    PFILETABLE ptrfile = NULL;
+    struct OrderNode *node = NULL;
+    char Leaf[MAXFILENAME];     // Name of file inside its directory
+    int parent = 0;
+    int fd = 0;
+    int iRet = 0;
+
+    //  If name is missing
+    if(name == NULL)
+    {
+        return ERR_INVALID_PARAMETER;
+    }
+
+    //  If the permission value is wrong
+    //  permission -> 1 -> READ
+    //  permission -> 2 -> WRITE
+    //  permission -> 3 -> READ + WRITE
+    if(permission < 1 || permission > 3)
+    {
+        return ERR_INVALID_PARAMETER;
+    }
+
+    //  Allocate memory for file table and ordered index before taking any lock
+    ptrfile = (PFILETABLE)CvfsAlloc(sizeof(FILETABLE));
+    node = OrderNodeCreate(&orderobj);
+
+    if((ptrfile == NULL) || (node == NULL))
+    {
+        CvfsFree(ptrfile, sizeof(FILETABLE));
+        OrderNodeFree(node);
+        return ERR_NO_MEMORY;
+    }
+
+    //  Name check and inode allocation must not be separated
+    pthread_mutex_lock(&NamespaceLock);
+
+    //  Directory must exist and name must fit into inode
+    fd = WalkPath(name, &parent, Leaf);
+
+    if(fd != EXECUTE_SUCCESS)
+    {
+        pthread_mutex_unlock(&NamespaceLock);
+        CvfsFree(ptrfile, sizeof(FILETABLE));
+        OrderNodeFree(node);
+        return fd;
+    }
+
+    //  If file is already present
+    if(NameIndexLookup(&indexobj, parent, Leaf) != NULL)
+    {
+        pthread_mutex_unlock(&NamespaceLock);
+        CvfsFree(ptrfile, sizeof(FILETABLE));
+        OrderNodeFree(node);
+        return ERR_FILE_ALREADY_EXIST;
+    }
+
+    JournalBegin();
+
+    //  Take empty Inode from free inode list
+    temp = AllocateInode();
+
+    if(temp == NULL)
+    {
+        JournalCommit();
+        pthread_mutex_unlock(&NamespaceLock);
+        CvfsFree(ptrfile, sizeof(FILETABLE));
+        OrderNodeFree(node);
+        return ERR_NO_INODES;
+    }
+
+    //  Initialise File Table and connect it with Inode
+    ptrfile->ReadOffset = 0;
+    ptrfile->WriteOffset = 0;
+    ptrfile->Mode = permission;
+    ptrfile->Count = 1;
+    ptrfile->ptrinode = temp;
+
+    //  Take lowest free UFDT entry
+    fd = AllocateDescriptor(ptrfile);
+
+    //  UFDT can not grow
+    if(fd < 0)
+    {
+        ReleaseInode(temp);
+        JournalCommit();
+        pthread_mutex_unlock(&NamespaceLock);
+        CvfsFree(ptrfile, sizeof(FILETABLE));
+        OrderNodeFree(node);
+        return fd;
+    }
+
+    //  Initialise elements of Inode
+    strcpy(temp->FileName,Leaf);
+    temp->Parent = parent;
+    temp->FileSize = 0;
+    CoreOf(temp)->ActualFileSize = 0;
+    CoreOf(temp)->FileType = REGULARFILE;
+    CoreOf(temp)->ReferenceCount = 1;
+    temp->Permission = permission;
+
+    //  No data blocks until first write, small data stays in inode
+    memset(temp->Block, 0, sizeof(temp->Block));
+    temp->Flags = (superobj.InlineSize > 0) ? INODE_INLINE : 0;
+    temp->Flags = temp->Flags | ((superobj.Compress != 0) ? INODE_COMPRESS : 0);
+
+    //  Make the file visible to name lookups
+    NameIndexInsert(&indexobj, temp);
+    OrderIndexInsert(&orderobj, node, temp);
+    AddDirectoryEntry(parent, 1);
+
+    JournalDirty(temp, sizeof(*temp));
+    JournalDirty(CoreOf(temp), sizeof(INODECORE));
+    iRet = JournalCommit();
+
+    pthread_mutex_unlock(&NamespaceLock);
+
+    __atomic_add_fetch(&OpenFileTables, 1, __ATOMIC_RELAXED);
+
+    //  Create was not logged, descriptor is not given out
+    if(iRet != EXECUTE_SUCCESS)
+    {
+        CloseFile(fd);
+        return iRet;
+    }
+
+    return fd;           // File descriptor
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         OpenFile
+//  Description :           This function opens an existing file, like open()
+//  Working :               - Validates parameters
+//                          - Finds the file with name index
+//                          - Checks requested mode against permission of file
+//                          - Creates a new file table entry with offsets 0
+//                          - Increments reference count of inode
+//                          Every open gets its own file table entry, so two
+//                          opens of one file do not share offsets.
+//  Input :                 It accepts -
+//                                   name -> Path of file
+//                                   mode -> 1(Read),2(Write),3(Read+Write)
+//  Output :                It returns lowest free File descriptor on success
+//                          Error code on failure
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+int OpenFile(
+                const char *name,             // Name of existing file
+                int mode                // Mode of opening
+            )
+{
+    PERF_SCOPE(PERF_OPEN);
+    PINODE temp = NULL;
+    PFILETABLE ptrfile = NULL;
+    int number = 0;
+    int fd = 0;
+
+    if((name == NULL) || (mode < READ) || (mode > (READ + WRITE)))
+    {
+        return ERR_INVALID_PARAMETER;
+    }
+
+    //  Allocate memory for file table before taking any lock
+    ptrfile = (PFILETABLE)CvfsAlloc(sizeof(FILETABLE));
+
+    if(ptrfile == NULL)
+    {
+        return ERR_NO_MEMORY;
+    }
+
+    //  Inode must not be released by unlink while reference is taken
+    pthread_mutex_lock(&NamespaceLock);
+
+    fd = WalkPath(name, &number, NULL);
+
+    if(fd != EXECUTE_SUCCESS)
+    {
+        pthread_mutex_unlock(&NamespaceLock);
+        CvfsFree(ptrfile, sizeof(FILETABLE));
+        return fd;
+    }
+
+    //  Directories have no data to read or write
+    if((number == ROOTDIRECTORY) || (DILBCore[number - 1].FileType == DIRECTORYFILE))
+    {
+        pthread_mutex_unlock(&NamespaceLock);
+        CvfsFree(ptrfile, sizeof(FILETABLE));
+        return ERR_IS_DIRECTORY;
+    }
+
+    temp = &DILB[number - 1];
+
+    //  Every bit of mode must be allowed by the file
+    if((mode & temp->Permission) != mode)
+    {
+        pthread_mutex_unlock(&NamespaceLock);
+        CvfsFree(ptrfile, sizeof(FILETABLE));
+        return ERR_PERMISSION_DENIED;
+    }
+
+    CoreOf(temp)->ReferenceCount++;
+
+    pthread_mutex_unlock(&NamespaceLock);
+
+    ptrfile->ReadOffset = 0;
+    ptrfile->WriteOffset = 0;
+    ptrfile->Mode = mode;
+    ptrfile->Count = 1;
+    ptrfile->ptrinode = temp;
+
+    __atomic_add_fetch(&OpenFileTables, 1, __ATOMIC_RELAXED);
+
+    fd = AllocateDescriptor(ptrfile);
+
+    //  Drops the reference again, releases file if it was unlinked meanwhile
+    if(fd < 0)
+    {
+        ReleaseFileTable(ptrfile);
+    }
+
+    return fd;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         CloseFile
+//  Description :           This function closes a file descriptor of the
+//                          session of calling thread, like close(). File
+//                          table entry is released with its last descriptor
+//                          and inode is released with its last reference if
+//                          file was unlinked.
+//  Input :                 fd -> File descriptor
+//  Output :                EXECUTE_SUCCESS on success
+//                          ERR_INVALID_PARAMETER if fd is negative
+//                          ERR_FILE_NOT_EXIST if fd is not in use
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+int CloseFile(
+                int fd
+            )
+{
+    if(fd < 0)
+    {
+        return ERR_INVALID_PARAMETER;
+    }
+
+    if(ReleaseDescriptor(CurrentUArea, fd) == false)
+    {
+        return ERR_FILE_NOT_EXIST;
+    }
+
+    return EXECUTE_SUCCESS;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         UnlinkFile()
+//  Description :           This function deletes an existing file from
+//                          the virtual file system.
+//  Working :               - Finds inode of file using name index
+//                          - Removes the name of file from its directory
+//                          - If no file table refers the inode, releases
+//                            data blocks, resets inode metadata and
+//                            increments free inode count
+//                          - Otherwise the file stays readable through its
+//                            open descriptors and is deleted when the last
+//                            of them is released (like UNIX unlink)
+//  Input :                 Path of file to be deleted.
+//  Return :                EXECUTE_SUCCESS on success
+//                          Error code on failure
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  22/01/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+int UnlinkFile(
+                    const char *name
+                )
+{
+    PERF_SCOPE(PERF_UNLINK);
+    PINODE temp = NULL;
+    char Leaf[MAXFILENAME];     // Name of file inside its directory
+    int parent = 0;
+    int iRet = 0;
+
+    if(name == NULL)
+    {
+        return ERR_INVALID_PARAMETER;
+    }
+
+    pthread_mutex_lock(&NamespaceLock);
+
+    iRet = WalkPath(name, &parent, Leaf);
+
+    if(iRet != EXECUTE_SUCCESS)
+    {
+        pthread_mutex_unlock(&NamespaceLock);
+        return iRet;
+    }
+
+    temp = NameIndexLookup(&indexobj, parent, Leaf);
+
+    if(temp == NULL)
+    {
+        pthread_mutex_unlock(&NamespaceLock);
+        return ERR_FILE_NOT_EXIST;
+    }
+
+    //  Directories are removed by RemoveDirectory()
+    if(CoreOf(temp)->FileType == DIRECTORYFILE)
+    {
+        pthread_mutex_unlock(&NamespaceLock);
+        return ERR_IS_DIRECTORY;
+    }
+
+    pthread_rwlock_wrlock(LockOf(temp));
+    JournalBegin();
+
+    //  Remove the name before it gets erased from inode
+    NameIndexRemove(&indexobj, parent, Leaf);
+    OrderIndexRemove(&orderobj, parent, Leaf);
+    AddDirectoryEntry(parent, -1);
+
+    if(CoreOf(temp)->ReferenceCount == 0)
+    {
+        ReleaseInodeData(temp);
+    }
+    else
+    {
+        //  Open descriptors keep the data until the last one is closed
+        memset(temp->FileName, '\0', sizeof(temp->FileName));
+        JournalDirty(temp, sizeof(*temp));
+    }
+
+    iRet = JournalCommit();
+
+    pthread_rwlock_unlock(LockOf(temp));
+    pthread_mutex_unlock(&NamespaceLock);
+
+    return iRet;
+}               //  End of Function
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         CloneFile
+//  Description :           Copies a file like cp --reflink. New inode gets
+//                          the block pointers of source and every root block
+//                          one more reference, so no data is copied : both
+//                          files share the blocks until one of them writes,
+//                          which copies only the blocks it changes. Inline
+//                          data is copied with the inode.
+//  Input :                 source -> Path of file to be copied
+//                          name   -> Path of new file
+//  Output :                EXECUTE_SUCCESS on success
+//                          ERR_FILE_NOT_EXIST if source is missing
+//                          ERR_IS_DIRECTORY if source is a directory
+//                          ERR_PERMISSION_DENIED if source is not readable
+//                          ERR_FILE_ALREADY_EXIST if new name is in use
+//                          Error code of path on failure
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+int CloneFile(
+                const char *source,
+                const char *name
+            )
+{
+    PINODE from = NULL;
+    PINODE temp = NULL;
+    struct OrderNode *node = NULL;
+    char Leaf[MAXFILENAME];     // Name of new file inside its directory
+    int number = 0;
+    int parent = 0;
+    int iRet = 0;
+
+    if((source == NULL) || (name == NULL))
+    {
+        return ERR_INVALID_PARAMETER;
+    }
+
+    node = OrderNodeCreate(&orderobj);
+    if(node == NULL)
+    {
+        return ERR_NO_MEMORY;
+    }
+
+    pthread_mutex_lock(&NamespaceLock);
+
+    iRet = WalkPath(source, &number, NULL);
+
+    if((iRet == EXECUTE_SUCCESS) &&
+       ((number == ROOTDIRECTORY) || (DILBCore[number - 1].FileType == DIRECTORYFILE)))
+    {
+        iRet = ERR_IS_DIRECTORY;
+    }
+
+    if((iRet == EXECUTE_SUCCESS) && ((DILB[number - 1].Permission & READ) == 0))
+    {
+        iRet = ERR_PERMISSION_DENIED;
+    }
+
+    if(iRet == EXECUTE_SUCCESS)
+    {
+        iRet = WalkPath(name, &parent, Leaf);
+    }
+
+    if((iRet == EXECUTE_SUCCESS) && (NameIndexLookup(&indexobj, parent, Leaf) != NULL))
+    {
+        iRet = ERR_FILE_ALREADY_EXIST;
+    }
+
+    if(iRet != EXECUTE_SUCCESS)
+    {
+        pthread_mutex_unlock(&NamespaceLock);
+        OrderNodeFree(node);
+        return iRet;
+    }
+
+    from = &DILB[number - 1];
+
+    //  Writer of source finishes before its blocks are shared
+    pthread_rwlock_rdlock(LockOf(from));
+    JournalBegin();
+
+    temp = AllocateInode();
+
+    if(temp == NULL)
+    {
+        JournalCommit();
+        pthread_rwlock_unlock(LockOf(from));
+        pthread_mutex_unlock(&NamespaceLock);
+        OrderNodeFree(node);
+        return ERR_NO_INODES;
+    }
+
+    strcpy(temp->FileName,Leaf);
+    temp->Parent = parent;
+    temp->FileSize = from->FileSize;
+    temp->Permission = from->Permission;
+    temp->Flags = from->Flags;
+    memcpy(temp->Block, from->Block, sizeof(temp->Block));
+
+    CoreOf(temp)->ActualFileSize = CoreOf(from)->ActualFileSize;
+    CoreOf(temp)->FileType = REGULARFILE;
+    CoreOf(temp)->ReferenceCount = 0;
+
+    HoldFileBlocks(temp);
+
+    NameIndexInsert(&indexobj, temp);
+    OrderIndexInsert(&orderobj, node, temp);
+    AddDirectoryEntry(parent, 1);
+
+    JournalDirty(temp, sizeof(*temp));
+    JournalDirty(CoreOf(temp), sizeof(INODECORE));
+    iRet = JournalCommit();
+
+    pthread_rwlock_unlock(LockOf(from));
+    pthread_mutex_unlock(&NamespaceLock);
+
+    return iRet;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         MakeDirectory
+//  Description :           Creates an empty directory, like mkdir(). Directory
+//                          is an inode without data, its entries are the
+//                          inodes whose Parent is it.
+//  Input :                 path -> Path of new directory
+//  Output :                EXECUTE_SUCCESS on success
+//                          Error code on failure
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+int MakeDirectory(
+                    const char *path
+                )
+{
+    PINODE temp = NULL;
+    struct OrderNode *node = OrderNodeCreate(&orderobj);
+    char Leaf[MAXFILENAME];     // Name of directory inside its parent
+    int parent = 0;
+    int iRet = 0;
+
+    if(node == NULL)
+    {
+        return ERR_NO_MEMORY;
+    }
+
+    pthread_mutex_lock(&NamespaceLock);
+
+    iRet = WalkPath(path, &parent, Leaf);
+
+    if(iRet != EXECUTE_SUCCESS)
+    {
+        pthread_mutex_unlock(&NamespaceLock);
+        OrderNodeFree(node);
+        return iRet;
+    }
+
+    if(NameIndexLookup(&indexobj, parent, Leaf) != NULL)
+    {
+        pthread_mutex_unlock(&NamespaceLock);
+        OrderNodeFree(node);
+        return ERR_FILE_ALREADY_EXIST;
+    }
+
+    JournalBegin();
+
+    temp = AllocateInode();
+
+    if(temp == NULL)
+    {
+        JournalCommit();
+        pthread_mutex_unlock(&NamespaceLock);
+        OrderNodeFree(node);
+        return ERR_NO_INODES;
+    }
+
+    strcpy(temp->FileName,Leaf);
+    temp->Parent = parent;
+    temp->FileSize = 0;
+    temp->Permission = READ + WRITE;
+    temp->Flags = 0;
+    memset(temp->Block, 0, sizeof(temp->Block));
+
+    CoreOf(temp)->ActualFileSize = 0;
+    CoreOf(temp)->FileType = DIRECTORYFILE;
+    CoreOf(temp)->ReferenceCount = 0;
+
+    NameIndexInsert(&indexobj, temp);
+    OrderIndexInsert(&orderobj, node, temp);
+    AddDirectoryEntry(parent, 1);
+
+    JournalDirty(temp, sizeof(*temp));
+    JournalDirty(CoreOf(temp), sizeof(INODECORE));
+    iRet = JournalCommit();
+
+    pthread_mutex_unlock(&NamespaceLock);
+
+    return iRet;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         RemoveDirectory
+//  Description :           Removes an empty directory, like rmdir(). A
+//                          directory which is working directory of a
+//                          session holds a reference and is not removed.
+//  Input :                 path -> Path of directory
+//  Output :                EXECUTE_SUCCESS on success
+//                          ERR_DIRECTORY_NOT_EMPTY if it has entries
+//                          ERR_DIRECTORY_BUSY if a session works in it
+//                          Error code of path on failure
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+int RemoveDirectory(
+                        const char *path
+                    )
+{
+    PINODE temp = NULL;
+    char Leaf[MAXFILENAME];     // Name of directory inside its parent
+    int parent = 0;
+    int iRet = 0;
+
+    pthread_mutex_lock(&NamespaceLock);
+
+    iRet = WalkPath(path, &parent, Leaf);
+
+    if(iRet != EXECUTE_SUCCESS)
+    {
+        pthread_mutex_unlock(&NamespaceLock);
+        return iRet;
+    }
+
+    temp = NameIndexLookup(&indexobj, parent, Leaf);
+
+    if(temp == NULL)
+    {
+        iRet = ERR_FILE_NOT_EXIST;
+    }
+    else if(CoreOf(temp)->FileType != DIRECTORYFILE)
+    {
+        iRet = ERR_NOT_DIRECTORY;
+    }
+    else if(CoreOf(temp)->ActualFileSize != 0)
+    {
+        iRet = ERR_DIRECTORY_NOT_EMPTY;
+    }
+    else if(CoreOf(temp)->ReferenceCount != 0)
+    {
+        iRet = ERR_DIRECTORY_BUSY;
+    }
+
+    if(iRet != EXECUTE_SUCCESS)
+    {
+        pthread_mutex_unlock(&NamespaceLock);
+        return iRet;
+    }
+
+    JournalBegin();
+
+    NameIndexRemove(&indexobj, parent, Leaf);
+    OrderIndexRemove(&orderobj, parent, Leaf);
+    AddDirectoryEntry(parent, -1);
+    ReleaseInodeData(temp);
+
+    iRet = JournalCommit();
+
+    pthread_mutex_unlock(&NamespaceLock);
+
+    return iRet;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         ChangeDirectory
+//  Description :           Makes given directory the working directory of the
+//                          session of calling thread, like chdir(). Relative
+//                          paths of the session start from it.
+//  Input :                 path -> Path of directory
+//  Output :                EXECUTE_SUCCESS on success
+//                          ERR_NOT_DIRECTORY if path names a file
+//                          Error code of path on failure
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+int ChangeDirectory(
+                        const char *path
+                    )
+{
+    int number = 0;
+    int iRet = 0;
+
+    pthread_mutex_lock(&NamespaceLock);
+
+    iRet = WalkPath(path, &number, NULL);
+
+    if((iRet == EXECUTE_SUCCESS) && (number != ROOTDIRECTORY) &&
+       (DILBCore[number - 1].FileType != DIRECTORYFILE))
+    {
+        iRet = ERR_NOT_DIRECTORY;
+    }
+
+    if(iRet == EXECUTE_SUCCESS)
+    {
+        HoldDirectory(number);
+        ReleaseDirectory(CurrentUArea->Cwd);
+        CurrentUArea->Cwd = number;
+    }
+
+    pthread_mutex_unlock(&NamespaceLock);
+
+    return iRet;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         GetWorkingDirectory
+//  Description :           Copies absolute path of working directory of the
+//                          session of calling thread, like getcwd(). Path is
+//                          built from the end by following Parent to root.
+//  Input :                 buffer -> Destination of path
+//                          size   -> Bytes in buffer
+//  Output :                Length of path, ERR_INVALID_PARAMETER if buffer is
+//                          missing or too small
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+int GetWorkingDirectory(
+                            char *buffer,
+                            int size
+                        )
+{
+    int Position = size - 1;    // Start of path built so far
+    int Length = 0;
+    int dir = 0;
+
+    if((buffer == NULL) || (size < 2))
+    {
+        return ERR_INVALID_PARAMETER;
+    }
+
+    buffer[Position] = '\0';
+
+    pthread_mutex_lock(&NamespaceLock);
+
+    for(dir = CurrentUArea->Cwd; dir != ROOTDIRECTORY; dir = DILB[dir - 1].Parent)
+    {
+        Length = (int)strlen(DILB[dir - 1].FileName);
+
+        if(Position < Length + 1)
+        {
+            pthread_mutex_unlock(&NamespaceLock);
+            return ERR_INVALID_PARAMETER;
+        }
+
+        Position = Position - Length;
+        memcpy(buffer + Position, DILB[dir - 1].FileName, Length);
+        Position--;
+        buffer[Position] = PATHSEPARATOR;
+    }
+
+    pthread_mutex_unlock(&NamespaceLock);
+
+    //  Root itself
+    if(Position == size - 1)
+    {
+        Position--;
+        buffer[Position] = PATHSEPARATOR;
+    }
+
+    memmove(buffer, buffer + Position, size - Position);
+
+    return size - 1 - Position;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         FindSnapshot
+//  Description :           Finds the snapshot record with given name. Caller
+//                          holds NamespaceLock.
+//  Input :                 name -> Name of snapshot
+//  Output :                Record of snapshot, NULL if there is none
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+PSNAPSHOT FindSnapshot(
+                        const char *name
+                    )
+{
+    int i = 0;
+
+    for(i = 0; i < MAXSNAPSHOTS; i++)
+    {
+        if((Snapshots[i].Name[0] != '\0') && (strcmp(Snapshots[i].Name, name) == 0))
+        {
+            return &Snapshots[i];
+        }
+    }
+
+    return NULL;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         SnapshotCopy
+//  Description :           Copies bytes between a buffer and the blocks of
+//                          the table inode of a snapshot. Table is metadata,
+//                          so stored bytes are journaled as such.
+//  Input :                 table  -> Table inode of snapshot
+//                          offset -> Offset in table of first byte
+//                          data   -> Buffer of size bytes
+//                          size   -> Number of bytes
+//                          store  -> true to copy data into table (blocks
+//                                    are allocated), false to load from it
+//  Output :                EXECUTE_SUCCESS, ERR_INSUFFICIENT_SPACE if no
+//                          block is free
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+int SnapshotCopy(
+                    PINODE table,
+                    long long offset,
+                    char *data,
+                    int size,
+                    bool store
+                )
+{
+    int Done = 0;
+    int Chunk = 0;
+    int Within = 0;
+    int block = 0;
+
+    while(Done < size)
+    {
+        Within = (offset + Done) & (superobj.BlockSize - 1);
+
+        Chunk = superobj.BlockSize - Within;
+        if(Chunk > (size - Done))
+        {
+            Chunk = size - Done;
+        }
+
+        block = MapBlock(table, (offset + Done) >> BlockShift, store, NULL);
+        if(block < 0)
+        {
+            return block;
+        }
+
+        if(store == true)
+        {
+            memcpy(BlockData(block) + Within, data + Done, Chunk);
+            JournalDirty(BlockData(block) + Within, Chunk);
+        }
+        else if(block == 0)
+        {
+            memset(data + Done, 0, Chunk);
+        }
+        else
+        {
+            memcpy(data + Done, BlockData(block) + Within, Chunk);
+        }
+
+        Done = Done + Chunk;
+    }
+
+    return EXECUTE_SUCCESS;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         SnapshotSearch
+//  Description :           Scans the entries of a snapshot for a file. Caller
+//                          holds NamespaceLock.
+//  Input :                 snapshot -> Record of snapshot
+//                          parent   -> Directory holding the file, or inode
+//                                      number of the file if name is NULL
+//                          name     -> Name of file, NULL to search by number
+//                          entry    -> Receives the entry
+//  Output :                true if the file was found
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+bool SnapshotSearch(
+                        PSNAPSHOT snapshot,
+                        int parent,
+                        const char *name,
+                        PSNAPSHOTENTRY entry
+                    )
+{
+    int i = 0;
+
+    for(i = 0; i < snapshot->Files; i++)
+    {
+        SnapshotCopy(&snapshot->Table, (long long)i * sizeof(SNAPSHOTENTRY), (char *)entry, sizeof(SNAPSHOTENTRY), false);
+
+        if(name == NULL)
+        {
+            if(entry->Inode.InodeNumber == parent)
+            {
+                return true;
+            }
+        }
+        else if((entry->Inode.Parent == parent) && (strcmp(entry->Inode.FileName, name) == 0))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         CreateSnapshot
+//  Description :           Freezes the current file system under given name.
+//                          Hot and cold fields of every named inode are
+//                          copied into the table of the snapshot and every
+//                          root block pointer gets one more reference. No
+//                          data is copied : blocks stay shared until a live
+//                          file writes them, which copies them on write.
+//                          Writers of every file are held off by read locks
+//                          of inodes while the copy is taken.
+//  Input :                 name -> Name of snapshot
+//  Output :                EXECUTE_SUCCESS on success
+//                          ERR_FILE_ALREADY_EXIST if name is in use
+//                          ERR_NO_SNAPSHOTS if every record is in use
+//                          ERR_INSUFFICIENT_SPACE if table does not fit
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+int CreateSnapshot(
+                    const char *name
+                )
+{
+    PSNAPSHOT Record = NULL;
+    SNAPSHOTENTRY Entry;
+    long long Offset = 0;
+    int Files = 0;
+    int i = 0;
+    int iRet = EXECUTE_SUCCESS;
+
+    if((name == NULL) || (name[0] == '\0') || (strlen(name) >= MAXFILENAME))
+    {
+        return ERR_INVALID_PARAMETER;
+    }
+
+    pthread_mutex_lock(&NamespaceLock);
+
+    if(FindSnapshot(name) != NULL)
+    {
+        pthread_mutex_unlock(&NamespaceLock);
+        return ERR_FILE_ALREADY_EXIST;
+    }
+
+    for(i = 0; i < MAXSNAPSHOTS; i++)
+    {
+        if(Snapshots[i].Name[0] == '\0')
+        {
+            Record = &Snapshots[i];
+            break;
+        }
+    }
+
+    if(Record == NULL)
+    {
+        pthread_mutex_unlock(&NamespaceLock);
+        return ERR_NO_SNAPSHOTS;
+    }
+
+    for(i = 0; i < superobj.TotalInodes; i++)
+    {
+        if(DILBCore[i].FileType != 0)
+        {
+            pthread_rwlock_rdlock(&InodeLocks[i].Lock);
+        }
+    }
+
+    JournalBegin();
+
+    memset(&Entry, 0, sizeof(Entry));
+
+    //  Files unlinked while open have no name and are not frozen
+    for(i = 0; i < superobj.TotalInodes; i++)
+    {
+        if((DILBCore[i].FileType == 0) || (DILB[i].FileName[0] == '\0'))
+        {
+            continue;
+        }
+
+        Entry.Core = DILBCore[i];
+        Entry.Core.ReferenceCount = 0;
+        Entry.Inode = DILB[i];
+
+        iRet = SnapshotCopy(&Record->Table, Offset, (char *)&Entry, sizeof(Entry), true);
+        if(iRet != EXECUTE_SUCCESS)
+        {
+            break;
+        }
+
+        Offset = Offset + sizeof(Entry);
+        Files++;
+    }
+
+    if(iRet == EXECUTE_SUCCESS)
+    {
+        for(i = 0; i < superobj.TotalInodes; i++)
+        {
+            if((DILBCore[i].FileType != 0) && (DILB[i].FileName[0] != '\0'))
+            {
+                HoldFileBlocks(&DILB[i]);
+            }
+        }
+
+        strcpy(Record->Name, name);
+        Record->Files = Files;
+    }
+    else
+    {
+        ReleaseFileBlocks(&Record->Table);
+    }
+
+    JournalDirty(Record, sizeof(*Record));
+
+    if(iRet == EXECUTE_SUCCESS)
+    {
+        iRet = JournalCommit();
+    }
+    else
+    {
+        JournalCommit();
+    }
+
+    for(i = 0; i < superobj.TotalInodes; i++)
+    {
+        if(DILBCore[i].FileType != 0)
+        {
+            pthread_rwlock_unlock(&InodeLocks[i].Lock);
+        }
+    }
+
+    pthread_mutex_unlock(&NamespaceLock);
+
+    return iRet;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         DeleteSnapshot
+//  Description :           Removes a snapshot. References of its entries are
+//                          dropped, so blocks which no live file uses any
+//                          more return to the pool, and so does its table.
+//  Input :                 name -> Name of snapshot
+//  Output :                EXECUTE_SUCCESS on success
+//                          ERR_FILE_NOT_EXIST if there is no such snapshot
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+int DeleteSnapshot(
+                    const char *name
+                )
+{
+    PSNAPSHOT Record = NULL;
+    SNAPSHOTENTRY Entry;
+    int i = 0;
+    int iRet = 0;
+
+    if(name == NULL)
+    {
+        return ERR_INVALID_PARAMETER;
+    }
+
+    pthread_mutex_lock(&NamespaceLock);
+
+    Record = FindSnapshot(name);
+
+    if(Record == NULL)
+    {
+        pthread_mutex_unlock(&NamespaceLock);
+        return ERR_FILE_NOT_EXIST;
+    }
+
+    JournalBegin();
+
+    //  Entry is a copy outside the image, only block records are journaled
+    for(i = 0; i < Record->Files; i++)
+    {
+        SnapshotCopy(&Record->Table, (long long)i * sizeof(Entry), (char *)&Entry, sizeof(Entry), false);
+        ReleaseFileBlocks(&Entry.Inode);
+    }
+
+    ReleaseFileBlocks(&Record->Table);
+
+    memset(Record, 0, sizeof(*Record));
+    JournalDirty(Record, sizeof(*Record));
+
+    iRet = JournalCommit();
+
+    pthread_mutex_unlock(&NamespaceLock);
+
+    return iRet;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         RollbackSnapshot
+//  Description :           Brings the file system back to the state frozen
+//                          in a snapshot. Blocks of current files are
+//                          released, inodes of the snapshot are restored and
+//                          share its blocks again, and free inode list, name
+//                          index and ordered index are rebuilt. Snapshot is
+//                          kept, so it can be rolled back again. Nothing may
+//                          be open, nor be working directory of a session.
+//  Input :                 name -> Name of snapshot
+//  Output :                EXECUTE_SUCCESS on success
+//                          ERR_FILE_NOT_EXIST if there is no such snapshot
+//                          ERR_FILE_BUSY if a file or directory is in use
+//                          ERR_NO_MEMORY if ordered index can not be built
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+int RollbackSnapshot(
+                        const char *name
+                    )
+{
+    PSNAPSHOT Record = NULL;
+    SNAPSHOTENTRY Entry;
+    struct OrderNode **Nodes = NULL;
+    PINODE temp = NULL;
+    int i = 0;
+    int iRet = 0;
+
+    if(name == NULL)
+    {
+        return ERR_INVALID_PARAMETER;
+    }
+
+    pthread_mutex_lock(&NamespaceLock);
+
+    Record = FindSnapshot(name);
+
+    if(Record == NULL)
+    {
+        pthread_mutex_unlock(&NamespaceLock);
+        return ERR_FILE_NOT_EXIST;
+    }
+
+    for(i = 0; i < superobj.TotalInodes; i++)
+    {
+        if((DILBCore[i].FileType != 0) && (DILBCore[i].ReferenceCount != 0))
+        {
+            pthread_mutex_unlock(&NamespaceLock);
+            return ERR_FILE_BUSY;
+        }
+    }
+
+    //  Nodes of ordered index are taken first, so that rollback can not fail halfway
+    Nodes = (struct OrderNode **)CvfsAlloc(((size_t)Record->Files + 1) * sizeof(struct OrderNode *));
+    if(Nodes == NULL)
+    {
+        pthread_mutex_unlock(&NamespaceLock);
+        return ERR_NO_MEMORY;
+    }
+
+    for(i = 0; i < Record->Files; i++)
+    {
+        Nodes[i] = OrderNodeCreate(&orderobj);
+        if(Nodes[i] == NULL)
+        {
+            break;
+        }
+    }
+
+    if(i < Record->Files)
+    {
+        while(i > 0)
+        {
+            i--;
+            OrderNodeFree(Nodes[i]);
+        }
+
+        CvfsFree(Nodes, ((size_t)Record->Files + 1) * sizeof(struct OrderNode *));
+        pthread_mutex_unlock(&NamespaceLock);
+        return ERR_NO_MEMORY;
+    }
+
+    JournalBegin();
+
+    //  Current files are dropped, blocks shared with snapshots stay
+    for(i = 0; i < superobj.TotalInodes; i++)
+    {
+        if(DILBCore[i].FileType == 0)
+        {
+            continue;
+        }
+
+        ReleaseFileBlocks(&DILB[i]);
+        memset(DILB[i].FileName, '\0', sizeof(DILB[i].FileName));
+        DILB[i].Parent = ROOTDIRECTORY;
+        DILB[i].Permission = 0;
+        memset(&DILBCore[i], 0, sizeof(INODECORE));
+
+        JournalDirty(&DILB[i], sizeof(INODE));
+        JournalDirty(&DILBCore[i], sizeof(INODECORE));
+    }
+
+    memset(indexobj.Slots, 0, ((size_t)indexobj.Mask + 1) * sizeof(struct NameIndexEntry));
+    JournalDirty(indexobj.Slots, ((long long)indexobj.Mask + 1) * sizeof(struct NameIndexEntry));
+    indexobj.Count = 0;
+
+    OrderIndexDestroy(&orderobj);
+
+    for(i = 0; i < Record->Files; i++)
+    {
+        SnapshotCopy(&Record->Table, (long long)i * sizeof(Entry), (char *)&Entry, sizeof(Entry), false);
+
+        temp = &DILB[Entry.Inode.InodeNumber - 1];
+        *temp = Entry.Inode;
+        *CoreOf(temp) = Entry.Core;
+        HoldFileBlocks(temp);
+
+        NameIndexInsert(&indexobj, temp);
+        OrderIndexInsert(&orderobj, Nodes[i], temp);
+
+        JournalDirty(temp, sizeof(INODE));
+        JournalDirty(CoreOf(temp), sizeof(INODECORE));
+    }
+
+    //  Push in reverse order, like CreateDILB
+    superobj.FreeInodes = 0;
+    for(i = superobj.TotalInodes - 1; i >= 0; i--)
+    {
+        if(DILBCore[i].FileType == 0)
+        {
+            ReleaseInode(&DILB[i]);
+        }
+    }
+
+    iRet = JournalCommit();
+
+    pthread_mutex_unlock(&NamespaceLock);
+
+    CvfsFree(Nodes, ((size_t)Record->Files + 1) * sizeof(struct OrderNode *));
+
+    return iRet;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         ListSnapshots
+//  Description :           Copies information of snapshots, in order of
+//                          their records.
+//  Input :                 entries -> Destination of count entries
+//                          count   -> Entries available
+//  Output :                Number of entries filled
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+int ListSnapshots(
+                    PSNAPSHOTINFO entries,
+                    int count
+                )
+{
+    int Filled = 0;
+    int i = 0;
+
+    if((entries == NULL) || (count < 0))
+    {
+        return ERR_INVALID_PARAMETER;
+    }
+
+    pthread_mutex_lock(&NamespaceLock);
+
+    for(i = 0; (i < MAXSNAPSHOTS) && (Filled < count); i++)
+    {
+        if(Snapshots[i].Name[0] == '\0')
+        {
+            continue;
+        }
+
+        strcpy(entries[Filled].Name, Snapshots[i].Name);
+        entries[Filled].Files = Snapshots[i].Files;
+        entries[Filled].Bytes = Snapshots[i].Table.FileSize;
+        Filled++;
+    }
+
+    pthread_mutex_unlock(&NamespaceLock);
+
+    return Filled;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         ReadSnapshotFile
+//  Description :           Reads a file as it was when the snapshot was
+//                          taken. Blocks of a snapshot are never written, a
+//                          live file copies them first, so no inode lock is
+//                          needed. Every path starts at root of snapshot.
+//  Input :                 snapshot -> Name of snapshot
+//                          path     -> Path of file inside snapshot
+//                          data     -> Destination buffer
+//                          size     -> Number of bytes to read
+//                          offset   -> Offset in file of first byte
+//  Output :                Number of bytes read, less than size at end of
+//                          file, 0 at or beyond end of file
+//                          ERR_FILE_NOT_EXIST if snapshot or file is missing
+//                          ERR_IS_DIRECTORY if path names a directory
+//                          Error code of path on failure
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+int ReadSnapshotFile(
+                        const char *snapshot,
+                        const char *path,
+                        char *data,
+                        int size,
+                        long long offset
+                    )
+{
+    PSNAPSHOT Record = NULL;
+    SNAPSHOTENTRY Entry;
+    char Name[MAXFILENAME];
+    const char *Next = path;
+    int Length = 0;
+    int dir = ROOTDIRECTORY;
+    int iRet = EXECUTE_SUCCESS;
+
+    if((snapshot == NULL) || (path == NULL) || (data == NULL) || (size < 0) || (offset < 0))
+    {
+        return ERR_INVALID_PARAMETER;
+    }
+
+    pthread_mutex_lock(&NamespaceLock);
+
+    Record = FindSnapshot(snapshot);
+
+    if(Record == NULL)
+    {
+        pthread_mutex_unlock(&NamespaceLock);
+        return ERR_FILE_NOT_EXIST;
+    }
+
+    //  Resolve path one component at a time, like WalkPath()
+    while(iRet == EXECUTE_SUCCESS)
+    {
+        while(*Next == PATHSEPARATOR)
+        {
+            Next++;
+        }
+
+        if(*Next == '\0')
+        {
+            break;
+        }
+
+        Length = 0;
+        while((Next[Length] != '\0') && (Next[Length] != PATHSEPARATOR))
+        {
+            Length++;
+        }
+
+        if(Length >= MAXFILENAME)
+        {
+            iRet = ERR_INVALID_PARAMETER;
+            break;
+        }
+
+        memcpy(Name, Next, Length);
+        Name[Length] = '\0';
+        Next = Next + Length;
+
+        if((dir != ROOTDIRECTORY) && (Entry.Core.FileType != DIRECTORYFILE))
+        {
+            iRet = ERR_NOT_DIRECTORY;
+        }
+        else if(strcmp(Name, ".") == 0)
+        {
+            continue;
+        }
+        else if(strcmp(Name, "..") == 0)
+        {
+            if(dir != ROOTDIRECTORY)
+            {
+                dir = Entry.Inode.Parent;
+                if(dir != ROOTDIRECTORY)
+                {
+                    SnapshotSearch(Record, dir, NULL, &Entry);
+                }
+            }
+        }
+        else if(SnapshotSearch(Record, dir, Name, &Entry) == true)
+        {
+            dir = Entry.Inode.InodeNumber;
+        }
+        else
+        {
+            iRet = ERR_FILE_NOT_EXIST;
+        }
+    }
+
+    if((iRet == EXECUTE_SUCCESS) &&
+       ((dir == ROOTDIRECTORY) || (Entry.Core.FileType == DIRECTORYFILE)))
+    {
+        iRet = ERR_IS_DIRECTORY;
+    }
+
+    if(iRet == EXECUTE_SUCCESS)
+    {
+        if(offset >= Entry.Core.ActualFileSize)
+        {
+            size = 0;
+        }
+        else if(size > (Entry.Core.ActualFileSize - offset))
+        {
+            size = (int)(Entry.Core.ActualFileSize - offset);
+        }
+
+        ReadData(&Entry.Inode, data, size, offset);
+        iRet = size;
+    }
+
+    pthread_mutex_unlock(&NamespaceLock);
+
+    return iRet;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         WriteData
+//  Description :           Copies data into data blocks of file, allocating
+//                          them on demand, and updates actual file size.
+//                          Inline file keeps data in its inode while it
+//                          fits into InlineSize, and is promoted to data
+//                          blocks by the first write beyond it.
+//                          Caller holds write lock of inode and the journal.
+//  Input :                 ptrinode -> Inode of file
+//                          data     -> Source buffer
+//                          size     -> Number of bytes to write
+//                          offset   -> Offset in file of first byte
+//  Output :                Number of bytes written, 0 for an empty write at
+//                          any offset. If pool runs out in the middle, the
+//                          bytes which were written are returned.
+//                          ERR_INSUFFICIENT_SPACE if nothing could be written
+//                          or offset is beyond the largest file size.
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+int WriteData(
+                PINODE ptrinode,
+                const char *data,
+                int size,
+                long long offset
+            )
+{
+    int Written = 0;
+    int Chunk = 0;
+    int Within = 0;
+    int block = 0;
+    int *Slot = NULL;
+    int head = 0;
+    long long First = 0;
+    long long Offset = 0;
+    long long InlineSize = 0;
+
+    //  Empty write neither extends the file nor promotes inline data
+    if(size == 0)
+    {
+        return 0;
+    }
+
+    //  Nothing of the file is changed by a write past the triple indirect tree
+    if(offset >= MaxFileSize())
+    {
+        return ERR_INSUFFICIENT_SPACE;
+    }
+
+    if((ptrinode->Flags & INODE_INLINE) != 0)
+    {
+        InlineSize = __atomic_load_n(&superobj.InlineSize, __ATOMIC_RELAXED);
+
+        //  Bound is checked without offset + size, which may overflow
+        if((offset <= InlineSize) && (size <= (InlineSize - offset)))
+        {
+            memcpy((char *)ptrinode->Block + offset, data, size);
+            JournalDirty((char *)ptrinode->Block + offset, size);
+            Written = size;
+        }
+        else if(PromoteInlineData(ptrinode) != EXECUTE_SUCCESS)
+        {
+            return ERR_INSUFFICIENT_SPACE;
+        }
+    }
+
+    //  Write the data block by block, allocating blocks on demand
+    while(Written < size)
+    {
+        Offset = offset + Written;
+        Within = Offset & (superobj.BlockSize - 1);
+
+        Chunk = superobj.BlockSize - Within;
+        if(Chunk > (size - Written))
+        {
+            Chunk = size - Written;
+        }
+
+        //  Compressed cluster is written raw until its end is written again
+        if((ptrinode->Flags & INODE_COMPRESS) != 0)
+        {
+            head = ClusterHead(ptrinode, Offset >> BlockShift, &First);
+
+            if((head > 0) && (ExpandCluster(ptrinode, First, head) != EXECUTE_SUCCESS))
+            {
+                break;
+            }
+        }
+
+        block = MapBlock(ptrinode, Offset >> BlockShift, true, &Slot);
+
+        //  Insufficient space
+        if(block <= 0)
+        {
+            break;
+        }
+
+        memcpy(BlockData(block) + Within, data + Written, Chunk);
+        JournalData(BlockData(block) + Within, Chunk);
+        Written = Written + Chunk;
+
+        if((Within + Chunk) != superobj.BlockSize)
+        {
+            continue;
+        }
+
+        //  Only whole blocks are shared or compressed, once their end is written
+        if((ptrinode->Flags & INODE_COMPRESS) != 0)
+        {
+            if((((Offset >> BlockShift) + 1) & (CLUSTERBLOCKS - 1)) == 0)
+            {
+                CompressCluster(ptrinode, (Offset >> BlockShift) + 1 - CLUSTERBLOCKS);
+            }
+        }
+        else if(__atomic_load_n(&superobj.Dedup, __ATOMIC_RELAXED) != 0)
+        {
+            DedupBlock(Slot);
+        }
+    }
+
+    //  Blocks taken before the pool ran out still belong to the file
+    if((Written == 0) && (size > 0))
+    {
+        return ERR_INSUFFICIENT_SPACE;
+    }
+
+    // Update the actual file size
+    if(offset + Written > CoreOf(ptrinode)->ActualFileSize)
+    {
+        CoreOf(ptrinode)->ActualFileSize = offset + Written;
+        JournalDirty(CoreOf(ptrinode), sizeof(INODECORE));
+    }
+
+    return Written;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         ReadData
+//  Description :           Copies data from data blocks of file to buffer.
+//                          Blocks which were never written read as zeros.
+//                          Caller holds read lock of inode and has checked
+//                          that the range lies inside the file.
+//  Input :                 ptrinode -> Inode of file
+//                          data     -> Destination buffer
+//                          size     -> Number of bytes to read
+//                          offset   -> Offset in file of first byte
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+void ReadData(
+                PINODE ptrinode,
+                char *data,
+                int size,
+                long long offset
+            )
+{
+    int Done = 0;
+    int Chunk = 0;
+    int Within = 0;
+    int block = 0;
+    int head = 0;
+    long long First = 0;
+    long long Offset = 0;
+    char *Cluster = NULL;
+
+    if((ptrinode->Flags & INODE_INLINE) != 0)
+    {
+        memcpy(data, (char *)ptrinode->Block + offset, size);
+        return;
+    }
+
+    //  Read the data block by block
+    while(Done < size)
+    {
+        Offset = offset + Done;
+        Within = Offset & (superobj.BlockSize - 1);
+
+        Chunk = superobj.BlockSize - Within;
+        if(Chunk > (size - Done))
+        {
+            Chunk = size - Done;
+        }
+
+        head = 0;
+        if((ptrinode->Flags & INODE_COMPRESS) != 0)
+        {
+            head = ClusterHead(ptrinode, Offset >> BlockShift, &First);
+        }
+
+        //  Compressed cluster is read from the decompressed cache
+        if(head > 0)
+        {
+            pthread_mutex_lock(&CacheLock);
+
+            Cluster = LookupCluster(ptrinode, First, head, false);
+            if(Cluster != NULL)
+            {
+                memcpy(data + Done, Cluster + (Offset - (First << BlockShift)), Chunk);
+            }
+            else
+            {
+                memset(data + Done, 0, Chunk);
+            }
+
+            pthread_mutex_unlock(&CacheLock);
+
+            Done = Done + Chunk;
+            continue;
+        }
+
+        block = MapBlock(ptrinode, Offset >> BlockShift, false, NULL);
+
+        if(block > 0)
+        {
+            memcpy(data + Done, BlockData(block) + Within, Chunk);
+        }
+        else
+        {
+            memset(data + Done, 0, Chunk);
+        }
+
+        Done = Done + Chunk;
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         WriteFile()
+//  Description :           This function writes given data into the file
+//                          associated with the provided file descriptor.
+//  Checks :                Valid FD, write permission and available space.
+//  Effect :                Copies data into data blocks of file, allocating
+//                          them on demand, and updates write offset as well
+//                          as actual file size. Writers of the same file are
+//                          serialized by write lock of its inode.
+//  Input :                 fd   -> File descriptor
+//                          data -> Source buffer(Address of buffer which contains data)
+//                          size -> Size of data that we want to write
+//  Output :                Number of bytes successfully written or error code.
+//                          If pool runs out in the middle, the bytes which
+//                          were written are returned.
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  22/01/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+int WriteFile(
+                    int fd,
+                    const char *data,
+                    int size
+            )
+{
+    PERF_SCOPE(PERF_WRITE);
+    PFILETABLE ptrfile = FileTableOf(fd);
+    int iRet = 0;
+    int Status = 0;             // Result of commit
+
+    //  Invalid FD
+    if(fd < 0)
+    {
+        return ERR_INVALID_PARAMETER;
+    }
+
+    if((data == NULL) || (size < 0))
+    {
+        return ERR_INVALID_PARAMETER;
+    }
+
+    //  FD points to NULL
+    if(ptrfile == NULL)
+    {
+        return ERR_FILE_NOT_EXIST;
+    }
+
+    //  Descriptor is not opened for write
+    if((ptrfile->Mode & WRITE) == 0)
+    {
+        return ERR_PERMISSION_DENIED;
+    }
+
+    pthread_rwlock_wrlock(LockOf(ptrfile->ptrinode));
+    JournalBegin();
+
+    iRet = WriteData(ptrfile->ptrinode, data, size, ptrfile->WriteOffset);
+
+    //  Update the write offset
+    if(iRet > 0)
+    {
+        ptrfile->WriteOffset = ptrfile->WriteOffset + iRet;
+    }
+
+    Status = JournalCommit();
+    pthread_rwlock_unlock(LockOf(ptrfile->ptrinode));
+
+    return (Status != EXECUTE_SUCCESS) ? Status : iRet;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         WriteFileAt()
+//  Description :           Writes data at given offset of the file, like
+//                          pwrite(). Write offset of descriptor is not used
+//                          or changed, so threads may share a descriptor.
+//  Input :                 fd     -> File descriptor
+//                          data   -> Source buffer
+//                          size   -> Number of bytes to write
+//                          offset -> Offset in file of first byte
+//  Output :                Number of bytes successfully written or error code
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+int WriteFileAt(
+                    int fd,
+                    const char *data,
+                    int size,
+                    long long offset
+                )
+{
+    PERF_SCOPE(PERF_WRITE);
+    PFILETABLE ptrfile = FileTableOf(fd);
+    int iRet = 0;
+    int Status = 0;             // Result of commit
+
+    if((fd < 0) || (data == NULL) || (size < 0) || (offset < 0))
+    {
+        return ERR_INVALID_PARAMETER;
+    }
+
+    if(ptrfile == NULL)
+    {
+        return ERR_FILE_NOT_EXIST;
+    }
+
+    if((ptrfile->Mode & WRITE) == 0)
+    {
+        return ERR_PERMISSION_DENIED;
+    }
+
+    pthread_rwlock_wrlock(LockOf(ptrfile->ptrinode));
+    JournalBegin();
+
+    iRet = WriteData(ptrfile->ptrinode, data, size, offset);
+
+    Status = JournalCommit();
+    pthread_rwlock_unlock(LockOf(ptrfile->ptrinode));
+
+    return (Status != EXECUTE_SUCCESS) ? Status : iRet;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         ReadableBytes
+//  Description :           Clamps a read to the end of the file, like a
+//                          short read of read(). Read at or after the end
+//                          of file gets no bytes.
+//                          Caller holds read (or write) lock of inode.
+//  Input :                 ptrinode -> Inode of file
+//                          offset   -> Offset in file of first byte
+//                          size     -> Number of bytes wanted
+//  Output :                Number of bytes which can be read
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+int ReadableBytes(
+                    PINODE ptrinode,
+                    long long offset,
+                    int size
+                )
+{
+    long long Left = CoreOf(ptrinode)->ActualFileSize - offset;
+
+    if(Left <= 0)
+    {
+        return 0;
+    }
+
+    if(Left < size)
+    {
+        return (int)Left;
+    }
+
+    return size;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         ReserveReadOffset
+//  Description :           Advances read offset of a descriptor by size and
+//                          returns where the read starts. Offset is moved
+//                          with compare and swap, so readers sharing the
+//                          descriptor get separate ranges. Size is cut at
+//                          the end of file, so the last reader gets a short
+//                          range and readers after it get none.
+//                          Caller holds read (or write) lock of inode.
+//  Input :                 ptrfile -> File table of descriptor
+//                          size    -> Number of bytes wanted, receives the
+//                                     number of bytes reserved
+//  Output :                Offset of first byte
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+long long ReserveReadOffset(
+                            PFILETABLE ptrfile,
+                            int *size
+                        )
+{
+    long long Offset = __atomic_load_n(&ptrfile->ReadOffset, __ATOMIC_RELAXED);
+    int Wanted = *size;
+
+    do
+    {
+        *size = ReadableBytes(ptrfile->ptrinode, Offset, Wanted);
+    }
+    while(__atomic_compare_exchange_n(&ptrfile->ReadOffset, &Offset, Offset + *size, false, __ATOMIC_RELAXED, __ATOMIC_RELAXED) == false);
+
+    return Offset;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         ReadFile()
+//  Description :           This function reads data from the file associated
+//                          with the given file descriptor into user buffer.
+//  Checks :                Valid FD and read permission.
+//  Effect :                Copies data from data blocks of file to user
+//                          buffer and updates read offset. Blocks which
+//                          were never written (holes) read as zeros. Readers
+//                          hold read lock of inode, so they run in parallel;
+//                          read offset is advanced with compare and swap.
+//  Input :                 fd   -> File descriptor
+//                          data -> Destination buffer (Address of empty Buffer)
+//                          size -> Number of bytes to read
+//  Output :                Number of bytes successfully read or error code.
+//                          Read is cut at the end of file, 0 at end of file.
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  22/01/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+int ReadFile(
+                int fd,
+                char *data,
+                int size
+            )
+{
+    PERF_SCOPE(PERF_READ);
+    PFILETABLE ptrfile = FileTableOf(fd);
+    long long Offset = 0;
+
+    //  Invalid FD
+    if(fd < 0)
+    {
+        return ERR_INVALID_PARAMETER;
+    }
+      
+    if(data == NULL)
+    {
+        return ERR_INVALID_PARAMETER;
+    }
+
+    if(size <= 0)
+    {
+        return ERR_INVALID_PARAMETER;
+    }
+
+    //  File not found
+    if(ptrfile == NULL)
+    {
+        return ERR_FILE_NOT_EXIST;
+    }
+
+    //  Descriptor is not opened for read
+    if((ptrfile->Mode & READ) == 0)
+    {
+        return ERR_PERMISSION_DENIED;
+    }
+
+    pthread_rwlock_rdlock(LockOf(ptrfile->ptrinode));
+
+    //  Reserve the range, other readers of this descriptor take the next one
+    Offset = ReserveReadOffset(ptrfile, &size);
+
+    ReadData(ptrfile->ptrinode, data, size, Offset);
+
+    pthread_rwlock_unlock(LockOf(ptrfile->ptrinode));
+
+    return size;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         ReadFileAt()
+//  Description :           Reads data from given offset of the file, like
+//                          pread(). Read offset of descriptor is not used or
+//                          changed, so readers sharing a descriptor do not
+//                          touch any common memory except the inode lock.
+//  Input :                 fd     -> File descriptor
+//                          data   -> Destination buffer
+//                          size   -> Number of bytes to read
+//                          offset -> Offset in file of first byte
+//  Output :                Number of bytes successfully read or error code.
+//                          Read is cut at the end of file, 0 at end of file.
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+int ReadFileAt(
+                int fd,
+                char *data,
+                int size,
+                long long offset
+            )
+{
+    PERF_SCOPE(PERF_READ);
+    PFILETABLE ptrfile = FileTableOf(fd);
+
+    if((fd < 0) || (data == NULL) || (size <= 0) || (offset < 0))
+    {
+        return ERR_INVALID_PARAMETER;
+    }
+
+    if(ptrfile == NULL)
+    {
+        return ERR_FILE_NOT_EXIST;
+    }
+
+    if((ptrfile->Mode & READ) == 0)
+    {
+        return ERR_PERMISSION_DENIED;
+    }
+
+    pthread_rwlock_rdlock(LockOf(ptrfile->ptrinode));
+
+    size = ReadableBytes(ptrfile->ptrinode, offset, size);
+
+    ReadData(ptrfile->ptrinode, data, size, offset);
+
+    pthread_rwlock_unlock(LockOf(ptrfile->ptrinode));
+
+    return size;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         SeekFile()
+//  Description :           Moves offset of the descriptor, like lseek().
+//                          Offset may go beyond the end of file; a write
+//                          there leaves a hole which takes no data blocks
+//                          and reads as zeros. Read and write offsets of a
+//                          descriptor opened for both are moved together.
+//                          Write lock of inode keeps readers and writers of
+//                          the descriptor out while offset is moved.
+//  Input :                 fd     -> File descriptor
+//                          offset -> Bytes to move, may be negative
+//                          whence -> START, CURRENT or END
+//  Output :                New offset from start of file or error code,
+//                          ERR_INVALID_PARAMETER if it would be negative,
+//                          ERR_FILE_TOO_LARGE if it is beyond the largest
+//                          file size for block size of the image
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+long long SeekFile(
+                    int fd,
+                    long long offset,
+                    int whence
+                )
+{
+    PFILETABLE ptrfile = FileTableOf(fd);
+    long long Base = 0;
+    long long Offset = 0;
+
+    if((fd < 0) || (whence < START) || (whence > END))
+    {
+        return ERR_INVALID_PARAMETER;
+    }
+
+    if(ptrfile == NULL)
+    {
+        return ERR_FILE_NOT_EXIST;
+    }
+
+    pthread_rwlock_wrlock(LockOf(ptrfile->ptrinode));
+
+    if(whence == CURRENT)
+    {
+        //  Descriptor opened only for write has no read offset
+        Base = ((ptrfile->Mode & READ) != 0) ? ptrfile->ReadOffset : ptrfile->WriteOffset;
+    }
+    else if(whence == END)
+    {
+        Base = CoreOf(ptrfile->ptrinode)->ActualFileSize;
+    }
+
+    if(__builtin_add_overflow(Base, offset, &Offset) || (Offset < 0))
+    {
+        pthread_rwlock_unlock(LockOf(ptrfile->ptrinode));
+        return ERR_INVALID_PARAMETER;
+    }
+
+    //  No write could succeed there, so the seek fails instead
+    if(Offset > MaxFileSize())
+    {
+        pthread_rwlock_unlock(LockOf(ptrfile->ptrinode));
+        return ERR_FILE_TOO_LARGE;
+    }
+
+    if((ptrfile->Mode & READ) != 0)
+    {
+        __atomic_store_n(&ptrfile->ReadOffset, Offset, __ATOMIC_RELAXED);
+    }
+
+    if((ptrfile->Mode & WRITE) != 0)
+    {
+        ptrfile->WriteOffset = Offset;
+    }
+
+    pthread_rwlock_unlock(LockOf(ptrfile->ptrinode));
+
+    return Offset;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         BorrowFileAt()
+//  Description :           Lends bytes of the file from given offset without
+//                          copying them, like a read that returns a view.
+//                          View ends at the end of the block which holds the
+//                          offset, so fewer bytes than asked may be lent.
+//                          Blocks which were never written are lent from a
+//                          shared zero buffer of ZEROVIEWSIZE bytes, inline
+//                          data straight from the inode and compressed data
+//                          from the decompressed cache.
+//                          Read lock of inode is kept until ReturnFileView(),
+//                          so calling thread must not write the file (or
+//                          mount another image) while it holds the view.
+//  Input :                 fd     -> File descriptor
+//                          offset -> Offset in file of first byte
+//                          size   -> Number of bytes wanted
+//                          view   -> Receives the lent bytes
+//  Output :                Number of bytes lent or error code,
+//                          ERR_NO_MEMORY if every cache entry is lent
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+int BorrowFileAt(
+                    int fd,
+                    long long offset,
+                    int size,
+                    PFILEVIEW view
+                )
+{
+    PFILETABLE ptrfile = FileTableOf(fd);
+    int Within = 0;
+    int block = 0;
+    int head = 0;
+    long long First = 0;
+    char *Cluster = NULL;
+
+    if((fd < 0) || (view == NULL) || (size <= 0) || (offset < 0))
+    {
+        return ERR_INVALID_PARAMETER;
+    }
+
+    view->Data = NULL;
+    view->Size = 0;
+    view->Lock = NULL;
+
+    if(ptrfile == NULL)
+    {
+        return ERR_FILE_NOT_EXIST;
+    }
+
+    if((ptrfile->Mode & READ) == 0)
+    {
+        return ERR_PERMISSION_DENIED;
+    }
+
+    pthread_rwlock_rdlock(LockOf(ptrfile->ptrinode));
+
+    size = ReadableBytes(ptrfile->ptrinode, offset, size);
+
+    //  Nothing to lend at end of file
+    if(size == 0)
+    {
+        pthread_rwlock_unlock(LockOf(ptrfile->ptrinode));
+        return 0;
+    }
+
+    Within = offset & (superobj.BlockSize - 1);
+
+    if(size > (superobj.BlockSize - Within))
+    {
+        size = superobj.BlockSize - Within;
+    }
+
+    //  Inline data is lent from the inode itself, Block[] holds no block numbers
+    if((ptrfile->ptrinode->Flags & INODE_INLINE) == 0)
+    {
+        if((ptrfile->ptrinode->Flags & INODE_COMPRESS) != 0)
+        {
+            head = ClusterHead(ptrfile->ptrinode, offset >> BlockShift, &First);
+        }
+
+        block = MapBlock(ptrfile->ptrinode, offset >> BlockShift, false, NULL);
+    }
+
+    if((ptrfile->ptrinode->Flags & INODE_INLINE) != 0)
+    {
+        view->Data = (char *)ptrfile->ptrinode->Block + offset;
+    }
+    else if(head > 0)
+    {
+        //  Decompressed cluster is pinned in the cache until view is returned
+        pthread_mutex_lock(&CacheLock);
+        Cluster = LookupCluster(ptrfile->ptrinode, First, head, true);
+        pthread_mutex_unlock(&CacheLock);
+
+        if(Cluster == NULL)
+        {
+            pthread_rwlock_unlock(LockOf(ptrfile->ptrinode));
+            return ERR_NO_MEMORY;
+        }
+
+        view->Data = Cluster + (offset - (First << BlockShift));
+    }
+    else if(block > 0)
+    {
+        view->Data = BlockData(block) + Within;
+    }
+    else
+    {
+        view->Data = ZeroData;
+
+        if(size > ZEROVIEWSIZE)
+        {
+            size = ZEROVIEWSIZE;
+        }
+    }
+
+    view->Size = size;
+    view->Lock = LockOf(ptrfile->ptrinode);
+
+    return size;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         ReturnFileView()
+//  Description :           Ends a view given by BorrowFileAt() and releases
+//                          the read lock of its file. Empty view is ignored.
+//  Input :                 view -> View to be returned
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+void ReturnFileView(
+                        PFILEVIEW view
+                    )
+{
+    long long Entry = 0;
+
+    if((view == NULL) || (view->Lock == NULL))
+    {
+        return;
+    }
+
+    //  View of a compressed cluster pins its cache entry
+    pthread_mutex_lock(&CacheLock);
+
+    if((cacheobj.Memory != NULL) && (view->Data >= cacheobj.Memory) && (view->Data < cacheobj.Spare))
+    {
+        Entry = (view->Data - cacheobj.Memory) / cacheobj.ClusterSize;
+        cacheobj.Entries[Entry].Pins--;
+    }
+
+    pthread_mutex_unlock(&CacheLock);
+
+    pthread_rwlock_unlock((pthread_rwlock_t *)view->Lock);
+
+    view->Data = NULL;
+    view->Size = 0;
+    view->Lock = NULL;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         ReadFileV()
+//  Description :           Reads consecutive bytes of the file into many
+//                          buffers, like readv(). Descriptor, permission and
+//                          inode are checked once and the read offset is
+//                          advanced once for the whole vector.
+//  Input :                 fd     -> File descriptor
+//                          vector -> Buffers to be filled in order
+//                          count  -> Number of buffers
+//  Output :                Number of bytes read or error code. Read is cut
+//                          at the end of file, so later buffers may be left
+//                          partly or wholly unfilled.
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+int ReadFileV(
+                int fd,
+                const struct iovec *vector,
+                int count
+            )
+{
+    PERF_SCOPE(PERF_READ);
+    PFILETABLE ptrfile = FileTableOf(fd);
+    long long Total = 0;
+    long long Offset = 0;
+    int Size = 0;
+    int Chunk = 0;
+    int Done = 0;
+    int i = 0;
+
+    if((fd < 0) || (vector == NULL) || (count <= 0))
+    {
+        return ERR_INVALID_PARAMETER;
+    }
+
+    for(i = 0; i < count; i++)
+    {
+        if((vector[i].iov_base == NULL) && (vector[i].iov_len > 0))
+        {
+            return ERR_INVALID_PARAMETER;
+        }
+
+        Total = Total + vector[i].iov_len;
+    }
+
+    //  Byte count is returned as int
+    if((Total <= 0) || (Total > INT_MAX))
+    {
+        return ERR_INVALID_PARAMETER;
+    }
+
+    if(ptrfile == NULL)
+    {
+        return ERR_FILE_NOT_EXIST;
+    }
+
+    if((ptrfile->Mode & READ) == 0)
+    {
+        return ERR_PERMISSION_DENIED;
+    }
+
+    pthread_rwlock_rdlock(LockOf(ptrfile->ptrinode));
+
+    Size = (int)Total;
+    Offset = ReserveReadOffset(ptrfile, &Size);
+
+    for(i = 0; (i < count) && (Done < Size); i++)
+    {
+        Chunk = (int)vector[i].iov_len;
+        if(Chunk > (Size - Done))
+        {
+            Chunk = Size - Done;
+        }
+
+        ReadData(ptrfile->ptrinode, (char *)vector[i].iov_base, Chunk, Offset + Done);
+        Done = Done + Chunk;
+    }
+
+    pthread_rwlock_unlock(LockOf(ptrfile->ptrinode));
+
+    return Size;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         WriteFileV()
+//  Description :           Writes many buffers as consecutive bytes of the
+//                          file, like writev(). Descriptor, permission and
+//                          inode are checked once, and the whole vector is
+//                          one transaction of the journal.
+//  Input :                 fd     -> File descriptor
+//                          vector -> Buffers to be written in order
+//                          count  -> Number of buffers
+//  Output :                Number of bytes written or error code. If pool
+//                          runs out in the middle, the bytes which were
+//                          written are returned.
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+int WriteFileV(
+                int fd,
+                const struct iovec *vector,
+                int count
+            )
+{
+    PERF_SCOPE(PERF_WRITE);
+    PFILETABLE ptrfile = FileTableOf(fd);
+    long long Total = 0;
+    int Done = 0;
+    int iRet = 0;
+    int Status = 0;             // Result of commit
+    int i = 0;
+
+    if((fd < 0) || (vector == NULL) || (count <= 0))
+    {
+        return ERR_INVALID_PARAMETER;
+    }
+
+    for(i = 0; i < count; i++)
+    {
+        if((vector[i].iov_base == NULL) && (vector[i].iov_len > 0))
+        {
+            return ERR_INVALID_PARAMETER;
+        }
+
+        Total = Total + vector[i].iov_len;
+    }
+
+    if(Total > superobj.ImageSize)
+    {
+        return ERR_INVALID_PARAMETER;
+    }
+
+    if(ptrfile == NULL)
+    {
+        return ERR_FILE_NOT_EXIST;
+    }
+
+    if((ptrfile->Mode & WRITE) == 0)
+    {
+        return ERR_PERMISSION_DENIED;
+    }
+
+    pthread_rwlock_wrlock(LockOf(ptrfile->ptrinode));
+    JournalBegin();
+
+    for(i = 0; i < count; i++)
+    {
+        if(vector[i].iov_len == 0)
+        {
+            continue;
+        }
+
+        iRet = WriteData(ptrfile->ptrinode, (const char *)vector[i].iov_base, (int)vector[i].iov_len,
+                         ptrfile->WriteOffset + Done);
+
+        if(iRet < 0)
+        {
+            break;
+        }
+
+        Done = Done + iRet;
+
+        //  Pool is exhausted
+        if(iRet < (int)vector[i].iov_len)
+        {
+            break;
+        }
+    }
+
+    ptrfile->WriteOffset = ptrfile->WriteOffset + Done;
+
+    Status = JournalCommit();
+    pthread_rwlock_unlock(LockOf(ptrfile->ptrinode));
+
+    if(Status != EXECUTE_SUCCESS)
+    {
+        return Status;
+    }
+
+    if((Done == 0) && (iRet < 0))
+    {
+        return iRet;
+    }
+
+    return Done;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         CreateIoRing
+//  Description :           Allocates submission and completion queues of a
+//                          ring. Capacity is rounded up to a power of 2.
+//  Input :                 ring    -> Ring to be initialised
+//                          entries -> Requests which may be queued at once
+//  Output :                true on success, false if memory is not available
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+bool CreateIoRing(
+                    PIORING ring,
+                    int entries
+                )
+{
+    unsigned int Capacity = 1;
+
+    if(ring == NULL)
+    {
+        return false;
+    }
+
+    memset(ring, 0, sizeof(IORING));
+
+    if((entries <= 0) || (entries > (1 << 24)))
+    {
+        return false;
+    }
+
+    while(Capacity < (unsigned int)entries)
+    {
+        Capacity = Capacity * 2;
+    }
+
+    ring->Requests = (PIOREQUEST)CvfsAlloc(Capacity * sizeof(IOREQUEST));
+    ring->Completions = (PIOCOMPLETION)CvfsAlloc(Capacity * sizeof(IOCOMPLETION));
+
+    if((ring->Requests == NULL) || (ring->Completions == NULL))
+    {
+        CvfsFree(ring->Requests, Capacity * sizeof(IOREQUEST));
+        CvfsFree(ring->Completions, Capacity * sizeof(IOCOMPLETION));
+        memset(ring, 0, sizeof(IORING));
+        return false;
+    }
+
+    ring->Capacity = Capacity;
+
+    return true;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         DestroyIoRing
+//  Description :           Releases queues of a ring. Requests which were not
+//                          submitted and completions which were not reaped
+//                          are dropped.
+//  Input :                 ring -> Ring to be released
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+void DestroyIoRing(
+                    PIORING ring
+                )
+{
+    if((ring == NULL) || (ring->Capacity == 0))
+    {
+        return;
+    }
+
+    CvfsFree(ring->Requests, ring->Capacity * sizeof(IOREQUEST));
+    CvfsFree(ring->Completions, ring->Capacity * sizeof(IOCOMPLETION));
+
+    memset(ring, 0, sizeof(IORING));
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         IoRingRequest
+//  Description :           Takes the next free entry of submission queue. It
+//                          is cleared, Offset is IO_OFFSET_NONE, and caller
+//                          fills it before SubmitIoRing().
+//  Input :                 ring -> Ring
+//  Output :                Request, NULL if submission queue is full
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+PIOREQUEST IoRingRequest(
+                            PIORING ring
+                        )
+{
+    PIOREQUEST Request = NULL;
+
+    if((ring->RequestTail - ring->RequestHead) == ring->Capacity)
+    {
+        return NULL;
+    }
+
+    Request = &ring->Requests[ring->RequestTail & (ring->Capacity - 1)];
+    ring->RequestTail++;
+
+    Request->Opcode = 0;
+    Request->fd = -1;
+    Request->Data = NULL;
+    Request->Size = 0;
+    Request->Offset = IO_OFFSET_NONE;
+    Request->UserData = 0;
+
+    return Request;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         RunIoRequest
+//  Description :           Runs one request of a ring on an already checked
+//                          file table. Caller holds lock of inode (write lock
+//                          and journal if any request of the run writes).
+//  Input :                 ptrfile -> File table of descriptor of request
+//                          Request -> Request to be run
+//  Output :                Bytes read or written, or error code
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+int RunIoRequest(
+                    PFILETABLE ptrfile,
+                    PIOREQUEST Request
+                )
+{
+    long long Offset = Request->Offset;
+    int Size = Request->Size;
+    int iRet = 0;
+
+    if((Request->Data == NULL) || (Request->Size < 0) || (Offset < IO_OFFSET_NONE))
+    {
+        return ERR_INVALID_PARAMETER;
+    }
+
+    if(Request->Opcode == IO_READ)
+    {
+        if((ptrfile->Mode & READ) == 0)
+        {
+            return ERR_PERMISSION_DENIED;
+        }
+
+        if(Request->Size == 0)
+        {
+            return ERR_INVALID_PARAMETER;
+        }
+
+        if(Offset == IO_OFFSET_NONE)
+        {
+            Offset = ReserveReadOffset(ptrfile, &Size);
+        }
+        else
+        {
+            Size = ReadableBytes(ptrfile->ptrinode, Offset, Size);
+        }
+
+        ReadData(ptrfile->ptrinode, Request->Data, Size, Offset);
+
+        return Size;
+    }
+    else if(Request->Opcode == IO_WRITE)
+    {
+        if((ptrfile->Mode & WRITE) == 0)
+        {
+            return ERR_PERMISSION_DENIED;
+        }
+
+        if(Offset == IO_OFFSET_NONE)
+        {
+            iRet = WriteData(ptrfile->ptrinode, Request->Data, Request->Size, ptrfile->WriteOffset);
+
+            if(iRet > 0)
+            {
+                ptrfile->WriteOffset = ptrfile->WriteOffset + iRet;
+            }
+
+            return iRet;
+        }
+
+        return WriteData(ptrfile->ptrinode, Request->Data, Request->Size, Offset);
+    }
+
+    return ERR_INVALID_PARAMETER;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         SubmitIoRing
+//  Description :           Runs queued requests in order and posts their
+//                          completions. Requests are taken in runs on the
+//                          same fd : descriptor, permission and inode are
+//                          looked up and locked once per run, and all writes
+//                          of a run are one transaction of the journal.
+//                          Only as many requests run as completions fit.
+//  Input :                 ring -> Ring
+//  Output :                Number of requests completed
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+int SubmitIoRing(
+                    PIORING ring
+                )
+{
+    unsigned int Mask = ring->Capacity - 1;
+    unsigned int Pending = ring->RequestTail - ring->RequestHead;
+    unsigned int Space = ring->Capacity - (ring->CompletionTail - ring->CompletionHead);
+    unsigned int Done = 0;
+    unsigned int Run = 0;
+    unsigned int i = 0;
+    PIOREQUEST First = NULL;
+    PIOREQUEST Request = NULL;
+    PIOCOMPLETION Completion = NULL;
+    PFILETABLE ptrfile = NULL;
+    bool Writes = false;
+    int Status = EXECUTE_SUCCESS;   // Result of commit of a run
+
+    if(Pending > Space)
+    {
+        Pending = Space;
+    }
+
+    while(Done < Pending)
+    {
+        First = &ring->Requests[(ring->RequestHead + Done) & Mask];
+        Writes = (First->Opcode == IO_WRITE);
+
+        //  Requests which follow on the same fd
+        for(Run = 1; (Done + Run) < Pending; Run++)
+        {
+            Request = &ring->Requests[(ring->RequestHead + Done + Run) & Mask];
+
+            if(Request->fd != First->fd)
+            {
+                break;
+            }
+
+            Writes = Writes || (Request->Opcode == IO_WRITE);
+        }
+
+        ptrfile = FileTableOf(First->fd);
+
+        if(ptrfile != NULL)
+        {
+            if(Writes == true)
+            {
+                pthread_rwlock_wrlock(LockOf(ptrfile->ptrinode));
+                JournalBegin();
+            }
+            else
+            {
+                pthread_rwlock_rdlock(LockOf(ptrfile->ptrinode));
+            }
+        }
+
+        for(i = 0; i < Run; i++)
+        {
+            Request = &ring->Requests[(ring->RequestHead + Done + i) & Mask];
+            Completion = &ring->Completions[ring->CompletionTail & Mask];
+
+            Completion->UserData = Request->UserData;
+
+            if(ptrfile == NULL)
+            {
+                Completion->Result = (Request->fd < 0) ? ERR_INVALID_PARAMETER : ERR_FILE_NOT_EXIST;
+            }
+            else
+            {
+                Completion->Result = RunIoRequest(ptrfile, Request);
+            }
+
+            ring->CompletionTail++;
+        }
+
+        if(ptrfile != NULL)
+        {
+            if(Writes == true)
+            {
+                Status = JournalCommit();
+            }
+
+            pthread_rwlock_unlock(LockOf(ptrfile->ptrinode));
+        }
+
+        //  Writes of a run which was not logged fail together
+        for(i = 0; (Status != EXECUTE_SUCCESS) && (i < Run); i++)
+        {
+            Request = &ring->Requests[(ring->RequestHead + Done + i) & Mask];
+            Completion = &ring->Completions[(ring->CompletionTail - Run + i) & Mask];
+
+            if((Request->Opcode == IO_WRITE) && (Completion->Result >= 0))
+            {
+                Completion->Result = Status;
+            }
+        }
+
+        Status = EXECUTE_SUCCESS;
+
+        Done = Done + Run;
+    }
+
+    ring->RequestHead = ring->RequestHead + Pending;
+
+    return (int)Pending;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         ReapIoRing
+//  Description :           Copies completions of a ring in the order their
+//                          requests were submitted and frees their entries.
+//  Input :                 ring        -> Ring
+//                          completions -> Destination array
+//                          count       -> Entries in destination array
+//  Output :                Number of completions copied
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+int ReapIoRing(
+                PIORING ring,
+                PIOCOMPLETION completions,
+                int count
+            )
+{
+    unsigned int Mask = ring->Capacity - 1;
+    int Done = 0;
+
+    while((Done < count) && (ring->CompletionHead != ring->CompletionTail))
+    {
+        completions[Done] = ring->Completions[ring->CompletionHead & Mask];
+        ring->CompletionHead++;
+        Done++;
+    }
+
+    return Done;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         StartExecutor
+//  Description :           Starts the worker threads which run IoTasks, and
+//                          the eventfd and epoll instance through which the
+//                          event loop learns about completed tasks.
+//  Input :                 workers -> Number of threads, 1 to MAXWORKERS
+//  Output :                true if executor is running
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+bool StartExecutor(
+                    int workers
+                )
+{
+    struct epoll_event Event;
+    int i = 0;
+
+    if((poolobj.Count != 0) || (workers < 1) || (workers > MAXWORKERS))
+    {
+        return false;
+    }
+
+    pthread_mutex_init(&poolobj.QueueLock, NULL);
+    pthread_cond_init(&poolobj.QueueReady, NULL);
+    pthread_mutex_init(&poolobj.DoneLock, NULL);
+
+    poolobj.Stopping = false;
+    poolobj.Head = NULL;
+    poolobj.Tail = NULL;
+    poolobj.Done = NULL;
+    poolobj.Ready = NULL;
+    poolobj.InFlight = 0;
+
+    poolobj.EventFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    poolobj.PollFd = epoll_create1(EPOLL_CLOEXEC);
+
+    Event.events = EPOLLIN;
+    Event.data.fd = poolobj.EventFd;
+
+    if((poolobj.EventFd < 0) || (poolobj.PollFd < 0) ||
+       (epoll_ctl(poolobj.PollFd, EPOLL_CTL_ADD, poolobj.EventFd, &Event) != 0))
+    {
+        ReleaseExecutor();
+        return false;
+    }
+
+    for(i = 0; i < workers; i++)
+    {
+        if(pthread_create(&poolobj.Workers[i], NULL, IoWorker, NULL) != 0)
+        {
+            break;
+        }
+    }
+
+    if(i == 0)
+    {
+        ReleaseExecutor();
+        return false;
+    }
+
+    poolobj.Count = i;
+
+    return true;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         ReleaseExecutor
+//  Description :           Closes the eventfd and epoll instance of executor
+//                          and destroys its locks. Worker threads must have
+//                          exited already.
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+void ReleaseExecutor()
+{
+    if(poolobj.PollFd >= 0)
+    {
+        close(poolobj.PollFd);
+    }
+
+    if(poolobj.EventFd >= 0)
+    {
+        close(poolobj.EventFd);
+    }
+
+    pthread_mutex_destroy(&poolobj.QueueLock);
+    pthread_cond_destroy(&poolobj.QueueReady);
+    pthread_mutex_destroy(&poolobj.DoneLock);
+
+    poolobj.PollFd = -1;
+    poolobj.EventFd = -1;
+    poolobj.Head = NULL;
+    poolobj.Tail = NULL;
+    poolobj.Done = NULL;
+    poolobj.Ready = NULL;
+    poolobj.InFlight = 0;
+    poolobj.Count = 0;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         StopExecutor
+//  Description :           Runs every queued task, then stops the worker
+//                          threads. Tasks which are done but not reaped are
+//                          dropped, their owner must not wait for them.
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+void StopExecutor()
+{
+    int i = 0;
+
+    if(poolobj.Count == 0)
+    {
+        return;
+    }
+
+    pthread_mutex_lock(&poolobj.QueueLock);
+    poolobj.Stopping = true;
+    pthread_cond_broadcast(&poolobj.QueueReady);
+    pthread_mutex_unlock(&poolobj.QueueLock);
+
+    for(i = 0; i < poolobj.Count; i++)
+    {
+        pthread_join(poolobj.Workers[i], NULL);
+    }
+
+    ReleaseExecutor();
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         SubmitIoTask
+//  Description :           Queues a task for the worker threads. The task
+//                          runs in the session of calling thread, and must
+//                          stay valid until ReapIoTasks() returns it. After
+//                          HoldIoTasks() it is queued by FlushIoTasks().
+//  Input :                 task -> Task with Opcode and its arguments filled
+//  Output :                EXECUTE_SUCCESS, or error code which is also
+//                          stored in Result of task
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+int SubmitIoTask(
+                    PIOTASK task
+                )
+{
+    if(task == NULL)
+    {
+        return ERR_INVALID_PARAMETER;
+    }
+
+    task->Session = CurrentUArea;
+    task->Next = NULL;
+
+    if(poolobj.Count == 0)
+    {
+        task->Result = ERR_NO_EXECUTOR;
+        return ERR_NO_EXECUTOR;
+    }
+
+    __atomic_add_fetch(&poolobj.InFlight, 1, __ATOMIC_RELAXED);
+
+    //  Collected until FlushIoTasks()
+    if(HeldTasks.Holding == true)
+    {
+        if(HeldTasks.Tail == NULL)
+        {
+            HeldTasks.Head = task;
+        }
+        else
+        {
+            HeldTasks.Tail->Next = task;
+        }
+        HeldTasks.Tail = task;
+        HeldTasks.Count++;
+
+        return EXECUTE_SUCCESS;
+    }
+
+    QueueIoTasks(task, task, 1);
+
+    return EXECUTE_SUCCESS;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         QueueIoTasks
+//  Description :           Appends a list of tasks to the queue of executor
+//                          and wakes as many workers as there are tasks.
+//  Input :                 first -> First task of list
+//                          last  -> Last task of list
+//                          count -> Tasks in list
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+void QueueIoTasks(
+                    PIOTASK first,
+                    PIOTASK last,
+                    int count
+                )
+{
+    pthread_mutex_lock(&poolobj.QueueLock);
+
+    if(poolobj.Tail == NULL)
+    {
+        poolobj.Head = first;
+    }
+    else
+    {
+        poolobj.Tail->Next = first;
+    }
+    poolobj.Tail = last;
+
+    if(count == 1)
+    {
+        pthread_cond_signal(&poolobj.QueueReady);
+    }
+    else
+    {
+        pthread_cond_broadcast(&poolobj.QueueReady);
+    }
+
+    pthread_mutex_unlock(&poolobj.QueueLock);
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         HoldIoTasks
+//  Description :           Makes SubmitIoTask() of calling thread collect
+//                          tasks instead of queueing them one by one. An
+//                          event loop holds tasks while it resumes a batch
+//                          of coroutines, so that a worker is not woken
+//                          (and does not preempt the loop) for every task.
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+void HoldIoTasks()
+{
+    HeldTasks.Holding = true;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         FlushIoTasks
+//  Description :           Queues the tasks collected since HoldIoTasks()
+//                          with one lock and ends the hold.
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+void FlushIoTasks()
+{
+    HeldTasks.Holding = false;
+
+    if(HeldTasks.Head == NULL)
+    {
+        return;
+    }
+
+    QueueIoTasks(HeldTasks.Head, HeldTasks.Tail, HeldTasks.Count);
+
+    HeldTasks.Head = NULL;
+    HeldTasks.Tail = NULL;
+    HeldTasks.Count = 0;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         RunIoTask
+//  Description :           Runs one task with the synchronous file API in the
+//                          session of its submitter and stores the result.
+//  Input :                 task -> Task taken from queue
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+void RunIoTask(
+                PIOTASK task
+            )
+{
+    SwitchSession(task->Session);
+
+    if(task->Opcode == IO_READ)
+    {
+        if(task->Offset == IO_OFFSET_NONE)
+        {
+            task->Result = ReadFile(task->fd, task->Data, task->Size);
+        }
+        else
+        {
+            task->Result = ReadFileAt(task->fd, task->Data, task->Size, task->Offset);
+        }
+    }
+    else if(task->Opcode == IO_WRITE)
+    {
+        if(task->Offset == IO_OFFSET_NONE)
+        {
+            task->Result = WriteFile(task->fd, task->Data, task->Size);
+        }
+        else
+        {
+            task->Result = WriteFileAt(task->fd, task->Data, task->Size, task->Offset);
+        }
+    }
+    else if(task->Opcode == IO_CREATE)
+    {
+        task->Result = CreateFile(task->Name, task->Permission);
+    }
+    else
+    {
+        task->Result = ERR_INVALID_PARAMETER;
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         IoWorker
+//  Description :           Thread function of executor. Takes tasks from the
+//                          queue in FIFO order, WORKERBATCH at a time, runs
+//                          them and moves them to the Done list together.
+//                          Exits when executor stops and the queue is empty.
+//  Input :                 arg -> Not used
+//  Output :                NULL
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+void * IoWorker(
+                    void *arg
+                )
+{
+    PIOTASK First = NULL;
+    PIOTASK Last = NULL;
+    PIOTASK Task = NULL;
+    PIOTASK Done = NULL;
+    bool Wake = false;
+    unsigned long long One = 1;
+    int Taken = 0;
+
+    (void)arg;
+
+    while(true)
+    {
+        pthread_mutex_lock(&poolobj.QueueLock);
+
+        while((poolobj.Head == NULL) && (poolobj.Stopping == false))
+        {
+            pthread_cond_wait(&poolobj.QueueReady, &poolobj.QueueLock);
+        }
+
+        //  Take up to WORKERBATCH tasks, one lock for all of them
+        First = poolobj.Head;
+        Last = First;
+
+        for(Taken = 1; (Last != NULL) && (Last->Next != NULL) && (Taken < WORKERBATCH); Taken++)
+        {
+            Last = Last->Next;
+        }
+
+        if(Last != NULL)
+        {
+            poolobj.Head = Last->Next;
+            Last->Next = NULL;
+
+            if(poolobj.Head == NULL)
+            {
+                poolobj.Tail = NULL;
+            }
+        }
+
+        pthread_mutex_unlock(&poolobj.QueueLock);
+
+        if(First == NULL)
+        {
+            break;
+        }
+
+        //  Run them and link them newest first, as on the Done list
+        Done = NULL;
+        while(First != NULL)
+        {
+            Task = First;
+            First = First->Next;
+
+            RunIoTask(Task);
+
+            Task->Next = Done;
+            Done = Task;
+        }
+
+        //  Oldest task of batch is its last entry
+        for(Task = Done; Task->Next != NULL; Task = Task->Next)
+        {
+        }
+
+        pthread_mutex_lock(&poolobj.DoneLock);
+        Wake = (poolobj.Done == NULL);
+        Task->Next = poolobj.Done;
+        poolobj.Done = Done;
+        pthread_mutex_unlock(&poolobj.DoneLock);
+
+        //  Loop is woken once for a burst of completions
+        if(Wake == true)
+        {
+            (void)write(poolobj.EventFd, &One, sizeof(One));
+        }
+    }
+
+    return NULL;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         TakeCompletions
+//  Description :           Moves the Done list to the Ready list of reaper,
+//                          restoring the order in which tasks completed.
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+void TakeCompletions()
+{
+    PIOTASK List = NULL;
+    PIOTASK Next = NULL;
+
+    pthread_mutex_lock(&poolobj.DoneLock);
+    List = poolobj.Done;
+    poolobj.Done = NULL;
+    pthread_mutex_unlock(&poolobj.DoneLock);
+
+    while(List != NULL)
+    {
+        Next = List->Next;
+        List->Next = poolobj.Ready;
+        poolobj.Ready = List;
+        List = Next;
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         ReapIoTasks
+//  Description :           Returns completed tasks. When none is done it waits
+//                          on the epoll instance, so an idle loop sleeps in
+//                          the kernel. Only one thread may reap at a time.
+//  Input :                 tasks   -> Destination array
+//                          count   -> Entries in destination array
+//                          timeout -> Milliseconds to wait, 0 for none,
+//                                     -1 until a task completes
+//  Output :                Number of tasks returned, or error code
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+int ReapIoTasks(
+                    PIOTASK *tasks,
+                    int count,
+                    int timeout
+                )
+{
+    struct epoll_event Event;
+    unsigned long long Counter = 0;
+    bool Waited = false;
+    int Done = 0;
+
+    if((tasks == NULL) || (count <= 0))
+    {
+        return ERR_INVALID_PARAMETER;
+    }
+
+    if(poolobj.Count == 0)
+    {
+        return ERR_NO_EXECUTOR;
+    }
+
+    while(poolobj.Ready == NULL)
+    {
+        TakeCompletions();
+
+        if((poolobj.Ready != NULL) || (timeout == 0) || ((Waited == true) && (timeout > 0)))
+        {
+            break;
+        }
+
+        //  Clear the counter, then look again so no completion is missed
+        (void)read(poolobj.EventFd, &Counter, sizeof(Counter));
+        TakeCompletions();
+
+        if(poolobj.Ready != NULL)
+        {
+            break;
+        }
+
+        if((epoll_wait(poolobj.PollFd, &Event, 1, timeout) < 0) && (errno != EINTR))
+        {
+            break;
+        }
+
+        Waited = true;
+    }
+
+    while((Done < count) && (poolobj.Ready != NULL))
+    {
+        tasks[Done] = poolobj.Ready;
+        poolobj.Ready = poolobj.Ready->Next;
+        Done++;
+    }
+
+    __atomic_sub_fetch(&poolobj.InFlight, Done, __ATOMIC_RELAXED);
+
+    return Done;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         PendingIoTasks
+//  Description :           Counts tasks which were submitted and not reaped.
+//  Output :                Number of tasks in flight
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+int PendingIoTasks()
+{
+    return __atomic_load_n(&poolobj.InFlight, __ATOMIC_RELAXED);
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         ExecutorPollFd
+//  Description :           Returns the epoll instance of executor, which is
+//                          readable when ReapIoTasks() may return tasks. An
+//                          event loop adds it to its own epoll set.
+//  Output :                File descriptor of host, -1 if executor is stopped
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+int ExecutorPollFd()
+{
+    return (poolobj.Count == 0) ? -1 : poolobj.PollFd;
+}
+
+#ifndef CVFS_NO_PERF
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         PerfKeyCreate
+//  Description :           Creates the thread key whose destructor gives the
+//                          perf block of an exiting thread back.
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+void PerfKeyCreate()
+{
+    pthread_key_create(&PerfKey, PerfDetach);
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         PerfAttach
+//  Description :           Gives calling thread a perf block : a block left
+//                          by an exited thread, a new one, or the shared
+//                          block when MAXPERFTHREADS are in use.
+//  Output :                Block of calling thread
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+struct PerfBlock * PerfAttach()
+{
+    struct PerfBlock *Block = &PerfBlocks[MAXPERFTHREADS];
+    int i = 0;
+
+    pthread_once(&PerfKeyOnce, PerfKeyCreate);
+
+    pthread_mutex_lock(&PerfLock);
+
+    for(i = 0; i < PerfBlockCount; i++)
+    {
+        if(PerfBlocks[i].Used == false)
+        {
+            break;
+        }
+    }
+
+    if(i < MAXPERFTHREADS)
+    {
+        Block = &PerfBlocks[i];
+        Block->Used = true;
+
+        if(i == PerfBlockCount)
+        {
+            PerfBlockCount++;
+        }
+    }
+
+    pthread_mutex_unlock(&PerfLock);
+
+    if(Block != &PerfBlocks[MAXPERFTHREADS])
+    {
+        pthread_setspecific(PerfKey, Block);
+    }
+
+    PerfLocal = Block;
+
+    return Block;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         PerfDetach
+//  Description :           Destructor of thread key. Block of exiting thread
+//                          keeps its counts and may be given to a new thread.
+//  Input :                 block -> Perf block of exiting thread
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+void PerfDetach(
+                void *block
+            )
+{
+    pthread_mutex_lock(&PerfLock);
+    ((struct PerfBlock *)block)->Used = false;
+    pthread_mutex_unlock(&PerfLock);
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         PerfRecord
+//  Description :           Adds one call to the counters of calling thread,
+//                          and its latency if it was timed. Counters are
+//                          written with relaxed atomic stores,
+//                          so ReadPerfCounters() may read them at any time
+//                          without a lock.
+//  Input :                 op -> PERF_ operation
+//                          ns -> Latency of call, -1 if it was not timed
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+void PerfRecord(
+                int op,
+                long long ns
+            )
+{
+    struct PerfBlock *Block = PerfLocal;
+    PPERFSTAT Stat = NULL;
+    bool Shared = false;
+    int Bucket = 0;
+
+    if(Block == NULL)
+    {
+        Block = PerfAttach();
+    }
+
+    Stat = &Block->Stats[op];
+    Shared = (Block == &PerfBlocks[MAXPERFTHREADS]);
+
+    if(Shared == true)
+    {
+        __atomic_add_fetch(&Stat->Count, 1, __ATOMIC_RELAXED);
+    }
+    else
+    {
+        __atomic_store_n(&Stat->Count, Stat->Count + 1, __ATOMIC_RELAXED);
+    }
+
+    if(ns < 0)
+    {
+        return;
+    }
+
+    if(ns > 0)
+    {
+        Bucket = 64 - __builtin_clzll((unsigned long long)ns);
+
+        if(Bucket >= PERFBUCKETS)
+        {
+            Bucket = PERFBUCKETS - 1;
+        }
+    }
+
+    if(Shared == true)
+    {
+        __atomic_add_fetch(&Stat->Timed, 1, __ATOMIC_RELAXED);
+        __atomic_add_fetch(&Stat->TotalNs, ns, __ATOMIC_RELAXED);
+        __atomic_add_fetch(&Stat->Buckets[Bucket], 1, __ATOMIC_RELAXED);
+    }
+    else
+    {
+        __atomic_store_n(&Stat->Timed, Stat->Timed + 1, __ATOMIC_RELAXED);
+        __atomic_store_n(&Stat->TotalNs, Stat->TotalNs + ns, __ATOMIC_RELAXED);
+        __atomic_store_n(&Stat->Buckets[Bucket], Stat->Buckets[Bucket] + 1, __ATOMIC_RELAXED);
+    }
+
+    if(ns > __atomic_load_n(&Stat->MaxNs, __ATOMIC_RELAXED))
+    {
+        __atomic_store_n(&Stat->MaxNs, ns, __ATOMIC_RELAXED);
+    }
+}
+
+#endif  // CVFS_NO_PERF
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         ReadPerfCounters
+//  Description :           Sums perf counters of all threads, including the
+//                          threads which have exited.
+//  Input :                 stats -> Array of NPERFOPS entries, by PERF_ number
+//  Output :                EXECUTE_SUCCESS, ERR_NOT_SUPPORTED if library was
+//                          built with CVFS_NO_PERF (stats are zero)
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+int ReadPerfCounters(
+                        PPERFSTAT stats
+                    )
+{
+    if(stats == NULL)
+    {
+        return ERR_INVALID_PARAMETER;
+    }
+
+    memset(stats, 0, NPERFOPS * sizeof(PERFSTAT));
+
+#ifndef CVFS_NO_PERF
+    PPERFSTAT Stat = NULL;
+    long long Max = 0;
+    int Blocks = 0;
+    int i = 0;
+    int op = 0;
+    int b = 0;
+
+    pthread_mutex_lock(&PerfLock);
+    Blocks = PerfBlockCount;
+    pthread_mutex_unlock(&PerfLock);
+
+    for(i = 0; i <= MAXPERFTHREADS; i++)
+    {
+        //  Blocks never given to a thread are all zero
+        if((i >= Blocks) && (i != MAXPERFTHREADS))
+        {
+            continue;
+        }
+
+        for(op = 0; op < NPERFOPS; op++)
+        {
+            Stat = &PerfBlocks[i].Stats[op];
+
+            stats[op].Count += __atomic_load_n(&Stat->Count, __ATOMIC_RELAXED);
+            stats[op].Timed += __atomic_load_n(&Stat->Timed, __ATOMIC_RELAXED);
+            stats[op].TotalNs += __atomic_load_n(&Stat->TotalNs, __ATOMIC_RELAXED);
+
+            Max = __atomic_load_n(&Stat->MaxNs, __ATOMIC_RELAXED);
+            if(Max > stats[op].MaxNs)
+            {
+                stats[op].MaxNs = Max;
+            }
+
+            for(b = 0; b < PERFBUCKETS; b++)
+            {
+                stats[op].Buckets[b] += __atomic_load_n(&Stat->Buckets[b], __ATOMIC_RELAXED);
+            }
+        }
+    }
+
+    return EXECUTE_SUCCESS;
+#else
+    return ERR_NOT_SUPPORTED;
+#endif
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         ResetPerfCounters
+//  Description :           Sets perf counters of all threads to zero. Calls
+//                          running at the same time may be kept or lost.
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+void ResetPerfCounters()
+{
+#ifndef CVFS_NO_PERF
+    PPERFSTAT Stat = NULL;
+    int i = 0;
+    int op = 0;
+    int b = 0;
+
+    for(i = 0; i <= MAXPERFTHREADS; i++)
+    {
+        for(op = 0; op < NPERFOPS; op++)
+        {
+            Stat = &PerfBlocks[i].Stats[op];
+
+            __atomic_store_n(&Stat->Count, 0, __ATOMIC_RELAXED);
+            __atomic_store_n(&Stat->Timed, 0, __ATOMIC_RELAXED);
+            __atomic_store_n(&Stat->TotalNs, 0, __ATOMIC_RELAXED);
+            __atomic_store_n(&Stat->MaxNs, 0, __ATOMIC_RELAXED);
+
+            for(b = 0; b < PERFBUCKETS; b++)
+            {
+                __atomic_store_n(&Stat->Buckets[b], 0, __ATOMIC_RELAXED);
+            }
+        }
+    }
+#endif
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         PerfPercentile
+//  Description :           Finds the latency below which given percent of
+//                          timed calls completed, to a power of 2.
+//  Input :                 stat    -> Counters of one operation
+//                          percent -> 1 to 100
+//  Output :                Upper bound of latency bucket in ns, 0 if no calls
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+long long PerfPercentile(
+                            const struct PerfStat *stat,
+                            int percent
+                        )
+{
+    long long Wanted = 0;
+    long long Seen = 0;
+    int b = 0;
+
+    if((stat == NULL) || (stat->Timed == 0))
+    {
+        return 0;
+    }
+
+    //  Rank of the call, rounded up
+    Wanted = ((stat->Timed * percent) + 99) / 100;
+
+    for(b = 0; b < PERFBUCKETS - 1; b++)
+    {
+        Seen = Seen + stat->Buckets[b];
+
+        //  Bucket bound is never reported above the longest call
+        if(Seen >= Wanted)
+        {
+            return (b == 0) ? 0 : (((1LL << b) - 1 < stat->MaxNs) ? (1LL << b) - 1 : stat->MaxNs);
+        }
+    }
+
+    return stat->MaxNs;
+}
@@ -0,0 +1,757 @@
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  libcvfs : Public interface of Omkar's CVFS
+//
+//  The file system runs inside the calling process. Functions of this
+//  header never print anything, every failure is reported with one of
+//  the ERR_ codes below. C++ programs may use the RAII classes of
+//  namespace cvfs at the end of this file instead of raw descriptors.
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+#ifndef LIBCVFS_H
+#define LIBCVFS_H
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Header File Inclusion
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+#include<stdbool.h>  // For bool, true, false
+#include<sys/uio.h>  // For struct iovec of ReadFileV and WriteFileV
+#include<span>       // For std::span of C++ API
+#include<utility>    // For std::exchange of C++ API
+#include<coroutine>  // For co_read, co_write, co_create of C++ API
+#include<exception>  // For std::terminate of coroutine Task
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  User Defined Macros
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+#define MAXINODE 5         // Default number of files (inodes), see -i option
+#define BLOCKSIZE 512      // Default size of one data block, see -b option
+#define MAXBLOCKS 1024     // Default number of data blocks, see -n option
+#define MINBLOCKSIZE 64    // Smallest block size accepted
+#define INLINEDATASIZE 60  // Default and largest data kept inside inode, see -l option
+#define MAXFILENAME 20     // Bytes of file name including '\0', as Inode::FileName
+#define PATHSEPARATOR '/'  // Separates directories of a path, leading one means root
+#define ROOTDIRECTORY 0    // Inode number used for root directory, it has no inode
+
+#define READ 1             // Permission bit for read
+#define WRITE 2            // Permission bit for write
+#define EXECUTE 4          // Permission bit for execute (not used yet)
+
+#define START 0            // Whence of SeekFile, offset from start of file
+#define CURRENT 1          // Whence of SeekFile, offset from current offset
+#define END 2              // Whence of SeekFile, offset from end of file
+
+#define EXECUTE_SUCCESS 0  // Generic success return value
+
+#define IO_READ 1          // Opcode of IoRequest, read into Data
+#define IO_WRITE 2         // Opcode of IoRequest, write from Data
+#define IO_CREATE 3        // Opcode of IoTask, create file Name
+#define IO_OFFSET_NONE -1  // Offset of IoRequest which uses descriptor offset
+
+#define MAXWORKERS 64      // Most threads of the executor of IoTasks
+
+#define PERF_CREATE 0      // Operations counted by perf counters
+#define PERF_OPEN 1
+#define PERF_LOOKUP 2
+#define PERF_READ 3
+#define PERF_WRITE 4
+#define PERF_UNLINK 5
+#define NPERFOPS 6
+#define PERFBUCKETS 32     // Latency buckets, powers of 2 of ns
+#define PERFSAMPLE 16      // One call in PERFSAMPLE is timed, power of 2
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  User Defined Macros For Error Handling
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+#define ERR_INVALID_PARAMETER -1
+
+#define ERR_NO_INODES -2
+
+#define ERR_FILE_ALREADY_EXIST -3
+#define ERR_FILE_NOT_EXIST -4
+
+#define ERR_PERMISSION_DENIED -5
+
+#define ERR_INSUFFICIENT_SPACE -6
+#define ERR_INSUFFICIENT_DATA -7
+
+#define ERR_MAX_FILES_OPEN -8
+
+#define ERR_NO_MEMORY -9
+
+#define ERR_IMAGE_IO -10
+#define ERR_IMAGE_INVALID -11
+#define ERR_NOT_MOUNTED -12
+
+#define ERR_NO_EXECUTOR -13
+
+#define ERR_NOT_SUPPORTED -14
+
+#define ERR_NOT_DIRECTORY -15
+#define ERR_IS_DIRECTORY -16
+#define ERR_DIRECTORY_NOT_EMPTY -17
+#define ERR_DIRECTORY_BUSY -18
+
+#define ERR_FILE_BUSY -19
+#define ERR_NO_SNAPSHOTS -20
+
+#define ERR_FILE_TOO_LARGE -21
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  User Defined Structures
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Structure Name :            FileView
+//  Description  :              Bytes of a file lent by BorrowFileAt() without
+//                              copying. Data points into the block of the file
+//                              and stays valid until ReturnFileView(), which
+//                              also releases the read lock held on the file.
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+struct FileView
+{
+    const char *Data;   // First byte, inside storage of file
+    int Size;           // Bytes readable at Data
+    void *Lock;         // Read lock of inode held by the view
+};
+
+typedef struct FileView FILEVIEW;
+typedef struct FileView * PFILEVIEW;
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Structure Name :            FileEntry
+//  Description  :              One file returned by ListFiles(), in order of name
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+struct FileEntry
+{
+    char Name[MAXFILENAME];     // Name of file
+    int InodeNumber;            // Inode of file
+    long long Size;             // Bytes of data in file, entries of directory
+    bool Directory;             // true for a directory
+};
+
+typedef struct FileEntry FILEENTRY;
+typedef struct FileEntry * PFILEENTRY;
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Structure Name :            ListCursor
+//  Description  :              Continuation token of ListFiles(). It holds
+//                              the name of last entry returned, so a listing
+//                              resumes at the next name even when files are
+//                              created or removed between the calls. Zero
+//                              filled cursor starts from the first name.
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+struct ListCursor
+{
+    char After[MAXFILENAME];    // Name of last entry returned, empty at start
+};
+
+typedef struct ListCursor LISTCURSOR;
+typedef struct ListCursor * PLISTCURSOR;
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Structure Name :            SnapshotInfo
+//  Description  :              One snapshot returned by ListSnapshots()
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+struct SnapshotInfo
+{
+    char Name[MAXFILENAME];     // Name of snapshot
+    int Files;                  // Files and directories frozen in it
+    long long Bytes;            // Bytes of metadata copied for it
+};
+
+typedef struct SnapshotInfo SNAPSHOTINFO;
+typedef struct SnapshotInfo * PSNAPSHOTINFO;
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Structure Name :            PerfStat
+//  Description  :              Counters of one operation, summed over all
+//                              threads by ReadPerfCounters(). Every call is
+//                              counted, one call in PERFSAMPLE of a thread is
+//                              timed. Bucket 0 counts timed calls of 0 ns,
+//                              bucket B those of 2^(B-1) to 2^B - 1 ns, the
+//                              last bucket everything longer.
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+struct PerfStat
+{
+    long long Count;                    // Calls
+    long long Timed;                    // Calls whose latency was measured
+    long long TotalNs;                  // Sum of measured latencies
+    long long MaxNs;                    // Longest measured call
+    long long Buckets[PERFBUCKETS];     // Timed calls by log2 of latency
+};
+
+typedef struct PerfStat PERFSTAT;
+typedef struct PerfStat * PPERFSTAT;
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Structure Name :            IoRing
+//  Description  :              Submission and completion queues of batched
+//                              I/O. Requests are filled in the submission
+//                              queue and run together by SubmitIoRing(), which
+//                              validates descriptor, permission and inode once
+//                              for every run of requests on the same fd. Each
+//                              request gives one completion with its UserData.
+//                              A ring is used by one thread at a time.
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+struct IoRequest
+{
+    int Opcode;                 // IO_READ or IO_WRITE
+    int fd;                     // Descriptor of session of submitting thread
+    char *Data;                 // Buffer of Size bytes
+    int Size;                   // Bytes to read or write
+    long long Offset;           // Offset in file, IO_OFFSET_NONE to use descriptor offset
+    unsigned long long UserData;// Copied to completion
+};
+
+struct IoCompletion
+{
+    unsigned long long UserData;// UserData of request
+    int Result;                 // Bytes read or written, or error code
+};
+
+struct IoRing
+{
+    struct IoRequest *Requests;         // Submission queue, Capacity entries
+    struct IoCompletion *Completions;   // Completion queue, Capacity entries
+    unsigned int Capacity;              // Power of 2
+    unsigned int RequestHead;           // Next request to run
+    unsigned int RequestTail;           // Next free request
+    unsigned int CompletionHead;        // Next completion to reap
+    unsigned int CompletionTail;        // Next free completion
+};
+
+typedef struct IoRequest IOREQUEST;
+typedef struct IoRequest * PIOREQUEST;
+typedef struct IoCompletion IOCOMPLETION;
+typedef struct IoCompletion * PIOCOMPLETION;
+typedef struct IoRing IORING;
+typedef struct IoRing * PIORING;
+
+typedef struct UAREA * PUAREA;  // Session, contents are private to library
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Structure Name :            IoTask
+//  Description  :              One operation run by the executor. Worker
+//                              threads run it with the synchronous API in the
+//                              session of the submitting thread, and it is
+//                              returned by ReapIoTasks() when done. Tasks in
+//                              flight run in parallel and in any order.
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+struct IoTask
+{
+    int Opcode;                 // IO_READ, IO_WRITE or IO_CREATE
+    int fd;                     // Descriptor of IO_READ and IO_WRITE
+    char *Data;                 // Buffer of Size bytes
+    int Size;                   // Bytes to read or write
+    long long Offset;           // Offset in file, IO_OFFSET_NONE to use descriptor offset
+    const char *Name;           // Name of file of IO_CREATE
+    int Permission;             // Permission of IO_CREATE
+    int Result;                 // Bytes, new descriptor or error code
+    void *Context;              // Owner's cookie, coroutine to resume in C++
+    PUAREA Session;             // Set by SubmitIoTask()
+    struct IoTask *Next;        // Link of executor queues
+};
+
+typedef struct IoTask IOTASK;
+typedef struct IoTask * PIOTASK;
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Library Functions
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+//  File system
+bool StartAuxillaryDataInitialisation(int count, int blocksize, int blockcount, bool hugepages);
+void ReleaseAuxillaryData();
+int MountImage(const char *path);
+int SyncImage();
+int UnmountImage();
+int SetInlineSize(int bytes);
+int SetDeduplication(bool enable);
+int SetCompression(bool enable);
+
+//  Files
+bool IsFileExist(const char *name);
+int ListFiles(const char *prefix, PFILEENTRY entries, int count, PLISTCURSOR cursor);
+int CreateFile(const char *name, int permission);
+int OpenFile(const char *name, int mode);
+int CloseFile(int fd);
+int DupFile(int fd);
+int UnlinkFile(const char *name);
+int CloneFile(const char *source, const char *name);
+
+//  Directories, paths are relative to working directory of session
+int MakeDirectory(const char *path);
+int RemoveDirectory(const char *path);
+int ChangeDirectory(const char *path);
+int GetWorkingDirectory(char *buffer, int size);
+int WriteFile(int fd, const char *data, int size);
+int WriteFileAt(int fd, const char *data, int size, long long offset);
+int ReadFile(int fd, char *data, int size);
+int ReadFileAt(int fd, char *data, int size, long long offset);
+long long SeekFile(int fd, long long offset, int whence);
+int BorrowFileAt(int fd, long long offset, int size, PFILEVIEW view);
+void ReturnFileView(PFILEVIEW view);
+
+//  Snapshots, data blocks are shared with live files until either side changes
+int CreateSnapshot(const char *name);
+int DeleteSnapshot(const char *name);
+int RollbackSnapshot(const char *name);
+int ListSnapshots(PSNAPSHOTINFO entries, int count);
+int ReadSnapshotFile(const char *snapshot, const char *path, char *data, int size, long long offset);
+
+//  Vectored and batched I/O
+int ReadFileV(int fd, const struct iovec *vector, int count);
+int WriteFileV(int fd, const struct iovec *vector, int count);
+bool CreateIoRing(PIORING ring, int entries);
+void DestroyIoRing(PIORING ring);
+PIOREQUEST IoRingRequest(PIORING ring);
+int SubmitIoRing(PIORING ring);
+int ReapIoRing(PIORING ring, PIOCOMPLETION completions, int count);
+
+//  Asynchronous I/O
+bool StartExecutor(int workers);
+void StopExecutor();
+int SubmitIoTask(PIOTASK task);
+void HoldIoTasks();
+void FlushIoTasks();
+int ReapIoTasks(PIOTASK *tasks, int count, int timeout);
+int PendingIoTasks();
+int ExecutorPollFd();
+
+//  Performance counters
+int ReadPerfCounters(PPERFSTAT stats);
+void ResetPerfCounters();
+long long PerfPercentile(const struct PerfStat *stat, int percent);
+
+//  Sessions
+PUAREA CreateSession(const char *name);
+PUAREA SessionOf(int id);
+void SwitchSession(PUAREA uarea);
+int DestroySession(PUAREA uarea);
+PUAREA ForkSession(PUAREA parent);
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  C++ Interface
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+namespace cvfs
+{
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Class Name :                FileSystem
+//  Description  :              Owns the file system of the process. It is
+//                              created empty and released with the object.
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+class FileSystem
+{
+public:
+    FileSystem(int count = MAXINODE, int blocksize = BLOCKSIZE, int blockcount = MAXBLOCKS, bool hugepages = false)
+        : Ready(StartAuxillaryDataInitialisation(count, blocksize, blockcount, hugepages))
+    {
+    }
+
+    ~FileSystem()
+    {
+        if(Ready == true)
+        {
+            ReleaseAuxillaryData();
+        }
+    }
+
+    FileSystem(const FileSystem &) = delete;
+    FileSystem & operator=(const FileSystem &) = delete;
+
+    bool IsReady() const { return Ready; }
+    int Mount(const char *path) { return MountImage(path); }
+    int Sync() { return SyncImage(); }
+
+private:
+    bool Ready;
+};
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Class Name :                View
+//  Description  :              RAII form of FileView. Bytes are readable
+//                              while the object lives, the file can not be
+//                              written (by any thread) until it is destroyed.
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+class View
+{
+public:
+    View() : Lent{nullptr, 0, nullptr}, Error(ERR_FILE_NOT_EXIST) {}
+
+    View(int fd, long long offset, int size) : Lent{nullptr, 0, nullptr}
+    {
+        Error = BorrowFileAt(fd, offset, size, &Lent);
+    }
+
+    View(View &&other) : Lent(std::exchange(other.Lent, FILEVIEW{nullptr, 0, nullptr})), Error(other.Error) {}
+
+    View & operator=(View &&other)
+    {
+        if(this != &other)
+        {
+            ReturnFileView(&Lent);
+            Lent = std::exchange(other.Lent, FILEVIEW{nullptr, 0, nullptr});
+            Error = other.Error;
+        }
+        return *this;
+    }
+
+    ~View() { ReturnFileView(&Lent); }
+
+    View(const View &) = delete;
+    View & operator=(const View &) = delete;
+
+    //  Error code of BorrowFileAt(), EXECUTE_SUCCESS if bytes are lent
+    int Status() const { return (Error < 0) ? Error : EXECUTE_SUCCESS; }
+    std::span<const char> Bytes() const { return std::span<const char>(Lent.Data, (Lent.Data == nullptr) ? 0 : Lent.Size); }
+
+private:
+    FILEVIEW Lent;
+    int Error;
+};
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Class Name :                File
+//  Description  :              Owns one descriptor of the session of calling
+//                              thread and closes it when destroyed. Failed
+//                              Create() or Open() gives a File which holds
+//                              the error code instead of a descriptor.
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+class File
+{
+public:
+    File() : Fd(ERR_FILE_NOT_EXIST) {}
+    explicit File(int fd) : Fd(fd) {}
+
+    static File Create(const char *name, int permission) { return File(CreateFile(name, permission)); }
+    static File Open(const char *name, int mode) { return File(OpenFile(name, mode)); }
+
+    File(File &&other) : Fd(std::exchange(other.Fd, ERR_FILE_NOT_EXIST)) {}
+
+    File & operator=(File &&other)
+    {
+        if(this != &other)
+        {
+            Close();
+            Fd = std::exchange(other.Fd, ERR_FILE_NOT_EXIST);
+        }
+        return *this;
+    }
+
+    ~File() { Close(); }
+
+    File(const File &) = delete;
+    File & operator=(const File &) = delete;
+
+    bool IsOpen() const { return Fd >= 0; }
+    int Descriptor() const { return Fd; }
+
+    //  Error code of Create() or Open(), EXECUTE_SUCCESS if file is open
+    int Status() const { return (Fd < 0) ? Fd : EXECUTE_SUCCESS; }
+
+    int Read(std::span<char> buffer) { return ReadFile(Fd, buffer.data(), (int)buffer.size()); }
+    int ReadAt(std::span<char> buffer, long long offset) const { return ReadFileAt(Fd, buffer.data(), (int)buffer.size(), offset); }
+    int Write(std::span<const char> data) { return WriteFile(Fd, data.data(), (int)data.size()); }
+    int WriteAt(std::span<const char> data, long long offset) { return WriteFileAt(Fd, data.data(), (int)data.size(), offset); }
+    int ReadV(std::span<const struct iovec> vector) { return ReadFileV(Fd, vector.data(), (int)vector.size()); }
+    int WriteV(std::span<const struct iovec> vector) { return WriteFileV(Fd, vector.data(), (int)vector.size()); }
+
+    //  Bytes from offset up to end of their block, without copying
+    View Borrow(long long offset, int size) const { return View(Fd, offset, size); }
+
+    //  New offset of descriptor or error code, whence is START, CURRENT or END
+    long long Seek(long long offset, int whence) { return SeekFile(Fd, offset, whence); }
+
+    File Dup() const { return File(DupFile(Fd)); }
+
+    int Close()
+    {
+        if(Fd < 0)
+        {
+            return EXECUTE_SUCCESS;
+        }
+        return CloseFile(std::exchange(Fd, ERR_FILE_NOT_EXIST));
+    }
+
+    //  Gives up ownership, descriptor is not closed by destructor
+    int Release() { return std::exchange(Fd, ERR_FILE_NOT_EXIST); }
+
+private:
+    int Fd;
+};
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Class Name :                Ring
+//  Description  :              Owns an IoRing and destroys it with the object.
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+class Ring
+{
+public:
+    explicit Ring(int entries) : Ready(CreateIoRing(&Queues, entries)) {}
+    ~Ring() { DestroyIoRing(&Queues); }
+
+    Ring(const Ring &) = delete;
+    Ring & operator=(const Ring &) = delete;
+
+    bool IsReady() const { return Ready; }
+
+    //  Next free request, nullptr when submission queue is full
+    PIOREQUEST Request() { return IoRingRequest(&Queues); }
+
+    int Submit() { return SubmitIoRing(&Queues); }
+    int Reap(std::span<IOCOMPLETION> completions) { return ReapIoRing(&Queues, completions.data(), (int)completions.size()); }
+
+private:
+    IORING Queues;
+    bool Ready;
+};
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Class Name :                Operation
+//  Description  :              Awaitable IoTask made by co_read, co_write and
+//                              co_create. The awaiting coroutine is suspended
+//                              until the task is reaped by Executor::Poll(),
+//                              and co_await gives the result of the task.
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+class Operation
+{
+public:
+    Operation(int opcode, int fd, char *data, int size, long long offset, const char *name, int permission)
+        : Work{opcode, fd, data, size, offset, name, permission, 0, nullptr, nullptr, nullptr}
+    {
+    }
+
+    Operation(const Operation &) = delete;
+    Operation & operator=(const Operation &) = delete;
+
+    bool await_ready() const noexcept { return false; }
+
+    bool await_suspend(std::coroutine_handle<> waiter)
+    {
+        Work.Context = waiter.address();
+
+        //  Waiter may run on another thread once task is queued
+        return (SubmitIoTask(&Work) == EXECUTE_SUCCESS);
+    }
+
+    int await_resume() const noexcept { return Work.Result; }
+
+private:
+    IOTASK Work;
+};
+
+inline Operation co_read(int fd, std::span<char> data, long long offset = IO_OFFSET_NONE)
+{
+    return Operation(IO_READ, fd, data.data(), (int)data.size(), offset, nullptr, 0);
+}
+
+inline Operation co_write(int fd, std::span<const char> data, long long offset = IO_OFFSET_NONE)
+{
+    return Operation(IO_WRITE, fd, const_cast<char *>(data.data()), (int)data.size(), offset, nullptr, 0);
+}
+
+inline Operation co_create(const char *name, int permission)
+{
+    return Operation(IO_CREATE, -1, nullptr, 0, IO_OFFSET_NONE, name, permission);
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Class Name :                Task
+//  Description  :              Return type of coroutines which use CVFS. The
+//                              coroutine starts at once and runs until its
+//                              first co_await, and its co_return value is
+//                              kept until the Task is destroyed. A Task may
+//                              be awaited by another coroutine.
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+class Task
+{
+public:
+    struct promise_type
+    {
+        int Result = EXECUTE_SUCCESS;
+        std::coroutine_handle<> Waiter;
+
+        struct Finish
+        {
+            bool await_ready() const noexcept { return false; }
+
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> self) noexcept
+            {
+                std::coroutine_handle<> Waiter = self.promise().Waiter;
+                return (Waiter) ? Waiter : std::noop_coroutine();
+            }
+
+            void await_resume() const noexcept {}
+        };
+
+        Task get_return_object() { return Task(std::coroutine_handle<promise_type>::from_promise(*this)); }
+        std::suspend_never initial_suspend() const noexcept { return {}; }
+        Finish final_suspend() const noexcept { return {}; }
+        void return_value(int value) { Result = value; }
+        void unhandled_exception() { std::terminate(); }
+    };
+
+    Task() : Handle(nullptr) {}
+    Task(Task &&other) : Handle(std::exchange(other.Handle, nullptr)) {}
+
+    Task & operator=(Task &&other)
+    {
+        if(this != &other)
+        {
+            if(Handle)
+            {
+                Handle.destroy();
+            }
+            Handle = std::exchange(other.Handle, nullptr);
+        }
+        return *this;
+    }
+
+    ~Task()
+    {
+        if(Handle)
+        {
+            Handle.destroy();
+        }
+    }
+
+    Task(const Task &) = delete;
+    Task & operator=(const Task &) = delete;
+
+    bool Done() const { return (!Handle) || Handle.done(); }
+    int Result() const { return (Handle) ? Handle.promise().Result : EXECUTE_SUCCESS; }
+
+    //  Moved from Task has no coroutine, awaiting it gives EXECUTE_SUCCESS
+    bool await_ready() const noexcept { return (!Handle) || Handle.done(); }
+    void await_suspend(std::coroutine_handle<> waiter) { Handle.promise().Waiter = waiter; }
+    int await_resume() const noexcept { return Result(); }
+
+private:
+    explicit Task(std::coroutine_handle<promise_type> handle) : Handle(handle) {}
+
+    std::coroutine_handle<promise_type> Handle;
+};
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Class Name :                Executor
+//  Description  :              Owns the worker threads of the process. One
+//                              thread runs the event loop : Poll() resumes
+//                              the coroutines whose operations completed, so
+//                              coroutines only run on the loop thread. Fd()
+//                              is readable when Poll() has work, so the loop
+//                              may also wait for it with its own epoll.
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+class Executor
+{
+public:
+    explicit Executor(int workers = 4) : Ready(StartExecutor(workers)) {}
+
+    ~Executor()
+    {
+        if(Ready == true)
+        {
+            StopExecutor();
+        }
+    }
+
+    Executor(const Executor &) = delete;
+    Executor & operator=(const Executor &) = delete;
+
+    bool IsReady() const { return Ready; }
+    int Pending() const { return PendingIoTasks(); }
+    int Fd() const { return ExecutorPollFd(); }
+
+    //  Resumes completed operations, waits up to timeout ms (-1 forever) for the first
+    int Poll(int timeout = -1)
+    {
+        PIOTASK Done[64];
+        int Count = ReapIoTasks(Done, 64, timeout);
+
+        //  Operations started by resumed coroutines are queued together
+        HoldIoTasks();
+        for(int i = 0; i < Count; i++)
+        {
+            std::coroutine_handle<>::from_address(Done[i]->Context).resume();
+        }
+        FlushIoTasks();
+
+        return Count;
+    }
+
+    //  Runs the loop until no operation is in flight
+    void Run()
+    {
+        while(Pending() > 0)
+        {
+            Poll(-1);
+        }
+    }
+
+private:
+    bool Ready;
+};
+
+}   // End of namespace cvfs
+
+#endif  // LIBCVFS_H
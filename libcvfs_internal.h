@@ -0,0 +1,1101 @@
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  libcvfs : Internal interface of Omkar's CVFS
+//
+//  Structures, globals and functions shared by the library and by the
+//  administration commands of the shell. Programs which only embed the
+//  file system include libcvfs.h.
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+#ifndef LIBCVFS_INTERNAL_H
+#define LIBCVFS_INTERNAL_H
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Header File Inclusion
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+#include<stdio.h>    // For snprintf
+#include<stdlib.h>   // For getenv, atoll
+#include<unistd.h>   // For system level functions
+#include<string.h>   // For strcpy, strcmp, strncpy, memset
+#include<sys/mman.h> // For mmap, munmap, msync used by arena and disk image
+#include<sys/stat.h> // For fstat of disk image
+#include<fcntl.h>    // For open of disk image
+#include<errno.h>    // For errno
+#include<limits.h>   // For INT_MAX of vector reads, LLONG_MAX of file size
+#include<pthread.h>  // For locks of concurrent file API
+#include<time.h>     // For clock_gettime of perf counters
+#include<sys/epoll.h>   // For epoll of executor
+#include<sys/eventfd.h> // For eventfd which signals completed IoTasks
+#if defined(__x86_64__)
+#include<nmmintrin.h>   // For SSE4.2 crc32 used by block fingerprints
+#include<wmmintrin.h>   // For pclmul which folds lanes of crc32
+#endif
+
+#include "libcvfs.h" // Public interface, error codes
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  User Defined Macros
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+#define MAXOPENFILES 64    // Initial size of UFDT of a session, it doubles when full
+#define CACHELINE 64       // Alignment of inode tables
+
+//  Layout of Inode::Block[] (same as UNIX / ext2)
+#define NDIRECT 12         // Direct block pointers
+#define INDIRECT 12        // Single indirect block pointer
+#define DINDIRECT 13       // Double indirect block pointer
+#define TINDIRECT 14       // Triple indirect block pointer
+#define NBLOCKPTR 15       // Total block pointers in inode
+
+#define REGULARFILE 1      // File is valid and created
+#define DIRECTORYFILE 2    // Directory, its entries are inodes whose Parent is it
+
+#define INODE_INLINE 1     // Flag of inode : data is stored in Block[] itself
+#define INODE_COMPRESS 2   // Flag of inode : full clusters of data are compressed
+
+#define ZEROVIEWSIZE 4096  // Bytes of zero buffer lent for holes by BorrowFileAt
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  User Defined Macros For Disk Image
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+#define CVFS_MAGIC 0x53465643u   // "CVFS" in little endian
+#define CVFS_VERSION 6           // Version of on-disk layout
+#define SUPERBLOCKOFFSET 512     // SuperBlock position inside header
+#define SNAPSHOTOFFSET 1024      // Snapshot records position inside header
+#define HEADERSIZE 4096          // BootBlock + SuperBlock + snapshot area
+#define MAXPATHSIZE 256          // Maximum length of image path
+
+#define STATE_CLEAN 1            // Image was unmounted properly
+#define STATE_DIRTY 2            // Image is mounted or was not unmounted
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  User Defined Macros For Journal
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+#define JOURNAL_MAGIC 0x4C4E524Au          // "JRNL" in little endian
+#define JOURNAL_SUFFIX ".journal"          // Journal file is image path + suffix
+#define JOURNAL_GROUP 32                   // Default transactions per fsync
+#define JOURNAL_LIMIT (4 * 1024 * 1024)    // Journal bytes which trigger checkpoint
+#define CRASH_EXIT_CODE 99                 // Exit code of injected crash
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  User Defined Macros For Descriptor Table
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+#define FDWORDBITS 64               // Descriptors tracked by one bitmap word
+#define FDMAXLEVELS 4               // Levels of descriptor bitmap, 64^4 descriptors
+#define FDMAXGROWTH 24              // Times UFDT of a session may double
+#define MAXDESCRIPTORS (1 << 24)    // Largest UFDT of one session
+#define FDRESERVED 3                // Descriptors 0 1 2 are never allocated
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  User Defined Macros For Executor
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+#define WORKERBATCH 32              // Tasks a worker takes from queue at once
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  User Defined Macros For Perf Counters
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+#define MAXPERFTHREADS 128          // Threads with counters of their own, others share one block
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  User Defined Macros For Name Index
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+#define NAMEINDEX_LOAD 2   // Slots per inode, keeps load factor at most 0.5
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  User Defined Macros For Ordered Index
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+#define ORDERMAXLEVEL 16   // Levels of skip list, enough for 4^16 names
+#define ORDERLEVELBITS 2   // Node reaches next level with probability 1 / 2^ORDERLEVELBITS
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  User Defined Macros For Deduplication
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+#define CRC32C_POLY 0x82F63B78u    // Castagnoli polynomial (reflected), as SSE4.2 crc32
+#define CRC32C_MINLANE 64         // Shortest lane of 3 way crc32, shorter buffers are hashed in one lane
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  User Defined Macros For Compression
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+#define CLUSTERBLOCKS 4         // Logical blocks compressed together, power of 2
+#define CLUSTERHEADER 4         // Bytes before compressed stream, hold its length
+#define BLOCK_COMPRESSED 1      // Flag of block record : first block of compressed cluster
+#define DECOMPCACHESIZE 16      // Clusters kept decompressed in memory
+
+//  LZ4 block format
+#define LZ4MINMATCH 4           // Shortest match
+#define LZ4HASHBITS 12          // Entries of match finder table are 2^LZ4HASHBITS
+#define LZ4MAXOFFSET 65535      // Farthest match, offset is 16 bit
+#define LZ4LASTLITERALS 5       // Stream ends with at least these literals
+#define LZ4MFLIMIT 12           // Last match starts at least this far from the end
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  User Defined Macros For Snapshots
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+#define MAXSNAPSHOTS 16         // Snapshot records kept in image header
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  User Defined Macros For Arena (Slab Allocator)
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+#define SLABMINSIZE 16                  // Smallest size class
+#define NSLABCLASS 9                    // Size classes 16, 32, ... 4096
+#define SLABCHUNKSIZE (2 * 1024 * 1024) // Size of one mapping carved into objects
+#define HUGEPAGESIZE (2 * 1024 * 1024)  // Huge page size used with -H option
+#define ARENAHEADER 64                  // Bytes reserved at start of every mapping
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  User Defined Structures
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Structure Name :            BootBlock
+//  Description  :              Holds the information to boot the OS
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+struct BootBlock
+{
+    unsigned int Magic;      // CVFS_MAGIC, identifies a CVFS image
+    unsigned int Version;    // CVFS_VERSION of on-disk layout
+    char Information[100];   // Stores boot message of CVFS
+};
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Structure Name :            InodeCore
+//  Description  :              Holds the frequently scanned fields of File
+//                              These are kept in a separate dense array so
+//                              that scans touch only few bytes per inode
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+struct InodeCore
+{
+    int FileType;              // 0 = free, 1 = regular file, 2 = directory
+    int ReferenceCount;        // How many times file is opened
+    long long ActualFileSize;  // Current used size, number of entries of directory
+};
+
+typedef struct InodeCore INODECORE;
+typedef struct InodeCore* PINODECORE;
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Structure Name :            Inode
+//  Description  :              Holds the information about File
+//                              Inode with number N is stored at DILB[N - 1]
+//                              and its hot fields at DILBCore[N - 1]
+//                              Data of a small file (INODE_INLINE) is kept in
+//                              the bytes of Block[], so it needs no data block
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+struct Inode
+{
+    char FileName[20];     // Name of file
+    int InodeNumber;       // Unique id
+    long long FileSize;    // Bytes of data blocks allocated to file, holes take none
+    int Parent;            // Directory holding the file, ROOTDIRECTORY for root
+    int Permission;        // READ / WRITE / READ+WRITE
+    int Flags;             // INODE_INLINE, INODE_COMPRESS
+    int Block[NBLOCKPTR];  // Data block numbers, 0 means not allocated, or inline data
+};
+
+typedef struct Inode INODE;
+typedef struct Inode* PINODE;
+typedef struct Inode** PPINODE;
+
+static_assert(sizeof(((INODE *)0)->Block) >= INLINEDATASIZE, "Inline data must fit into Block[]");
+static_assert(MINBLOCKSIZE >= INLINEDATASIZE, "Promoted inline data must fit into one block");
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Structure Name :            SuperBlock
+//  Description  :              Holds the information about the File System
+//                              Free inodes and free data blocks are kept on
+//                              stacks so that allocation and release are O(1)
+//                              Offsets locate every area inside the image, so
+//                              the same layout is used in memory and on disk
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+struct SuperBlock
+{
+    int TotalInodes;  // Total files possible
+    int FreeInodes;   // How many are still unused (top of FreeInodeList)
+
+    int BlockSize;      // Bytes in one data block
+    int TotalBlocks;    // Data blocks in the pool
+    int FreeBlocks;     // How many are still unused (top of FreeBlockList)
+
+    int State;                  // STATE_CLEAN or STATE_DIRTY
+    unsigned int IndexCapacity; // Slots in the name index
+    int InlineSize;             // Largest file kept inline, 0 to disable
+    int Dedup;                  // 1 if full blocks are deduplicated when written
+    int Compress;               // 1 if new files are compressed
+    unsigned int DedupCapacity; // Slots in the dedup index
+
+    long long FreeInodeOffset;  // int[TotalInodes], stack of free inode numbers
+    long long FreeBlockOffset;  // int[TotalBlocks], stack of free block numbers
+    long long RecordOffset;     // BLOCKRECORD[TotalBlocks]
+    long long DedupOffset;      // DedupEntry[DedupCapacity]
+    long long IndexOffset;      // NameIndexEntry[IndexCapacity]
+    long long CoreOffset;       // INODECORE[TotalInodes]
+    long long DILBOffset;       // INODE[TotalInodes]
+    long long DataOffset;       // Data blocks, TotalBlocks * BlockSize bytes
+    long long ImageSize;        // Total bytes of image
+};
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Structure Name :            FileTable
+//  Description  :              Holds the information about Opened File
+//                              Entries are system wide : descriptors of many
+//                              sessions may share one entry (and its offsets)
+//                              after dup or fork
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+struct FileTable
+{
+    long long ReadOffset;   // Where next read will start
+    long long WriteOffset;  // Where next write will start
+    int Mode;               // Open mode
+    int Count;              // Descriptors (of any session) which refer this entry
+    PINODE ptrinode;        // Pointer to its inode (Pointer created for Inode)
+};
+
+typedef FileTable FILETABLE;
+typedef FileTable * PFILETABLE;
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Structure Name :            InodeLock
+//  Description  :              Reader/writer lock of one inode. Locks are kept
+//                              in memory only, one cache line each, so that
+//                              threads using different files never share a
+//                              line. Lock order of the file API is :
+//                              NamespaceLock -> InodeLock -> JournalLock ->
+//                              BlockLock -> CacheLock -> ArenaLock
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+struct alignas(CACHELINE) InodeLock
+{
+    pthread_rwlock_t Lock;
+};
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Structure Name :            NameIndex
+//  Description  :              Open addressing hash table which maps file name
+//                              to its inode, so that lookup does not walk DILB
+//                              Slots hold inode numbers, so the index of the
+//                              file system is stored inside the image as well
+//                              Key is (parent directory, name), so the index
+//                              is also the dentry table of every directory :
+//                              one probe resolves one component of a path,
+//                              for names which exist and for those which do not
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+struct NameIndexEntry
+{
+    unsigned int Hash;     // Cached hash of Parent and FileName (avoids strcmp on mismatch)
+    int InodeNumber;       // Inode of file, 0 if slot is empty
+};
+
+struct NameIndex
+{
+    struct NameIndexEntry *Slots;   // Table of slots (Capacity entries)
+    unsigned int Mask;              // Capacity - 1, Capacity is power of 2
+    int Count;                      // Number of used slots
+    PINODE Table;                   // Inode table which InodeNumber refers
+};
+
+typedef struct NameIndex NAMEINDEX;
+typedef struct NameIndex * PNAMEINDEX;
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Structure Name :            OrderIndex
+//  Description  :              Skip list of every named inode sorted by
+//                              (parent directory, name), used by ListFiles()
+//                              for sorted and prefix listings. Names of one
+//                              directory are adjacent, so a listing seeks to
+//                              its first name in O(log n) and then follows
+//                              level 0 only for the names it returns.
+//                              Nodes keep inode numbers and names are read
+//                              from DILB. The list is kept in memory only
+//                              and is built again when an image is mounted.
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+struct OrderNode
+{
+    int InodeNumber;                // Inode of file, its key is in DILB
+    int Levels;                     // Entries in Next
+    struct OrderNode *Next[1];      // Following node of every level (Levels entries)
+};
+
+struct OrderIndex
+{
+    struct OrderNode *Head[ORDERMAXLEVEL];  // First node of every level
+    int Levels;                     // Levels in use
+    int Count;                      // Nodes in list
+    PINODE Table;                   // Inode table which InodeNumber refers
+    unsigned long long Seed;        // Counter which chooses levels of new nodes
+};
+
+typedef struct OrderIndex ORDERINDEX;
+typedef struct OrderIndex * PORDERINDEX;
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Structure Name :            BlockRecord
+//  Description  :              Reference count and fingerprint of one data or
+//                              indirect block. Block N uses BlockRecords[N - 1].
+//                              A block with more than one reference is shared
+//                              and is copied before it is written.
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+struct BlockRecord
+{
+    int Refs;               // Block pointers which refer the block, 0 if free
+    unsigned int Hash;      // Fingerprint while block is in dedup index, 0 otherwise
+    int Flags;              // BLOCK_COMPRESSED
+};
+
+typedef struct BlockRecord BLOCKRECORD;
+typedef struct BlockRecord * PBLOCKRECORD;
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Structure Name :            DedupIndex
+//  Description  :              Open addressing hash table which maps the
+//                              fingerprint (CRC32C) of full data blocks to the
+//                              block, so that a block written with the same
+//                              bytes is stored once. Fingerprints may collide,
+//                              so bytes are compared before a block is shared.
+//                              Slots are stored inside the image.
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+struct DedupEntry
+{
+    unsigned int Hash;      // Fingerprint of block
+    int Block;              // Block number, 0 if slot is empty
+};
+
+struct DedupIndex
+{
+    struct DedupEntry *Slots;   // Table of slots (Capacity entries)
+    unsigned int Mask;          // Capacity - 1, Capacity is power of 2
+};
+
+typedef struct DedupIndex DEDUPINDEX;
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Structure Name :            Snapshot
+//  Description  :              Frozen copy of the file system. Only inode
+//                              metadata is copied : Table is an inode of its
+//                              own whose blocks hold one SnapshotEntry for
+//                              every named inode. Data blocks are shared with
+//                              the live files by raising reference counts of
+//                              their root pointers, so blocks are copied only
+//                              when a live file writes them later. Records
+//                              are stored in image header at SNAPSHOTOFFSET.
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+struct SnapshotEntry
+{
+    INODECORE Core;         // Hot fields, ReferenceCount is always 0
+    INODE Inode;            // Cold fields and block pointers
+};
+
+struct Snapshot
+{
+    char Name[MAXFILENAME]; // Name of snapshot, empty if record is free
+    int Files;              // Entries stored in Table
+    INODE Table;            // Blocks of SnapshotEntry[Files]
+};
+
+typedef struct SnapshotEntry SNAPSHOTENTRY;
+typedef struct SnapshotEntry * PSNAPSHOTENTRY;
+typedef struct Snapshot SNAPSHOT;
+typedef struct Snapshot * PSNAPSHOT;
+
+static_assert(SUPERBLOCKOFFSET + sizeof(struct SuperBlock) <= SNAPSHOTOFFSET, "SuperBlock must end before snapshots");
+static_assert(SNAPSHOTOFFSET + (MAXSNAPSHOTS * sizeof(SNAPSHOT)) <= HEADERSIZE, "Snapshots must fit into header");
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Structure Name :            DecompCache
+//  Description  :              Small cache of decompressed clusters, keyed by
+//                              the first block of the compressed cluster.
+//                              Entries are replaced in clock order; an entry
+//                              lent by BorrowFileAt is pinned until the view
+//                              is returned. Kept in memory only.
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+struct CacheEntry
+{
+    int Block;              // First block of cluster, 0 if entry is empty
+    int Pins;               // Views lent from the entry
+    bool Used;              // Read since clock hand passed it
+    char *Data;             // Decompressed cluster
+};
+
+struct DecompCache
+{
+    struct CacheEntry Entries[DECOMPCACHESIZE];
+    char *Memory;           // Data of all entries, then Spare and Scratch
+    char *Spare;            // Decompressed cluster when every entry is pinned
+    char *Scratch;          // Compressed stream gathered from its blocks
+    int ClusterSize;        // Bytes of one cluster, 0 if not allocated
+    int Hand;               // Next entry considered for replacement
+};
+
+typedef struct DecompCache DECOMPCACHE;
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Structure Name :            CompressStats
+//  Description  :              Work done by compression since start, so that
+//                              its CPU cost can be weighed against the blocks
+//                              it saves. Kept in memory only.
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+struct CompressStats
+{
+    long long Compressed;       // Clusters stored compressed
+    long long Incompressible;   // Clusters which did not shrink by a block
+    long long BytesIn;          // Bytes given to compressor
+    long long BytesOut;         // Bytes produced by compressor
+    long long CompressNs;       // Time spent compressing
+    long long Expanded;         // Compressed clusters rewritten raw by a write
+    long long DecompressBytes;  // Bytes produced by decompressor
+    long long DecompressNs;     // Time spent decompressing
+    long long CacheHits;        // Reads served by decompressed cache
+    long long CacheMisses;      // Reads which decompressed a cluster
+};
+
+typedef struct CompressStats COMPRESSSTATS;
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Structure Name :            Arena
+//  Description  :              Owns all memory used by CVFS. Small objects are
+//                              served from per size class free lists carved
+//                              out of big mappings, large objects get their
+//                              own mapping. Every mapping is on one list so
+//                              that the whole arena is released at once.
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+struct ArenaChunk
+{
+    struct ArenaChunk *next;    // Next mapping of arena
+    struct ArenaChunk *prev;    // Previous mapping of arena
+    size_t Size;                // Bytes mapped including ARENAHEADER
+};
+
+struct SlabClass
+{
+    size_t Size;                // Object size of this class
+    void *FreeList;             // Released objects, linked through first word
+    long long Live;             // Objects handed out and not released
+};
+
+struct Arena
+{
+    struct SlabClass Classes[NSLABCLASS];
+    struct ArenaChunk *Chunks;  // All mappings (slab chunks and large objects)
+    char *Current;              // Slab chunk being carved
+    size_t CurrentUsed;         // Bytes carved from Current
+    size_t CurrentSize;         // Usable bytes of Current
+    bool HugePages;             // Try MAP_HUGETLB for mappings
+
+    long long LiveBytes;        // Bytes handed out and not released
+    long long PeakBytes;        // Highest value of LiveBytes
+    long long MappedBytes;      // Bytes taken from the operating system
+    long long Allocations;      // Number of CvfsAlloc calls
+    long long Releases;         // Number of CvfsFree calls
+};
+
+typedef struct Arena ARENA;
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Structure Name :            Journal
+//  Description  :              Redo journal of a mounted image. Every metadata
+//                              update of an operation is recorded as a byte
+//                              range of the image. When the operation ends the
+//                              ranges are copied into a transaction, and groups
+//                              of transactions are written with one fsync.
+//                              The image file itself is only written during
+//                              checkpoint, after the journal is durable.
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+struct JournalRange
+{
+    long long Offset;           // Offset of range inside image
+    long long Length;           // Bytes in range
+};
+
+struct JournalHeader
+{
+    unsigned int Magic;         // JOURNAL_MAGIC
+    unsigned int Records;       // Number of ranges in transaction
+    long long Sequence;         // Transaction number
+    long long Bytes;            // Bytes of records following the header
+    unsigned long long Checksum;// FNV-1a of records, detects torn writes
+};
+
+struct Journal
+{
+    int Fd;                             // Journal host file, -1 when not mounted
+    char Path[MAXPATHSIZE + 16];        // Host path of journal
+
+    struct JournalRange *Ranges;        // Metadata ranges of running operation
+    int RangeCount;
+    int RangeCapacity;
+    bool Lost;                          // A range of running operation was not recorded
+
+    struct JournalRange *DataRanges;    // Data ranges of group (ordered mode)
+    int DataCount;
+    int DataCapacity;
+    int StableFree;                     // Free list entries free at last flush
+
+    char *Buffer;                       // Committed transactions not yet written
+    long long BufferUsed;
+    long long BufferCapacity;
+
+    unsigned char *DirtyPages;          // Pages of image changed since checkpoint
+    long long PageCount;
+
+    int GroupSize;                      // Transactions per fsync
+    int Pending;                        // Transactions in Buffer
+    bool DataJournal;                   // true to journal file data as well
+    long long Sequence;                 // Number of next transaction
+    long long FileSize;                 // Bytes in journal host file
+
+    long long Commits;                  // Transactions committed
+    long long Flushes;                  // Group writes (fsync of journal)
+    long long Checkpoints;              // Checkpoints done
+    long long Replayed;                 // Transactions replayed at mount
+};
+
+typedef struct Journal JOURNAL;
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Structure Name :            UAREA
+//  Description  :              Holds the information about Process
+//                              UFDT starts with MAXOPENFILES entries and
+//                              doubles when full. Free descriptors are found
+//                              with a bitmap of FDMAXLEVELS levels : bit of
+//                              level 0 is set when descriptor is in use, bit
+//                              of level N is set when word of level N - 1 is
+//                              full, so lowest free descriptor is found with
+//                              one ctz per level.
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+struct UAREA
+{
+    char ProcessName[20];               // Name of running process
+    int SessionId;                      // Number of session, 1 is the shell
+    PFILETABLE *UFDT;                   // Array of open files, Capacity entries
+    int Capacity;                       // Entries in UFDT (multiple of FDWORDBITS)
+    int OpenCount;                      // Descriptors in use
+    int Cwd;                            // Working directory, holds a reference of it
+
+    pthread_mutex_t FdLock;             // Allocation and release of descriptors
+    unsigned long long *FdBits;         // All levels of bitmap in one array
+    unsigned long long *FdLevel[FDMAXLEVELS];   // Start of every level in FdBits
+    int FdWords[FDMAXLEVELS];           // Words in every level
+    int FdDepth;                        // Levels in use, top level has one word
+    int FdBitsWords;                    // Words in FdBits
+
+    PFILETABLE *Retired[FDMAXGROWTH];   // Old UFDT arrays, lock free readers may
+    int RetiredCount;                   // still use them until session ends
+};
+
+typedef struct UAREA * PUAREA;
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Structure Name :            SessionTable
+//  Description  :              Holds every UAREA (session) of the system.
+//                              Session N is stored at Sessions[N - 1], the
+//                              array doubles when it is full.
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+struct SessionTable
+{
+    PUAREA *Sessions;       // Sessions by number, NULL for free numbers
+    int Capacity;           // Entries in Sessions
+    int Count;              // Sessions alive
+};
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Structure Name :            WorkerPool
+//  Description  :              Executor of IoTasks. Submitted tasks wait on a
+//                              FIFO queue for a worker thread, completed ones
+//                              on the Done list until they are reaped. Only
+//                              a push to an empty Done list writes EventFd,
+//                              so a burst of completions wakes the loop once.
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+struct WorkerPool
+{
+    pthread_t Workers[MAXWORKERS];  // Threads running IoWorker()
+    int Count;                      // Threads started, 0 if executor is stopped
+    bool Stopping;                  // Workers exit when queue is empty
+
+    pthread_mutex_t QueueLock;      // Queue and Stopping
+    pthread_cond_t QueueReady;      // Signalled when a task is queued
+    PIOTASK Head;                   // Oldest queued task
+    PIOTASK Tail;                   // Newest queued task
+
+    pthread_mutex_t DoneLock;       // Done list
+    PIOTASK Done;                   // Completed tasks, newest first
+    PIOTASK Ready;                  // Completed tasks taken by reaper, oldest first
+
+    int EventFd;                    // Counter written when Done becomes non empty
+    int PollFd;                     // epoll instance watching EventFd
+    int InFlight;                   // Tasks submitted and not yet reaped
+};
+
+typedef struct WorkerPool WORKERPOOL;
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Structure Name :            HeldTasks
+//  Description  :              Tasks submitted by a thread between
+//                              HoldIoTasks() and FlushIoTasks(). They are
+//                              queued together, one list per thread.
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+struct HeldTasks
+{
+    PIOTASK Head;       // First task collected
+    PIOTASK Tail;       // Last task collected
+    int Count;          // Tasks collected
+    bool Holding;       // SubmitIoTask() collects instead of queueing
+};
+
+typedef struct HeldTasks HELDTASKS;
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Structure Name :            PerfBlock
+//  Description  :              Perf counters of one thread. Only the owner
+//                              writes them, so no atomic add is needed. A
+//                              block is kept when its thread exits and is
+//                              given to the next new thread, so counts are
+//                              never lost. Threads beyond MAXPERFTHREADS share
+//                              the last block with atomic adds.
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+struct alignas(CACHELINE) PerfBlock
+{
+    struct PerfStat Stats[NPERFOPS];    // Counters by PERF_ operation
+    bool Used;                          // Owned by a running thread
+};
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Global variables or objects used in the Project (defined in libcvfs.cpp)
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+extern BootBlock bootobj;
+extern SuperBlock superobj;
+extern UAREA uareaobj;
+extern SessionTable sessionobj;
+extern NAMEINDEX indexobj;
+extern ORDERINDEX orderobj;
+extern DEDUPINDEX dedupobj;
+extern DECOMPCACHE cacheobj;
+extern COMPRESSSTATS compressobj;
+extern ARENA arenaobj;
+extern JOURNAL journalobj;
+extern WORKERPOOL poolobj;
+
+extern PINODE DILB;                     // Cold part of inode table (names, buffers)
+extern PINODECORE DILBCore;             // Hot part of inode table (type, size, refcount)
+
+extern int *FreeInodeList;              // Stack of free inode numbers
+extern int *FreeBlockList;              // Stack of free block numbers
+extern PBLOCKRECORD BlockRecords;       // Reference count of every block
+extern PSNAPSHOT Snapshots;             // MAXSNAPSHOTS records inside image header
+extern char *BlockPool;                 // Data blocks, block N starts at (N - 1) * BlockSize
+extern int BlockShift;                  // log2 of BlockSize
+
+extern char *ImageBase;                 // Start of image (arena memory or mapped file)
+extern int ImageFd;                     // Host file of mounted image, -1 if in memory only
+extern char ImagePath[MAXPATHSIZE];     // Host path of mounted image
+
+extern long long CrashCountdown;        // Crash points left before injected crash
+
+extern struct InodeLock *InodeLocks;    // One lock per inode of DILB
+extern pthread_mutex_t NamespaceLock;   // Name index, ordered index, inode allocation
+extern pthread_mutex_t JournalLock;     // Running transaction
+extern pthread_mutex_t BlockLock;       // Free block list, block records, dedup index
+extern pthread_mutex_t CacheLock;       // Decompressed cluster cache
+extern pthread_mutex_t ArenaLock;       // Slab classes of arena
+extern thread_local bool JournalHeld;   // Calling thread owns JournalLock
+
+extern pthread_mutex_t SessionLock;     // Session table
+extern thread_local PUAREA CurrentUArea;// Session of calling thread
+extern thread_local HELDTASKS HeldTasks;// Tasks collected by HoldIoTasks()
+
+#ifndef CVFS_NO_PERF
+extern struct PerfBlock PerfBlocks[MAXPERFTHREADS + 1];  // Last block is shared
+extern int PerfBlockCount;              // Blocks given to threads so far
+extern pthread_mutex_t PerfLock;        // Used flags and PerfBlockCount
+extern thread_local struct PerfBlock *PerfLocal;    // Block of calling thread
+extern thread_local unsigned int PerfTick;          // Calls of calling thread, selects timed calls
+#endif
+extern long long OpenFileTables;        // File table entries alive in the system
+extern const char ZeroData[ZEROVIEWSIZE];   // Lent for blocks which were never written
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :     CoreOf
+//  Description :       Returns the hot fields of given inode. Position of
+//                      inode in DILB is used, so cold record is not touched.
+//  Input :             ptrinode -> Inode from DILB
+//  Output :            Address of its entry in DILBCore
+//  Author :            Omkar Sachin Naralwar
+//  Date :              16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+inline PINODECORE CoreOf(
+                            PINODE ptrinode
+                        )
+{
+    return &DILBCore[ptrinode - DILB];
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :     LockOf
+//  Description :       Returns the reader/writer lock of given inode.
+//  Input :             ptrinode -> Inode from DILB
+//  Output :            Address of its lock
+//  Author :            Omkar Sachin Naralwar
+//  Date :              16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+inline pthread_rwlock_t * LockOf(
+                                    PINODE ptrinode
+                                )
+{
+    return &InodeLocks[ptrinode - DILB].Lock;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         AlignUp
+//  Description :           Rounds value up to the next multiple of align.
+//  Input :                 value -> Value to be rounded
+//                          align -> Power of 2 alignment
+//  Output :                Rounded value
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+inline long long AlignUp(
+                            long long value,
+                            long long align
+                        )
+{
+    return (value + align - 1) & ~(align - 1);
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         RecordOf
+//  Description :           Returns the reference count and fingerprint of
+//                          given block.
+//  Input :                 block -> Block number (1 based)
+//  Output :                Address of its entry in BlockRecords
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+inline PBLOCKRECORD RecordOf(
+                                int block
+                            )
+{
+    return &BlockRecords[block - 1];
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         BlockData
+//  Description :           Returns the address of data of given block.
+//  Input :                 block -> Block number (1 based)
+//  Output :                Address of first byte of block in the pool
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+inline char * BlockData(
+                            int block
+                        )
+{
+    return BlockPool + ((size_t)(block - 1) * superobj.BlockSize);
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Function Name :         PerfClock
+//  Description :           Returns monotonic time used by perf counters
+//                          and compression statistics.
+//  Output :                Current time in ns
+//  Author :                Omkar Sachin Naralwar
+//  Date :                  16/10/2026
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+inline long long PerfClock()
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (ts.tv_sec * 1000000000LL) + ts.tv_nsec;
+}
+
+#ifndef CVFS_NO_PERF
+
+void PerfRecord(int op, long long ns);
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Structure Name :            PerfScope
+//  Description  :              Counts the call of function it is declared in
+//                              when the function returns, on any return path.
+//                              Every PERFSAMPLE th call of a thread is timed,
+//                              as reading the clock costs as much as a lookup.
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+struct PerfScope
+{
+    int Op;
+    long long Start;
+
+    explicit PerfScope(int op) : Op(op), Start(((++PerfTick & (PERFSAMPLE - 1)) == 0) ? PerfClock() : 0) {}
+
+    ~PerfScope()
+    {
+        struct PerfBlock *Block = PerfLocal;
+
+        //  Untimed call of a thread with its own block only needs a count
+        if((Start == 0) && (Block != NULL) && (Block != &PerfBlocks[MAXPERFTHREADS]))
+        {
+            __atomic_store_n(&Block->Stats[Op].Count, Block->Stats[Op].Count + 1, __ATOMIC_RELAXED);
+        }
+        else
+        {
+            PerfRecord(Op, (Start == 0) ? -1 : PerfClock() - Start);
+        }
+    }
+};
+
+#define PERF_SCOPE(op) PerfScope PerfTimer(op)
+
+#else
+
+#define PERF_SCOPE(op)
+
+#endif  // CVFS_NO_PERF
+
+//////////////////////////////////////////////////////////////////////////////////
+//
+//  Internal Functions (defined in libcvfs.cpp)
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+void InitialiseArena(bool hugepages);
+void * ArenaMap(size_t size);
+void ArenaUnmap(void *ptr);
+int SlabClassOf(size_t size);
+void * SlabAlloc(size_t size);
+void SlabFree(void *ptr, size_t size);
+void * CvfsAlloc(size_t size);
+void CvfsFree(void *ptr, size_t size);
+void DestroyArena();
+void CrashPoint();
+bool JournalGrow(void **array, long long *capacity, long long used, long long required);
+bool JournalAddRange(struct JournalRange **list, int *count, int *capacity, long long offset, long long length);
+void JournalMarkPages(JOURNAL *journal, long long offset, long long length);
+void JournalDirty(const void *ptr, long long length);
+void JournalData(const void *ptr, long long length);
+unsigned long long JournalChecksum(const char *data, long long length);
+int JournalFlush();
+int JournalSeal();
+void JournalBegin();
+void JournalEnd();
+int JournalCommit();
+int JournalCheckpoint();
+int JournalOpen(JOURNAL *journal, const char *path, long long imagesize, bool fresh);
+void JournalRelease(JOURNAL *journal);
+long long JournalReplay(JOURNAL *journal, char *base, long long imagesize);
+unsigned int HashFileName(int parent, const char *name);
+unsigned int NameIndexCapacity(int count);
+bool NameIndexCreate(PNAMEINDEX index, int count, PINODE table);
+void NameIndexDestroy(PNAMEINDEX index);
+PINODE NameIndexLookup(PNAMEINDEX index, int parent, const char *name);
+void NameIndexInsert(PNAMEINDEX index, PINODE ptrinode);
+bool NameIndexRemove(PNAMEINDEX index, int parent, const char *name);
+struct OrderNode * OrderNodeCreate(PORDERINDEX index);
+void OrderNodeFree(struct OrderNode *node);
+int OrderCompare(PINODE ptrinode, int parent, const char *name);
+struct OrderNode * OrderIndexSeek(PORDERINDEX index, int parent, const char *name, bool after, struct OrderNode **path);
+void OrderIndexInsert(PORDERINDEX index, struct OrderNode *node, PINODE ptrinode);
+bool OrderIndexRemove(PORDERINDEX index, int parent, const char *name);
+bool OrderIndexBuild(PORDERINDEX index, PINODECORE core, int count);
+void OrderIndexDestroy(PORDERINDEX index);
+int WalkPath(const char *path, int *number, char *leaf);
+void AddDirectoryEntry(int directory, int change);
+void HoldDirectory(int directory);
+void ReleaseDirectory(int directory);
+bool BuildDescriptorMap(PUAREA uarea, PFILETABLE *table, int capacity);
+int FindFreeDescriptor(PUAREA uarea);
+void MarkDescriptor(PUAREA uarea, int fd, bool used);
+int GrowDescriptors(PUAREA uarea);
+bool InitialiseDescriptors(PUAREA uarea);
+void DestroyDescriptors(PUAREA uarea);
+bool InitialiseUAREA();
+void LayoutImage(struct SuperBlock *super);
+void InitialiseSuperBlock(int count, int blocksize, int blockcount);
+void AttachImage(char *base);
+struct InodeLock * CreateInodeLocks(int count);
+void DestroyInodeLocks(struct InodeLock *Locks, int count);
+bool CreateImage();
+PINODE AllocateInode();
+void ReleaseInode(PINODE ptrinode);
+void CreateDILB();
+int AllocateBlock();
+void ReleaseBlock(int block);
+bool DropBlock(int block);
+void ReleaseBlockTree(int block, int level);
+unsigned int Crc32cSoftware(const char *data, size_t length);
+unsigned int Crc32cMultiply(unsigned int a, unsigned int b);
+unsigned int Crc32cPower(unsigned long long bits);
+unsigned int Crc32cHardware(const char *data, size_t length);
+unsigned int FingerprintBlock(const char *data);
+int DedupLookup(unsigned int hash, const char *data);
+void DedupInsert(int block, unsigned int hash);
+void DedupRemove(int block);
+void DedupBlock(int *slot);
+int WritableBlock(int *slot, int level);
+long long MaxFileSize();
+int MapBlock(PINODE ptrinode, long long logical, bool allocate, int **slot);
+int Lz4Compress(const char *src, int length, char *dst, int capacity);
+int Lz4Decompress(const char *src, int length, char *dst, int capacity);
+void DestroyDecompCache();
+void CacheInvalidate(int block);
+char * LookupCluster(PINODE ptrinode, long long first, int head, bool pin);
+int ClusterHead(PINODE ptrinode, long long logical, long long *first);
+void PunchBlock(PINODE ptrinode, long long logical);
+void CompressCluster(PINODE ptrinode, long long first);
+int ExpandCluster(PINODE ptrinode, long long first, int head);
+void ReleaseFileBlocks(PINODE ptrinode);
+void HoldFileBlocks(PINODE ptrinode);
+PSNAPSHOT FindSnapshot(const char *name);
+int SnapshotCopy(PINODE table, long long offset, char *data, int size, bool store);
+bool SnapshotSearch(PSNAPSHOT snapshot, int parent, const char *name, PSNAPSHOTENTRY entry);
+int PromoteInlineData(PINODE ptrinode);
+void CreateBlockPool();
+void ReleaseInodeData(PINODE ptrinode);
+void ReleaseFileTable(PFILETABLE ptrfile);
+bool ReleaseDescriptor(PUAREA uarea, int fd);
+void CloseAllFiles();
+void WriteImageHeader();
+int SaveImage(const char *path);
+PFILETABLE FileTableOf(int fd);
+int AllocateDescriptor(PFILETABLE ptrfile);
+int WriteData(PINODE ptrinode, const char *data, int size, long long offset);
+void ReadData(PINODE ptrinode, char *data, int size, long long offset);
+int ReadableBytes(PINODE ptrinode, long long offset, int size);
+long long ReserveReadOffset(PFILETABLE ptrfile, int *size);
+int RunIoRequest(PFILETABLE ptrfile, PIOREQUEST Request);
+void ReleaseExecutor();
+void QueueIoTasks(PIOTASK first, PIOTASK last, int count);
+void RunIoTask(PIOTASK task);
+void * IoWorker(void *arg);
+void TakeCompletions();
+struct PerfBlock * PerfAttach();
+void PerfDetach(void *block);
+void PerfKeyCreate();
+
+//  Consistency check of cvfscheck.cpp, shared by the shell and cvfstest
+int CheckBlockTree(int *Refs, int block, int level, int *DataBlocks);
+int CheckInodeBlocks(int *Refs, PINODE ptrinode, int *DataBlocks);
+int CheckFileSystem();
+
+#endif  // LIBCVFS_INTERNAL_H